@@ -0,0 +1,584 @@
+// CPUBenchmark.cpp
+// cpu_bench：渲染器CPU端热点（场景读写、AABB生成、Halton序列、SSAO采样核）的微基准，不创建GL上下文
+//
+//   cpu_bench [--filter <text>] [--max-size <N>] [--output <file>] [--baseline <file>] [--threshold <percent>]
+//             [--min-samples <n>] [--max-samples <n>] [--sample-ms <ms>] [--budget-ms <ms>] [--list]
+//   cpu_bench --convergence
+//   cpu_bench --help
+//
+// 每个用例先校准每个样本的重复次数（使单个样本不短于--sample-ms），再采集样本直到达到--max-samples
+// 或用完--budget-ms（至少--min-samples个）；报告中值、MAD、最小值、均值和p95（每次运行的纳秒数）以及吞吐量。
+// 与基线比较时，中值变慢超过阈值百分比且超过3倍MAD（两份报告中较大者）的用例记为回归，退出码1。
+// --convergence不计时，只运行光追弹射采样器的RMSE-vs-spp对比（见下方“采样器收敛”）
+#include "SceneIO.h"
+#include "Sampling.h"
+#include "Json.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+// 运行一次被测代码，返回校验值（累加到g_Sink，防止被优化掉）
+using Runner = std::function<double()>;
+
+struct BenchGroup {
+    std::string name;
+    std::vector<int> sizes;
+    const char* unit;                           // 吞吐量的单位
+    std::function<Runner(int)> make;            // 为给定规模准备数据，返回的Runner持有数据
+};
+
+struct Options {
+    std::string filter;
+    std::string outputPath = "cpu_bench_result.json";
+    std::string baselinePath;
+    int maxSize = 1000000;
+    int minSamples = 5, maxSamples = 30;
+    double sampleMs = 10.0;
+    double budgetMs = 2000.0;
+    float thresholdPercent = 10.0f;
+    bool list = false;
+    bool convergence = false;
+    bool help = false;
+};
+
+struct CaseResult {
+    std::string key;                            // name/size
+    int size = 0;
+    const char* unit = "";
+    long long iterations = 0;                   // 每个样本的重复次数
+    int samples = 0;
+    double medianNs = 0.0, madNs = 0.0, minNs = 0.0, meanNs = 0.0, p95Ns = 0.0;
+    double itemsPerSecond = 0.0;
+    int outliers = 0;                           // 偏离中值超过3倍MAD的样本数
+};
+
+static volatile double g_Sink = 0.0;
+
+// ---------------------------------------------------------------------------
+// 测试数据
+
+static std::vector<UIObject> MakeObjects(int count) {
+    // 固定种子：同一规模总是同一份场景；约80%球体、20%平面（含斜置平面）
+    std::mt19937 rng(12345);
+    std::uniform_real_distribution<float> pos(-50.0f, 50.0f), unit(0.0f, 1.0f);
+    std::vector<UIObject> objects(count);
+    for (int i = 0; i < count; ++i) {
+        UIObject& ui = objects[i];
+        std::snprintf(ui.name, sizeof(ui.name), "Object_%d", i);
+        Object& obj = ui.obj;
+        obj.position = glm::vec3(pos(rng), pos(rng), pos(rng));
+        if (unit(rng) < 0.8f) {
+            obj.type = ObjectType::SPHERE;
+            obj.radius = 0.1f + unit(rng) * 2.0f;
+        }
+        else {
+            obj.type = ObjectType::PLANE;
+            obj.normal = glm::normalize(glm::vec3(unit(rng) - 0.5f, unit(rng) + 0.1f, unit(rng) - 0.5f));
+            obj.size = glm::vec2(1.0f + unit(rng) * 20.0f, 1.0f + unit(rng) * 20.0f);
+        }
+        obj.material.type = static_cast<MaterialType>(i % 3);
+        obj.material.albedo = glm::vec3(unit(rng), unit(rng), unit(rng));
+        obj.material.roughness = unit(rng);
+        obj.material.ior = 1.0f + unit(rng);
+    }
+    return objects;
+}
+
+static std::vector<UILight> MakeLights() {
+    std::vector<UILight> lights(8);
+    for (int i = 0; i < 8; ++i) {
+        std::snprintf(lights[i].name, sizeof(lights[i].name), "Light_%d", i);
+        lights[i].light.type = static_cast<LightType>(i % 3);
+        lights[i].light.position = glm::vec3(i * 2.0f, 10.0f, -i * 1.5f);
+    }
+    return lights;
+}
+
+static std::vector<int> Decades(int from, int to) {
+    std::vector<int> sizes;
+    for (long long n = from; n <= to; n *= 10) sizes.push_back(static_cast<int>(n));
+    return sizes;
+}
+
+static std::vector<BenchGroup> MakeGroups(const Options& options) {
+    const std::string scenePath = (fs::temp_directory_path() / "cpu_bench.scene").string();
+    std::vector<BenchGroup> groups;
+
+    groups.push_back({ "SceneIO::Save", Decades(100, options.maxSize), "objects", [scenePath](int size) -> Runner {
+        auto objects = std::make_shared<std::vector<UIObject>>(MakeObjects(size));
+        auto lights = std::make_shared<std::vector<UILight>>(MakeLights());
+        return [=]() {
+            return SceneIO::Save(scenePath, *objects, *lights) ? 1.0 : 0.0;
+        };
+    } });
+
+    groups.push_back({ "SceneIO::Load", Decades(100, options.maxSize), "objects", [scenePath](int size) -> Runner {
+        // 先写出场景文件；读入的容器在运行之间复用容量，只测解析
+        SceneIO::Save(scenePath, MakeObjects(size), MakeLights());
+        auto objects = std::make_shared<std::vector<UIObject>>();
+        auto lights = std::make_shared<std::vector<UILight>>();
+        objects->reserve(size);
+        return [=]() {
+            objects->clear();
+            lights->clear();
+            SceneIO::Load(scenePath, *objects, *lights);
+            return static_cast<double>(objects->size());
+        };
+    } });
+
+    groups.push_back({ "GenerateAABBForObject", Decades(100, options.maxSize), "objects", [](int size) -> Runner {
+        auto objects = std::make_shared<std::vector<UIObject>>(MakeObjects(size));
+        return [=]() {
+            double sum = 0.0;
+            for (UIObject& ui : *objects) {
+                GenerateAABBForObject(ui.obj);
+                sum += ui.obj.bounds.max.x - ui.obj.bounds.min.x;
+            }
+            return sum;
+        };
+    } });
+
+    groups.push_back({ "haltonSequence", Decades(100, options.maxSize), "points", [](int size) -> Runner {
+        // 与TAA抖动相同：底数2和3各一次
+        return [size]() {
+            double sum = 0.0;
+            for (int i = 1; i <= size; ++i) sum += haltonSequence(i, 2) + haltonSequence(i, 3);
+            return sum;
+        };
+    } });
+
+    // 规模为采样数，上限与AOManager::MAX_KERNEL_SIZE一致
+    groups.push_back({ "GenerateSSAOKernel", { 4, 16, 64 }, "samples", [](int size) -> Runner {
+        return [size]() {
+            const std::vector<glm::vec4> kernel = GenerateSSAOKernel(size);
+            return static_cast<double>(kernel.back().z);
+        };
+    } });
+
+    return groups;
+}
+
+// ---------------------------------------------------------------------------
+// 采样器收敛（--convergence）
+//
+// raytracingCs.glsl中pathSample（打乱 + Owen扰乱的Sobol）与原来hammersley(depth * 64 + frameCount, 64)的CPU移植，
+// 分别用于估计天空 + 太阳环境下的余弦加权辐照度：每个随机法线相当于一个像素，spp即累积的帧数，
+// 与解析/高密度分层的参考值比较RMSE
+
+static const glm::vec3 kSunDirection = glm::normalize(glm::vec3(0.4f, 0.8f, 0.3f));
+static constexpr float kSunCosAngle = 0.95f;    // 太阳圆盘半角约18度
+static constexpr float kSunRadiance = 10.0f;
+
+static float SkyRadiance(const glm::vec3& dir) {
+    return dir.y > 0.0f ? 0.4f + 0.6f * dir.y : 0.1f;
+}
+
+static float EnvironmentRadiance(const glm::vec3& dir) {
+    return SkyRadiance(dir) + (glm::dot(dir, kSunDirection) > kSunCosAngle ? kSunRadiance : 0.0f);
+}
+
+// 以下与raytracingCs.glsl逐行对应
+static glm::vec3 CosineWeightedHemisphere(glm::vec2 rand, glm::vec3 normal) {
+    const float phi = 2.0f * 3.14159265f * rand.x;
+    const float cosTheta = std::sqrt(rand.y);
+    const float sinTheta = std::sqrt(1.0f - rand.y);
+    const glm::vec3 hemisphereDir(sinTheta * std::cos(phi), cosTheta, sinTheta * std::sin(phi));
+    const glm::vec3 tangent = glm::normalize(glm::cross(normal, glm::vec3(0, 1, 1)));
+    const glm::vec3 bitangent = glm::cross(normal, tangent);
+    return glm::normalize(tangent * hemisphereDir.x + bitangent * hemisphereDir.z + normal * hemisphereDir.y);
+}
+
+static glm::vec2 Hammersley(int i, int n) {
+    return glm::vec2(float(i) / float(n), haltonSequence(i, 2));
+}
+
+static uint32_t PcgHash(uint32_t v) {
+    const uint32_t state = v * 747796405u + 2891336453u;
+    const uint32_t word = ((state >> ((state >> 28u) + 4u)) ^ state) * 277803737u;
+    return (word >> 22u) ^ word;
+}
+
+static uint32_t HashCombine(uint32_t seed, uint32_t v) {
+    return seed ^ (PcgHash(v) + (seed << 6) + (seed >> 2));
+}
+
+static uint32_t ReverseBits(uint32_t x) {
+    x = ((x >> 1) & 0x55555555u) | ((x & 0x55555555u) << 1);
+    x = ((x >> 2) & 0x33333333u) | ((x & 0x33333333u) << 2);
+    x = ((x >> 4) & 0x0f0f0f0fu) | ((x & 0x0f0f0f0fu) << 4);
+    x = ((x >> 8) & 0x00ff00ffu) | ((x & 0x00ff00ffu) << 8);
+    return (x >> 16) | (x << 16);
+}
+
+static uint32_t NestedUniformScramble(uint32_t x, uint32_t seed) {
+    x = ReverseBits(x);
+    x += seed;
+    x ^= x * 0x6c50b47cu;
+    x ^= x * 0xb82f1e52u;
+    x ^= x * 0xc7afe638u;
+    x ^= x * 0x8d22f6e6u;
+    return ReverseBits(x);
+}
+
+static glm::vec2 PathSample(const std::vector<uint32_t>& matrices, glm::ivec2 pixel, int depth, uint32_t stream, int frameCount) {
+    const uint32_t pixelSeed = PcgHash(uint32_t(pixel.x) ^ PcgHash(uint32_t(pixel.y)));
+    const uint32_t seed = HashCombine(HashCombine(pixelSeed, uint32_t(depth)), stream);
+    const uint32_t index = NestedUniformScramble(uint32_t(frameCount), seed);
+    glm::vec2 u;
+    for (uint32_t d = 0; d < 2; ++d) {
+        uint32_t x = 0;
+        for (uint32_t bit = 0, i = index; i != 0; i >>= 1, ++bit) {
+            if (i & 1u) x ^= matrices[d * SOBOL_BITS + bit];
+        }
+        u[d] = float(NestedUniformScramble(x, HashCombine(seed, d)) >> 8) * (1.0f / 16777216.0f);
+    }
+    return u;
+}
+
+// 参考值：太阳按解析解（圆盘完全在半球内时为 radiance * dot(n, s) * sin^2(半角)），天空用256x256分层采样
+static float ReferenceIrradiance(const glm::vec3& normal) {
+    constexpr int GRID = 256;
+    double sky = 0.0;
+    for (int y = 0; y < GRID; ++y) {
+        for (int x = 0; x < GRID; ++x) {
+            sky += SkyRadiance(CosineWeightedHemisphere(glm::vec2((x + 0.5f) / GRID, (y + 0.5f) / GRID), normal));
+        }
+    }
+    const float sun = kSunRadiance * std::max(glm::dot(normal, kSunDirection), 0.0f) * (1.0f - kSunCosAngle * kSunCosAngle);
+    return static_cast<float>(sky / (GRID * GRID)) + sun;
+}
+
+static int RunConvergence() {
+    constexpr int NORMALS = 300, MAX_SPP = 256, DEPTH = 0;
+    const std::vector<uint32_t> matrices = GenerateSobolMatrices(2);
+
+    // 固定种子的随机法线，跳过太阳圆盘与地平线相交的方向（参考值的解析解不成立）
+    const float sunSin = std::sqrt(1.0f - kSunCosAngle * kSunCosAngle);
+    std::mt19937 rng(2024);
+    std::normal_distribution<float> gaussian;
+    std::vector<glm::vec3> normals;
+    while (static_cast<int>(normals.size()) < NORMALS) {
+        const glm::vec3 n = glm::normalize(glm::vec3(gaussian(rng), gaussian(rng), gaussian(rng)));
+        if (std::abs(glm::dot(n, kSunDirection)) > sunSin + 0.01f) normals.push_back(n);
+    }
+    std::vector<float> reference(NORMALS);
+    for (int i = 0; i < NORMALS; ++i) reference[i] = ReferenceIrradiance(normals[i]);
+
+    std::vector<double> sumOld(NORMALS, 0.0), sumNew(NORMALS, 0.0);
+    bool improved = true;
+    std::printf("%-8s %14s %14s %8s\n", "spp", "Hammersley", "Sobol+Owen", "Ratio");
+    for (int spp = 1; spp <= MAX_SPP; ++spp) {
+        const int frame = spp - 1;
+        for (int i = 0; i < NORMALS; ++i) {
+            const glm::ivec2 pixel(i % 32, i / 32);
+            sumOld[i] += EnvironmentRadiance(CosineWeightedHemisphere(Hammersley(DEPTH * 64 + frame, 64), normals[i]));
+            sumNew[i] += EnvironmentRadiance(CosineWeightedHemisphere(PathSample(matrices, pixel, DEPTH, 0u, frame), normals[i]));
+        }
+        if (spp & (spp - 1)) continue;
+
+        double errorOld = 0.0, errorNew = 0.0;
+        for (int i = 0; i < NORMALS; ++i) {
+            errorOld += std::pow(sumOld[i] / spp - reference[i], 2.0);
+            errorNew += std::pow(sumNew[i] / spp - reference[i], 2.0);
+        }
+        const double rmseOld = std::sqrt(errorOld / NORMALS), rmseNew = std::sqrt(errorNew / NORMALS);
+        const double ratio = rmseOld > 0.0 ? rmseNew / rmseOld : 0.0;
+        // 旧图案所有像素相同，64 spp时恰好是完整的64点Hammersley点集，之后方位角循环、不再收敛；
+        // 除这一点外，8 spp起新采样器必须更好
+        if (spp >= 8 && spp != 64 && rmseNew >= rmseOld) improved = false;
+        std::printf("%-8d %14.4f %14.4f %8.2f\n", spp, rmseOld, rmseNew, ratio);
+    }
+    std::printf("%s: Sobol+Owen %s the old Hammersley pattern from 8 spp (except 64)\n",
+        improved ? "PASSED" : "FAILED", improved ? "beats" : "does not beat");
+    return improved ? 0 : 1;
+}
+
+// ---------------------------------------------------------------------------
+// 计时
+
+static double ElapsedNs(const Runner& run, long long iterations) {
+    const auto start = std::chrono::steady_clock::now();
+    double sum = 0.0;
+    for (long long i = 0; i < iterations; ++i) sum += run();
+    const auto end = std::chrono::steady_clock::now();
+    g_Sink = g_Sink + sum;
+    return std::chrono::duration<double, std::nano>(end - start).count();
+}
+
+static double Median(std::vector<double> values) {
+    std::sort(values.begin(), values.end());
+    const size_t n = values.size();
+    return n % 2 ? values[n / 2] : 0.5 * (values[n / 2 - 1] + values[n / 2]);
+}
+
+static CaseResult Measure(const BenchGroup& group, int size, const Options& options) {
+    CaseResult result;
+    result.key = group.name + "/" + std::to_string(size);
+    result.size = size;
+    result.unit = group.unit;
+
+    const Runner run = group.make(size);
+    const double sampleNs = options.sampleMs * 1e6;
+
+    // 校准（同时作为预热）：翻倍重复次数直到一个样本足够长
+    long long iterations = 1;
+    double elapsed = ElapsedNs(run, iterations);
+    while (elapsed < sampleNs && iterations < (1LL << 40)) {
+        const double scale = elapsed > 0.0 ? sampleNs / elapsed * 1.2 : 2.0;
+        iterations = static_cast<long long>(std::ceil(iterations * std::clamp(scale, 2.0, 100.0)));
+        elapsed = ElapsedNs(run, iterations);
+    }
+
+    std::vector<double> samples;
+    double totalNs = 0.0;
+    while (static_cast<int>(samples.size()) < options.maxSamples
+        && (static_cast<int>(samples.size()) < options.minSamples || totalNs < options.budgetMs * 1e6)) {
+        const double ns = ElapsedNs(run, iterations);
+        totalNs += ns;
+        samples.push_back(ns / iterations);
+    }
+
+    result.iterations = iterations;
+    result.samples = static_cast<int>(samples.size());
+    result.medianNs = Median(samples);
+    std::vector<double> deviations;
+    for (double s : samples) deviations.push_back(std::abs(s - result.medianNs));
+    result.madNs = Median(deviations) * 1.4826;    // 正态分布下与标准差一致
+    std::sort(samples.begin(), samples.end());
+    result.minNs = samples.front();
+    result.p95Ns = samples[std::min(samples.size() - 1, static_cast<size_t>(std::ceil(0.95 * samples.size())) - 1)];
+    double sum = 0.0;
+    for (double s : samples) {
+        sum += s;
+        if (std::abs(s - result.medianNs) > 3.0 * result.madNs) result.outliers++;
+    }
+    result.meanNs = sum / samples.size();
+    result.itemsPerSecond = result.medianNs > 0.0 ? size / (result.medianNs * 1e-9) : 0.0;
+    return result;
+}
+
+// ---------------------------------------------------------------------------
+// 报告
+
+static const char* BuildType() {
+#ifdef NDEBUG
+    return "Release";
+#else
+    return "Debug";
+#endif
+}
+
+static std::string CompilerName() {
+#if defined(_MSC_VER)
+    return "MSVC " + std::to_string(_MSC_VER);
+#elif defined(__clang__)
+    return "Clang " __clang_version__;
+#elif defined(__GNUC__)
+    return "GCC " __VERSION__;
+#else
+    return "unknown";
+#endif
+}
+
+static bool WriteReport(const std::string& path, const std::vector<CaseResult>& results) {
+    std::ofstream file(path);
+    if (!file.is_open()) return false;
+
+    file << std::fixed << std::setprecision(2);
+    file << "{\n";
+    file << "  \"version\": 1,\n";
+    file << "  \"compiler\": \"" << JsonEscape(CompilerName()) << "\",\n";
+    file << "  \"build\": \"" << BuildType() << "\",\n";
+    file << "  \"cases\": {";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const CaseResult& r = results[i];
+        file << (i ? ",\n" : "\n") << "    \"" << JsonEscape(r.key) << "\": {\"size\": " << r.size
+            << ", \"unit\": \"" << r.unit << "\", \"iterations\": " << r.iterations << ", \"samples\": " << r.samples
+            << ", \"medianNs\": " << r.medianNs << ", \"madNs\": " << r.madNs << ", \"minNs\": " << r.minNs
+            << ", \"meanNs\": " << r.meanNs << ", \"p95Ns\": " << r.p95Ns
+            << ", \"itemsPerSecond\": " << r.itemsPerSecond << ", \"outliers\": " << r.outliers << "}";
+    }
+    file << "\n  }\n}\n";
+    return file.good();
+}
+
+static std::string FormatNs(double ns) {
+    char text[32];
+    if (ns >= 1e9) std::snprintf(text, sizeof(text), "%.3f s", ns * 1e-9);
+    else if (ns >= 1e6) std::snprintf(text, sizeof(text), "%.3f ms", ns * 1e-6);
+    else if (ns >= 1e3) std::snprintf(text, sizeof(text), "%.3f us", ns * 1e-3);
+    else std::snprintf(text, sizeof(text), "%.1f ns", ns);
+    return text;
+}
+
+static void PrintResult(const CaseResult& r) {
+    const double relativeMad = r.medianNs > 0.0 ? r.madNs / r.medianNs * 100.0 : 0.0;
+    std::printf("%-32s %12s %7.1f%% %12s %10.3g %s/s  (%d x %lld)\n", r.key.c_str(), FormatNs(r.medianNs).c_str(),
+        relativeMad, FormatNs(r.minNs).c_str(), r.itemsPerSecond, r.unit, r.samples, r.iterations);
+    std::fflush(stdout);
+}
+
+static int Compare(const std::vector<CaseResult>& results, const std::string& baselinePath, float thresholdPercent) {
+    JsonValue baseline;
+    if (!LoadJsonFile(baselinePath, baseline)) return 2;
+    const JsonValue* cases = baseline.Find("cases");
+    if (!cases) {
+        std::cerr << baselinePath << " is not a cpu_bench report" << std::endl;
+        return 2;
+    }
+    const JsonValue* build = baseline.Find("build");
+    if (build && build->string != BuildType()) {
+        std::cout << "Warning: baseline is a " << build->string << " build, this is a " << BuildType() << " build" << std::endl;
+    }
+
+    int regressions = 0, improvements = 0;
+    std::printf("\n%-32s %12s %12s %9s\n", "Case", "Baseline", "Current", "Change");
+    for (const CaseResult& r : results) {
+        const JsonValue* entry = cases->Find(r.key);
+        const JsonValue* median = entry ? entry->Find("medianNs") : nullptr;
+        const JsonValue* mad = entry ? entry->Find("madNs") : nullptr;
+        if (!median || median->number <= 0.0) continue;
+
+        const double delta = r.medianNs - median->number;
+        const double percent = delta / median->number * 100.0;
+        // 变化必须同时超过阈值和噪声（两次运行中较大的MAD）
+        const double noise = 3.0 * std::max(r.madNs, mad ? mad->number : 0.0);
+        const char* status = "";
+        if (percent > thresholdPercent && delta > noise) {
+            status = "REGRESSION";
+            regressions++;
+        }
+        else if (percent < -thresholdPercent && -delta > noise) {
+            status = "improved";
+            improvements++;
+        }
+        std::printf("%-32s %12s %12s %+8.1f%%  %s\n", r.key.c_str(), FormatNs(median->number).c_str(),
+            FormatNs(r.medianNs).c_str(), percent, status);
+    }
+    std::printf("%s: %d regression(s), %d improvement(s) (threshold %.1f%%)\n",
+        regressions > 0 ? "FAILED" : "PASSED", regressions, improvements, thresholdPercent);
+    return regressions > 0 ? 1 : 0;
+}
+
+// ---------------------------------------------------------------------------
+
+static void PrintUsage() {
+    std::cout <<
+        "Usage: cpu_bench [options]\n"
+        "       cpu_bench --convergence\n"
+        "  --filter <text>          run only cases whose name/size contains <text>\n"
+        "  --max-size <N>           skip problem sizes larger than N (default 1000000, at least 100)\n"
+        "  --output <file>          report path (default cpu_bench_result.json)\n"
+        "  --baseline <file>        compare the report against a stored baseline, exit 1 on regression\n"
+        "  --threshold <percent>    regression threshold relative to the baseline median (default 10)\n"
+        "  --min-samples <n>        samples collected per case at least (default 5)\n"
+        "  --max-samples <n>        samples collected per case at most (default 30)\n"
+        "  --sample-ms <ms>         minimum duration of one sample (default 10)\n"
+        "  --budget-ms <ms>         sampling time budget per case (default 2000)\n"
+        "  --list                   list the cases and exit\n"
+        "  --convergence            compare sampler RMSE vs spp instead of timing, exit 1 if Sobol does not win\n"
+        "  --help                   show this message\n";
+}
+
+static bool ParseOptions(int argc, char** argv, Options& options) {
+    static const char* valueOptions[] = {
+        "--filter", "--output", "--baseline", "--max-size", "--min-samples", "--max-samples",
+        "--sample-ms", "--budget-ms", "--threshold"
+    };
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--help") {
+            options.help = true;
+            return true;
+        }
+        if (arg == "--list") {
+            options.list = true;
+            continue;
+        }
+        if (arg == "--convergence") {
+            options.convergence = true;
+            continue;
+        }
+        if (std::find(std::begin(valueOptions), std::end(valueOptions), arg) == std::end(valueOptions)) {
+            std::cerr << "Unknown option " << arg << std::endl;
+            return false;
+        }
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << arg << std::endl;
+            return false;
+        }
+        const std::string value = argv[++i];
+        if (arg == "--filter") options.filter = value;
+        else if (arg == "--output") options.outputPath = value;
+        else if (arg == "--baseline") options.baselinePath = value;
+        else if (arg == "--max-size") options.maxSize = std::max(std::atoi(value.c_str()), 100);
+        else if (arg == "--min-samples") options.minSamples = std::max(std::atoi(value.c_str()), 1);
+        else if (arg == "--max-samples") options.maxSamples = std::max(std::atoi(value.c_str()), 1);
+        else if (arg == "--sample-ms") options.sampleMs = std::max(std::atof(value.c_str()), 0.1);
+        else if (arg == "--budget-ms") options.budgetMs = std::max(std::atof(value.c_str()), 0.0);
+        else if (arg == "--threshold") options.thresholdPercent = static_cast<float>(std::atof(value.c_str()));
+    }
+    options.maxSamples = std::max(options.maxSamples, options.minSamples);
+    return true;
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        PrintUsage();
+        return 2;
+    }
+    if (options.help) {
+        PrintUsage();
+        return 0;
+    }
+    if (options.convergence) return RunConvergence();
+
+    const std::vector<BenchGroup> groups = MakeGroups(options);
+    if (options.list) {
+        for (const BenchGroup& group : groups) {
+            for (int size : group.sizes) std::cout << group.name << "/" << size << "\n";
+        }
+        return 0;
+    }
+
+#ifndef NDEBUG
+    std::cout << "Warning: Debug build, timings are not representative" << std::endl;
+#endif
+    std::printf("%-32s %12s %8s %12s %16s\n", "Case", "Median", "MAD", "Min", "Throughput");
+
+    std::vector<CaseResult> results;
+    for (const BenchGroup& group : groups) {
+        for (int size : group.sizes) {
+            const std::string key = group.name + "/" + std::to_string(size);
+            if (!options.filter.empty() && key.find(options.filter) == std::string::npos) continue;
+            results.push_back(Measure(group, size, options));
+            PrintResult(results.back());
+        }
+    }
+    std::error_code ec;
+    fs::remove(fs::temp_directory_path() / "cpu_bench.scene", ec);
+
+    if (!WriteReport(options.outputPath, results)) {
+        std::cerr << "Failed to write " << options.outputPath << std::endl;
+        return 2;
+    }
+    std::cout << results.size() << " case(s), report written to " << options.outputPath << std::endl;
+
+    if (!options.baselinePath.empty()) return Compare(results, options.baselinePath, options.thresholdPercent);
+    return 0;
+}
@@ -1,14 +0,0 @@
-#version 430 core
-
-in vec2 TexCoords;
-out vec4 FragColor;
-
-uniform sampler2D scene;
-uniform sampler2D bloomBlur;
-uniform float bloomStrength = 0.5;
-
-void main() {
-    vec3 sceneColor = texture(scene, TexCoords).rgb;
-    vec3 bloomColor = texture(bloomBlur, TexCoords).rgb;
-    FragColor = vec4(sceneColor + bloomColor * bloomStrength, 1.0);
-}
\ No newline at end of file
@@ -0,0 +1,70 @@
+#version 430 core
+
+in vec2 TexCoords;
+out vec4 FragColor;
+
+uniform sampler2D srcTexture;
+uniform bool prefilter;         // 第一级：Karis平均 + 亮度阈值
+uniform float threshold = 1.0;
+uniform float softKnee = 0.5;
+
+float luminance(vec3 c) {
+    return dot(c, vec3(0.2126, 0.7152, 0.0722));
+}
+
+// Karis平均：按亮度反比加权，抑制单个高亮像素造成的闪烁
+float karisWeight(vec3 c) {
+    return 1.0 / (1.0 + luminance(c));
+}
+
+// 软阈值，避免高光边缘突变
+vec3 applyThreshold(vec3 color) {
+    float brightness = max(color.r, max(color.g, color.b));
+    float knee = threshold * softKnee;
+    float soft = clamp(brightness - threshold + knee, 0.0, 2.0 * knee);
+    soft = soft * soft / (4.0 * knee + 1e-4);
+    float contribution = max(soft, brightness - threshold) / max(brightness, 1e-4);
+    return color * contribution;
+}
+
+void main() {
+    vec2 texel = 1.0 / vec2(textureSize(srcTexture, 0));
+
+    // 13-tap降采样（Jimenez 2014）：a-b-c / -j-k- / d-e-f / -l-m- / g-h-i
+    vec3 a = texture(srcTexture, TexCoords + texel * vec2(-2.0,  2.0)).rgb;
+    vec3 b = texture(srcTexture, TexCoords + texel * vec2( 0.0,  2.0)).rgb;
+    vec3 c = texture(srcTexture, TexCoords + texel * vec2( 2.0,  2.0)).rgb;
+    vec3 d = texture(srcTexture, TexCoords + texel * vec2(-2.0,  0.0)).rgb;
+    vec3 e = texture(srcTexture, TexCoords).rgb;
+    vec3 f = texture(srcTexture, TexCoords + texel * vec2( 2.0,  0.0)).rgb;
+    vec3 g = texture(srcTexture, TexCoords + texel * vec2(-2.0, -2.0)).rgb;
+    vec3 h = texture(srcTexture, TexCoords + texel * vec2( 0.0, -2.0)).rgb;
+    vec3 i = texture(srcTexture, TexCoords + texel * vec2( 2.0, -2.0)).rgb;
+    vec3 j = texture(srcTexture, TexCoords + texel * vec2(-1.0,  1.0)).rgb;
+    vec3 k = texture(srcTexture, TexCoords + texel * vec2( 1.0,  1.0)).rgb;
+    vec3 l = texture(srcTexture, TexCoords + texel * vec2(-1.0, -1.0)).rgb;
+    vec3 m = texture(srcTexture, TexCoords + texel * vec2( 1.0, -1.0)).rgb;
+
+    vec3 result;
+    if(prefilter) {
+        // 5个2x2盒子分别加权
+        vec3 box0 = (j + k + l + m) * 0.25;
+        vec3 box1 = (a + b + d + e) * 0.25;
+        vec3 box2 = (b + c + e + f) * 0.25;
+        vec3 box3 = (d + e + g + h) * 0.25;
+        vec3 box4 = (e + f + h + i) * 0.25;
+        float w0 = 0.5 * karisWeight(box0);
+        float w1 = 0.125 * karisWeight(box1);
+        float w2 = 0.125 * karisWeight(box2);
+        float w3 = 0.125 * karisWeight(box3);
+        float w4 = 0.125 * karisWeight(box4);
+        result = (box0 * w0 + box1 * w1 + box2 * w2 + box3 * w3 + box4 * w4) / (w0 + w1 + w2 + w3 + w4);
+        result = applyThreshold(result);
+    } else {
+        result = e * 0.125;
+        result += (a + c + g + i) * 0.03125;
+        result += (b + d + f + h) * 0.0625;
+        result += (j + k + l + m) * 0.125;
+    }
+    FragColor = vec4(max(result, 0.0), 1.0);
+}
\ No newline at end of file
@@ -0,0 +1,30 @@
+#version 430 core
+
+in vec2 TexCoords;
+out vec4 FragColor;
+
+uniform sampler2D srcTexture;   // 低一级（更小）的mip
+uniform float filterRadius = 1.0; // 以源纹理texel为单位
+
+void main() {
+    vec2 r = filterRadius / vec2(textureSize(srcTexture, 0));
+
+    // 3x3 tent滤波：1-2-1 / 2-4-2 / 1-2-1
+    vec3 a = texture(srcTexture, TexCoords + vec2(-r.x,  r.y)).rgb;
+    vec3 b = texture(srcTexture, TexCoords + vec2( 0.0,  r.y)).rgb;
+    vec3 c = texture(srcTexture, TexCoords + vec2( r.x,  r.y)).rgb;
+    vec3 d = texture(srcTexture, TexCoords + vec2(-r.x,  0.0)).rgb;
+    vec3 e = texture(srcTexture, TexCoords).rgb;
+    vec3 f = texture(srcTexture, TexCoords + vec2( r.x,  0.0)).rgb;
+    vec3 g = texture(srcTexture, TexCoords + vec2(-r.x, -r.y)).rgb;
+    vec3 h = texture(srcTexture, TexCoords + vec2( 0.0, -r.y)).rgb;
+    vec3 i = texture(srcTexture, TexCoords + vec2( r.x, -r.y)).rgb;
+
+    vec3 result = e * 4.0;
+    result += (b + d + f + h) * 2.0;
+    result += (a + c + g + i);
+    result *= 1.0 / 16.0;
+
+    // 通过加法混合叠加到当前级
+    FragColor = vec4(result, 1.0);
+}
\ No newline at end of file
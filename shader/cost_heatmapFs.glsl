@@ -0,0 +1,37 @@
+#version 430 core
+// 开销热力图：把光追写出的每像素开销映射为伪彩色，按不透明度叠加在最终画面上
+
+in vec2 TexCoords;
+out vec4 FragColor;
+
+uniform sampler2D costTexture;      // R32F，渲染分辨率
+uniform float maxValue = 100.0;     // 映射到颜色表顶端的开销
+uniform bool logScale = false;
+uniform float opacity = 0.75;
+
+// Turbo颜色表的多项式拟合（Google, 2019）
+vec3 turbo(float x) {
+    const vec4 kRedVec4 = vec4(0.13572138, 4.61539260, -42.66032258, 132.13108234);
+    const vec4 kGreenVec4 = vec4(0.09140261, 2.19418839, 4.84296658, -14.18503333);
+    const vec4 kBlueVec4 = vec4(0.10667330, 12.64194608, -60.58204836, 110.36276771);
+    const vec2 kRedVec2 = vec2(-152.94239396, 59.28637943);
+    const vec2 kGreenVec2 = vec2(4.27729857, 2.82956604);
+    const vec2 kBlueVec2 = vec2(-89.90310912, 27.34824973);
+
+    x = clamp(x, 0.0, 1.0);
+    vec4 v4 = vec4(1.0, x, x * x, x * x * x);
+    vec2 v2 = v4.zw * v4.z;
+    return vec3(
+        dot(v4, kRedVec4) + dot(v2, kRedVec2),
+        dot(v4, kGreenVec4) + dot(v2, kGreenVec2),
+        dot(v4, kBlueVec4) + dot(v2, kBlueVec2)
+    );
+}
+
+void main() {
+    // 按最近像素取值，不在开销之间插值
+    ivec2 size = textureSize(costTexture, 0);
+    float cost = texelFetch(costTexture, min(ivec2(TexCoords * vec2(size)), size - 1), 0).r;
+    float x = logScale ? log2(1.0 + cost) / log2(1.0 + maxValue) : cost / maxValue;
+    FragColor = vec4(turbo(x), opacity);
+}
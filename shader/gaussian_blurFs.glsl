@@ -5,21 +5,24 @@ out vec4 FragColor;
 
 uniform sampler2D image;
 uniform bool horizontal;
-uniform float weight[5] = float[] (0.227027, 0.1945946, 0.1216216, 0.054054, 0.016216);
+// 9-tap高斯核 (0.227027, 0.1945946, 0.1216216, 0.054054, 0.016216) 的线性采样折叠：
+// 相邻两个texel合并为一次双线性采样，每个方向只需5次读取（要求GL_LINEAR过滤）
+uniform float offset[3] = float[] (0.0, 1.3846153846, 3.2307692308);
+uniform float weight[3] = float[] (0.2270270270, 0.3162162162, 0.0702702703);
 
 void main() {
     vec2 tex_offset = 1.0 / textureSize(image, 0);
     vec3 result = texture(image, TexCoords).rgb * weight[0];
     
     if(horizontal) {
-        for(int i = 1; i < 5; ++i) {
-            result += texture(image, TexCoords + vec2(tex_offset.x * i, 0.0)).rgb * weight[i];
-            result += texture(image, TexCoords - vec2(tex_offset.x * i, 0.0)).rgb * weight[i];
+        for(int i = 1; i < 3; ++i) {
+            result += texture(image, TexCoords + vec2(tex_offset.x * offset[i], 0.0)).rgb * weight[i];
+            result += texture(image, TexCoords - vec2(tex_offset.x * offset[i], 0.0)).rgb * weight[i];
         }
     } else {
-        for(int i = 1; i < 5; ++i) {
-            result += texture(image, TexCoords + vec2(0.0, tex_offset.y * i)).rgb * weight[i];
-            result += texture(image, TexCoords - vec2(0.0, tex_offset.y * i)).rgb * weight[i];
+        for(int i = 1; i < 3; ++i) {
+            result += texture(image, TexCoords + vec2(0.0, tex_offset.y * offset[i])).rgb * weight[i];
+            result += texture(image, TexCoords - vec2(0.0, tex_offset.y * offset[i])).rgb * weight[i];
         }
     }
     FragColor = vec4(result, 1.0);
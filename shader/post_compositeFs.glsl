@@ -0,0 +1,34 @@
+#version 430 core
+// 融合后处理pass：AO + Bloom合成 + 曝光 + 色调映射，一次读取场景直接写默认帧缓冲
+
+in vec2 TexCoords;
+out vec4 FragColor;
+
+uniform sampler2D scene;
+uniform sampler2D bloomBlur;
+uniform float bloomStrength = 0.5;
+uniform sampler2D aoTexture;        // 全分辨率AO（已双边上采样）
+uniform bool useAO = false;
+uniform float aoStrength = 1.0;
+uniform float exposure = 1.0;
+uniform int tonemapMode = 2;        // 0 = 无，1 = Reinhard，2 = ACES
+uniform bool gammaCorrect = false;
+
+// Narkowicz的ACES拟合
+vec3 acesFilm(vec3 x) {
+    const float a = 2.51, b = 0.03, c = 2.43, d = 0.59, e = 0.14;
+    return clamp((x * (a * x + b)) / (x * (c * x + d) + e), 0.0, 1.0);
+}
+
+void main() {
+    vec3 sceneColor = texture(scene, TexCoords).rgb;
+    vec3 bloomColor = texture(bloomBlur, TexCoords).rgb;
+    if(useAO) sceneColor *= pow(texture(aoTexture, TexCoords).r, aoStrength);
+    vec3 color = (sceneColor + bloomColor * bloomStrength) * exposure;
+
+    if(tonemapMode == 1) color = color / (1.0 + color);
+    else if(tonemapMode == 2) color = acesFilm(color);
+
+    if(gammaCorrect) color = pow(color, vec3(1.0 / 2.2));
+    FragColor = vec4(color, 1.0);
+}
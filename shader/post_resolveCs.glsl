@@ -0,0 +1,118 @@
+#version 430
+// 融合后处理pass：TAA解析 + Bloom亮度提取
+// 当前帧3x3邻域经共享内存读取，每个像素的当前帧和历史只从显存读一次
+#define TILE_SIZE 16
+#define APRON (TILE_SIZE + 2)
+
+layout(local_size_x = TILE_SIZE, local_size_y = TILE_SIZE) in;
+layout(binding = 5) writeonly uniform image2D resolvedImage;    // 新的历史（RGBA32F）
+layout(binding = 6) writeonly uniform image2D brightImage;      // 亮度提取结果（RGBA16F）
+
+uniform sampler2D uCurrentFrame;
+uniform sampler2D uHistory;
+uniform sampler2D gNormal;          // 八面体编码的法线
+uniform sampler2D gDepth;           // 线性深度，0 表示天空
+uniform sampler2D uMotion;          // 运动向量（上一帧UV - 当前帧UV）
+uniform sampler2D uPrevDepth;       // 上一帧的G-Buffer，用于遮挡检测
+uniform sampler2D uPrevNormal;
+uniform mat4 uInvProjection;
+uniform mat4 uInvView;
+uniform mat4 uPrevViewProj;
+uniform bool uTAAEnabled;
+uniform bool uHistoryValid;
+uniform float uBlendFactor;         // 当前帧权重
+uniform float uDepthTolerance;      // 相对深度容差
+uniform float uNormalThreshold;
+uniform bool uExtractBright;
+uniform float uThreshold;
+
+shared vec3 currentTile[APRON][APRON];
+
+vec3 clipAABB(vec3 color, vec3 minColor, vec3 maxColor) {
+    vec3 center = 0.5 * (maxColor + minColor);
+    vec3 extents = 0.5 * (maxColor - minColor);
+    vec3 clip = color - center;
+    clip = clamp(clip, -extents, extents);
+    return center + clip;
+}
+
+vec2 signNotZero(vec2 v) {
+    return vec2(v.x >= 0.0 ? 1.0 : -1.0, v.y >= 0.0 ? 1.0 : -1.0);
+}
+
+vec3 octDecode(vec2 e) {
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    if(n.z < 0.0) n.xy = (1.0 - abs(n.yx)) * signNotZero(n.xy);
+    return normalize(n);
+}
+
+// 由线性深度（视空间-z）重建世界空间位置；主光线的亚像素抖动不保存，按像素中心重建
+vec3 reconstructPosition(vec2 uv, float depth) {
+    vec4 viewRay = uInvProjection * vec4(uv * 2.0 - 1.0, 1.0, 1.0);
+    vec3 viewPos = viewRay.xyz / viewRay.w;
+    return (uInvView * vec4(viewPos * (depth / -viewPos.z), 1.0)).xyz;
+}
+
+// 重投影后检查历史像素是否仍是同一表面（深度和法线都要接近）
+bool isDisoccluded(ivec2 pixel, vec2 uv, vec2 prevUV) {
+    float currDepth = texelFetch(gDepth, pixel, 0).r;
+    float prevDepth = texture(uPrevDepth, prevUV).r;
+    // 天空只和天空匹配
+    if(currDepth <= 0.0 || prevDepth <= 0.0) return (currDepth <= 0.0) != (prevDepth <= 0.0);
+
+    // 当前点在上一帧的线性深度（clip.w）
+    float expectedDepth = (uPrevViewProj * vec4(reconstructPosition(uv, currDepth), 1.0)).w;
+    if(abs(prevDepth - expectedDepth) > uDepthTolerance * expectedDepth) return true;
+
+    vec3 currNormal = octDecode(texelFetch(gNormal, pixel, 0).rg);
+    vec3 prevNormal = octDecode(texture(uPrevNormal, prevUV).rg);
+    return dot(currNormal, prevNormal) < uNormalThreshold;
+}
+
+void main() {
+    ivec2 size = textureSize(uCurrentFrame, 0);
+    ivec2 origin = ivec2(gl_WorkGroupID.xy) * TILE_SIZE - 1;
+
+    // 载入tile及1像素边界（邻域钳制用）
+    if(uTAAEnabled) {
+        for(int i = int(gl_LocalInvocationIndex); i < APRON * APRON; i += TILE_SIZE * TILE_SIZE) {
+            ivec2 local = ivec2(i % APRON, i / APRON);
+            ivec2 coord = clamp(origin + local, ivec2(0), size - 1);
+            currentTile[local.y][local.x] = texelFetch(uCurrentFrame, coord, 0).rgb;
+        }
+    }
+    barrier();
+
+    ivec2 pixel = ivec2(gl_GlobalInvocationID.xy);
+    if(any(greaterThanEqual(pixel, size))) return;
+
+    ivec2 center = ivec2(gl_LocalInvocationID.xy) + 1;
+    vec3 result = uTAAEnabled ? currentTile[center.y][center.x] : texelFetch(uCurrentFrame, pixel, 0).rgb;
+
+    if(uTAAEnabled) {
+        // 按运动向量重投影历史
+        vec2 uv = (vec2(pixel) + 0.5) / vec2(size);
+        vec2 prevUV = uv + texelFetch(uMotion, pixel, 0).xy;
+        bool offscreen = any(lessThan(prevUV, vec2(0.0))) || any(greaterThan(prevUV, vec2(1.0)));
+        if(uHistoryValid && !offscreen && !isDisoccluded(pixel, uv, prevUV)) {
+            // 计算邻域颜色范围（抗重影）
+            vec3 minColor = result, maxColor = result;
+            for(int y = -1; y <= 1; ++y) {
+                for(int x = -1; x <= 1; ++x) {
+                    vec3 neighbor = currentTile[center.y + y][center.x + x];
+                    minColor = min(minColor, neighbor);
+                    maxColor = max(maxColor, neighbor);
+                }
+            }
+            vec3 history = clipAABB(texture(uHistory, prevUV).rgb, minColor, maxColor);
+            result = mix(history, result, uBlendFactor);
+        }
+        imageStore(resolvedImage, pixel, vec4(result, 1.0));
+    }
+
+    // 亮度提取：使用解析后的颜色，省去单独pass对场景的再次读取
+    if(uExtractBright) {
+        float brightness = dot(result, vec3(0.2126, 0.7152, 0.0722));
+        imageStore(brightImage, pixel, brightness > uThreshold ? vec4(result, 1.0) : vec4(0.0, 0.0, 0.0, 1.0));
+    }
+}
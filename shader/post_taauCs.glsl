@@ -0,0 +1,158 @@
+#version 430
+// 时域上采样（TAAU）：输入为渲染分辨率、带全屏统一亚像素抖动的光追结果，在输出分辨率上重建并累积
+//   当前帧 —— 以输出像素中心为圆心，对最近的3x3个输入采样做Lanczos2加权
+//   历史   —— Catmull-Rom重投影采样，用当前帧邻域的AABB裁剪
+//   累积   —— 历史alpha保存已累积的采样权重，本帧权重由最近采样离输出像素中心的距离决定
+// 同时输出Bloom亮度提取（与post_resolveCs.glsl一致）
+#define TILE_SIZE 16
+#define PI 3.14159265359
+
+layout(local_size_x = TILE_SIZE, local_size_y = TILE_SIZE) in;
+layout(binding = 5) writeonly uniform image2D resolvedImage;    // 新的历史（输出分辨率，a = 累积权重）
+layout(binding = 6) writeonly uniform image2D brightImage;      // 亮度提取结果（输出分辨率）
+
+uniform sampler2D uCurrentFrame;    // 渲染分辨率
+uniform sampler2D uHistory;         // 输出分辨率
+uniform sampler2D gNormal;          // 以下G-Buffer均为渲染分辨率
+uniform sampler2D gDepth;
+uniform sampler2D uMotion;
+uniform sampler2D uPrevDepth;
+uniform sampler2D uPrevNormal;
+uniform mat4 uInvProjection;
+uniform mat4 uInvView;
+uniform mat4 uPrevViewProj;
+uniform bool uHistoryValid;
+uniform bool uPrevGeometryValid;    // false：渲染分辨率刚变化，上一帧G-Buffer内容未定义，跳过遮挡检测
+uniform vec2 uJitter;               // 本帧采样相对渲染像素中心的偏移（渲染像素单位）
+uniform float uBlendFactor;         // 收敛后当前帧的最小权重，决定累积权重上限
+uniform float uDepthTolerance;
+uniform float uNormalThreshold;
+uniform bool uExtractBright;
+uniform float uThreshold;
+
+vec2 signNotZero(vec2 v) {
+    return vec2(v.x >= 0.0 ? 1.0 : -1.0, v.y >= 0.0 ? 1.0 : -1.0);
+}
+
+vec3 octDecode(vec2 e) {
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    if(n.z < 0.0) n.xy = (1.0 - abs(n.yx)) * signNotZero(n.xy);
+    return normalize(n);
+}
+
+vec3 reconstructPosition(vec2 uv, float depth) {
+    vec4 viewRay = uInvProjection * vec4(uv * 2.0 - 1.0, 1.0, 1.0);
+    vec3 viewPos = viewRay.xyz / viewRay.w;
+    return (uInvView * vec4(viewPos * (depth / -viewPos.z), 1.0)).xyz;
+}
+
+// 与post_resolveCs.glsl相同，pixel为渲染分辨率像素
+bool isDisoccluded(ivec2 pixel, vec2 uv, vec2 prevUV) {
+    float currDepth = texelFetch(gDepth, pixel, 0).r;
+    float prevDepth = texture(uPrevDepth, prevUV).r;
+    if(currDepth <= 0.0 || prevDepth <= 0.0) return (currDepth <= 0.0) != (prevDepth <= 0.0);
+
+    float expectedDepth = (uPrevViewProj * vec4(reconstructPosition(uv, currDepth), 1.0)).w;
+    if(abs(prevDepth - expectedDepth) > uDepthTolerance * expectedDepth) return true;
+
+    vec3 currNormal = octDecode(texelFetch(gNormal, pixel, 0).rg);
+    vec3 prevNormal = octDecode(texture(uPrevNormal, prevUV).rg);
+    return dot(currNormal, prevNormal) < uNormalThreshold;
+}
+
+vec3 clipAABB(vec3 color, vec3 minColor, vec3 maxColor) {
+    vec3 center = 0.5 * (maxColor + minColor);
+    vec3 extents = 0.5 * (maxColor - minColor);
+    vec3 clip = color - center;
+    clip = clamp(clip, -extents, extents);
+    return center + clip;
+}
+
+// sinc(x) * sinc(x / 2)，x为到采样点的距离（渲染像素单位）
+float lanczos2(float x) {
+    if(x < 1e-4) return 1.0;
+    if(x >= 2.0) return 0.0;
+    float px = PI * x;
+    return 2.0 * sin(px) * sin(px * 0.5) / (px * px);
+}
+
+// Catmull-Rom历史采样：利用双线性过滤，9次采样完成4x4滤波，减少多帧重采样的模糊
+vec3 sampleHistoryCatmullRom(vec2 uv) {
+    vec2 size = vec2(textureSize(uHistory, 0));
+    vec2 samplePos = uv * size;
+    vec2 texPos1 = floor(samplePos - 0.5) + 0.5;
+    vec2 f = samplePos - texPos1;
+
+    vec2 w0 = f * (-0.5 + f * (1.0 - 0.5 * f));
+    vec2 w1 = 1.0 + f * f * (-2.5 + 1.5 * f);
+    vec2 w2 = f * (0.5 + f * (2.0 - 1.5 * f));
+    vec2 w3 = f * f * (-0.5 + 0.5 * f);
+    vec2 w12 = w1 + w2;
+
+    vec2 texPos0 = (texPos1 - 1.0) / size;
+    vec2 texPos3 = (texPos1 + 2.0) / size;
+    vec2 texPos12 = (texPos1 + w2 / w12) / size;
+
+    vec3 result = vec3(0.0);
+    result += texture(uHistory, vec2(texPos0.x, texPos0.y)).rgb * w0.x * w0.y;
+    result += texture(uHistory, vec2(texPos12.x, texPos0.y)).rgb * w12.x * w0.y;
+    result += texture(uHistory, vec2(texPos3.x, texPos0.y)).rgb * w3.x * w0.y;
+    result += texture(uHistory, vec2(texPos0.x, texPos12.y)).rgb * w0.x * w12.y;
+    result += texture(uHistory, vec2(texPos12.x, texPos12.y)).rgb * w12.x * w12.y;
+    result += texture(uHistory, vec2(texPos3.x, texPos12.y)).rgb * w3.x * w12.y;
+    result += texture(uHistory, vec2(texPos0.x, texPos3.y)).rgb * w0.x * w3.y;
+    result += texture(uHistory, vec2(texPos12.x, texPos3.y)).rgb * w12.x * w3.y;
+    result += texture(uHistory, vec2(texPos3.x, texPos3.y)).rgb * w3.x * w3.y;
+    return max(result, vec3(0.0));
+}
+
+void main() {
+    ivec2 outSize = imageSize(resolvedImage);
+    ivec2 pixel = ivec2(gl_GlobalInvocationID.xy);
+    if(any(greaterThanEqual(pixel, outSize))) return;
+    ivec2 inSize = textureSize(uCurrentFrame, 0);
+
+    // 输出像素中心在渲染像素坐标系中的位置；渲染像素i的采样点位于 i + 0.5 + uJitter
+    vec2 uv = (vec2(pixel) + 0.5) / vec2(outSize);
+    vec2 inPos = uv * vec2(inSize) - 0.5 - uJitter;
+    ivec2 nearest = clamp(ivec2(floor(inPos + 0.5)), ivec2(0), inSize - 1);
+
+    // 当前帧重建
+    vec3 colorSum = vec3(0.0);
+    float weightSum = 0.0;
+    vec3 minColor = vec3(1e30), maxColor = vec3(-1e30);
+    for(int y = -1; y <= 1; ++y) {
+        for(int x = -1; x <= 1; ++x) {
+            ivec2 samplePixel = nearest + ivec2(x, y);
+            vec3 color = texelFetch(uCurrentFrame, clamp(samplePixel, ivec2(0), inSize - 1), 0).rgb;
+            float weight = lanczos2(length(vec2(samplePixel) - inPos));
+            colorSum += color * weight;
+            weightSum += weight;
+            minColor = min(minColor, color);
+            maxColor = max(maxColor, color);
+        }
+    }
+    // 负瓣可能产生振铃，限制在邻域范围内
+    vec3 current = clamp(colorSum / max(weightSum, 1e-4), minColor, maxColor);
+    // 本帧对该输出像素的可信度：最近采样越靠近输出像素中心越高
+    float sampleWeight = lanczos2(length(vec2(nearest) - inPos));
+    float maxWeight = 1.0 / uBlendFactor;
+
+    vec3 result = current;
+    float accumulated = sampleWeight;
+    vec2 prevUV = uv + texelFetch(uMotion, nearest, 0).xy;
+    bool offscreen = any(lessThan(prevUV, vec2(0.0))) || any(greaterThan(prevUV, vec2(1.0)));
+    vec2 nearestUV = (vec2(nearest) + 0.5) / vec2(inSize);
+    if(uHistoryValid && !offscreen && (!uPrevGeometryValid || !isDisoccluded(nearest, nearestUV, prevUV))) {
+        vec3 history = clipAABB(sampleHistoryCatmullRom(prevUV), minColor, maxColor);
+        float historyWeight = min(texture(uHistory, prevUV).a, maxWeight);
+        result = mix(history, current, sampleWeight / max(historyWeight + sampleWeight, 1e-4));
+        accumulated = historyWeight + sampleWeight;
+    }
+    imageStore(resolvedImage, pixel, vec4(result, min(accumulated, maxWeight)));
+
+    if(uExtractBright) {
+        float brightness = dot(result, vec3(0.2126, 0.7152, 0.0722));
+        imageStore(brightImage, pixel, brightness > uThreshold ? vec4(result, 1.0) : vec4(0.0, 0.0, 0.0, 1.0));
+    }
+}
@@ -0,0 +1,133 @@
+#version 430
+// 将探针光线结果混合进八面体图集：每个工作组处理一个探针
+#define IRRADIANCE_TEXELS 8
+#define DISTANCE_TEXELS 16
+#define MAX_RAYS_PER_PROBE 256
+#define PI 3.14159265359
+
+layout(local_size_x = DISTANCE_TEXELS, local_size_y = DISTANCE_TEXELS) in;
+layout(rgba16f, binding = 5) uniform image2D irradianceAtlas;
+layout(rg16f, binding = 6) uniform image2D distanceAtlas;
+
+uniform sampler2D probeRayData;     // rgb = 辐射度，a = 命中距离（背面为负）
+uniform ivec3 probeCounts;
+uniform int probeFirst;
+uniform int probeRaysPerProbe;
+uniform mat4 probeRayRotation;
+uniform float hysteresis;
+uniform float probeMaxDistance;
+
+shared vec4 rayRadiance[MAX_RAYS_PER_PROBE];
+shared vec3 rayDirection[MAX_RAYS_PER_PROBE];
+shared vec4 irradianceTile[IRRADIANCE_TEXELS][IRRADIANCE_TEXELS];
+shared vec2 distanceTile[DISTANCE_TEXELS][DISTANCE_TEXELS];
+
+// 与raytracingCs.glsl中的方向生成保持一致
+vec3 sphericalFibonacci(int i, int n) {
+    const float GOLDEN_RATIO = 1.61803398875;
+    float phi = 2.0 * PI * fract(float(i) * (GOLDEN_RATIO - 1.0));
+    float cosTheta = 1.0 - (2.0 * float(i) + 1.0) / float(n);
+    float sinTheta = sqrt(clamp(1.0 - cosTheta * cosTheta, 0.0, 1.0));
+    return vec3(cos(phi) * sinTheta, sin(phi) * sinTheta, cosTheta);
+}
+
+vec3 probeRayDirection(int i) {
+    return normalize(mat3(probeRayRotation) * sphericalFibonacci(i, probeRaysPerProbe));
+}
+
+vec2 signNotZero(vec2 v) {
+    return vec2(v.x >= 0.0 ? 1.0 : -1.0, v.y >= 0.0 ? 1.0 : -1.0);
+}
+
+vec3 octDecode(vec2 e) {
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    if(n.z < 0.0) n.xy = (1.0 - abs(n.yx)) * signNotZero(n.xy);
+    return normalize(n);
+}
+
+ivec2 probeTileOrigin(int probeIndex, int texels) {
+    int columns = probeCounts.x * probeCounts.y;
+    return ivec2(probeIndex % columns, probeIndex / columns) * (texels + 2);
+}
+
+// 边界像素复制八面体展开后相邻的内部像素，保证双线性过滤无缝
+ivec2 borderSource(ivec2 t, int n) {
+    bool edgeX = t.x == 0 || t.x == n + 1;
+    bool edgeY = t.y == 0 || t.y == n + 1;
+    if(edgeX && edgeY) return ivec2(t.x == 0 ? n : 1, t.y == 0 ? n : 1);
+    if(t.y == 0) return ivec2(n + 1 - t.x, 1);
+    if(t.y == n + 1) return ivec2(n + 1 - t.x, n);
+    if(t.x == 0) return ivec2(1, n + 1 - t.y);
+    if(t.x == n + 1) return ivec2(n, n + 1 - t.y);
+    return t;
+}
+
+void main() {
+    int slot = int(gl_WorkGroupID.x);
+    int probeIndex = (probeFirst + slot) % (probeCounts.x * probeCounts.y * probeCounts.z);
+    int tid = int(gl_LocalInvocationIndex);
+    ivec2 local = ivec2(gl_LocalInvocationID.xy);
+
+    for(int i = tid; i < probeRaysPerProbe; i += DISTANCE_TEXELS * DISTANCE_TEXELS) {
+        rayRadiance[i] = texelFetch(probeRayData, ivec2(i, slot), 0);
+        rayDirection[i] = probeRayDirection(i);
+    }
+
+    ivec2 irradianceOrigin = probeTileOrigin(probeIndex, IRRADIANCE_TEXELS);
+    ivec2 distanceOrigin = probeTileOrigin(probeIndex, DISTANCE_TEXELS);
+    // alpha为0表示探针第一次更新，直接使用新结果
+    bool firstUpdate = imageLoad(irradianceAtlas, irradianceOrigin + ivec2(1)).a == 0.0;
+    barrier();
+
+    // 距离矩（用于切比雪夫可见性测试）
+    {
+        vec3 texelDir = octDecode((vec2(local) + 0.5) / float(DISTANCE_TEXELS) * 2.0 - 1.0);
+        vec2 sum = vec2(0.0);
+        float weightSum = 0.0;
+        for(int i = 0; i < probeRaysPerProbe; ++i) {
+            float weight = pow(max(dot(texelDir, rayDirection[i]), 0.0), 50.0);
+            float d = min(abs(rayRadiance[i].a), probeMaxDistance);
+            sum += weight * vec2(d, d * d);
+            weightSum += weight;
+        }
+        vec2 result = weightSum > 1e-4 ? sum / weightSum : vec2(probeMaxDistance, probeMaxDistance * probeMaxDistance);
+        if(!firstUpdate) {
+            vec2 previous = imageLoad(distanceAtlas, distanceOrigin + local + 1).rg;
+            result = mix(result, previous, hysteresis);
+        }
+        distanceTile[local.y][local.x] = result;
+    }
+
+    // 辐照度：余弦加权的平均入射辐射度（即 E / PI）
+    if(all(lessThan(local, ivec2(IRRADIANCE_TEXELS)))) {
+        vec3 texelDir = octDecode((vec2(local) + 0.5) / float(IRRADIANCE_TEXELS) * 2.0 - 1.0);
+        vec3 sum = vec3(0.0);
+        float weightSum = 0.0;
+        for(int i = 0; i < probeRaysPerProbe; ++i) {
+            float weight = max(dot(texelDir, rayDirection[i]), 0.0);
+            sum += weight * rayRadiance[i].rgb;
+            weightSum += weight;
+        }
+        vec3 result = weightSum > 1e-4 ? sum / weightSum : vec3(0.0);
+        if(!firstUpdate) {
+            vec3 previous = imageLoad(irradianceAtlas, irradianceOrigin + local + 1).rgb;
+            result = mix(result, previous, hysteresis);
+        }
+        irradianceTile[local.y][local.x] = vec4(result, 1.0);
+    }
+    barrier();
+
+    // 写回内部像素和边界
+    const int distanceSide = DISTANCE_TEXELS + 2;
+    for(int i = tid; i < distanceSide * distanceSide; i += DISTANCE_TEXELS * DISTANCE_TEXELS) {
+        ivec2 t = ivec2(i % distanceSide, i / distanceSide);
+        ivec2 s = borderSource(t, DISTANCE_TEXELS) - 1;
+        imageStore(distanceAtlas, distanceOrigin + t, vec4(distanceTile[s.y][s.x], 0.0, 0.0));
+    }
+    const int irradianceSide = IRRADIANCE_TEXELS + 2;
+    if(tid < irradianceSide * irradianceSide) {
+        ivec2 t = ivec2(tid % irradianceSide, tid / irradianceSide);
+        ivec2 s = borderSource(t, IRRADIANCE_TEXELS) - 1;
+        imageStore(irradianceAtlas, irradianceOrigin + t, irradianceTile[s.y][s.x]);
+    }
+}
@@ -1,7 +1,9 @@
 #version 430 core
+#extension GL_ARB_shader_clock : enable     // 开销热力图的时钟模式（不支持时该模式输出0）
 
 #define DIFFUSE_SAMPLES 8     // 每像素漫反射采样数
-#define MAX_RAY_DEPTH 3       // 增大递归深度
+#define MAX_PATH_LENGTH 16    // 运行时深度上限，需与PathLengthController::MAX_PATH_LENGTH一致
+#define SOBOL_DIMENSIONS 4    // 需与SobolSampler::DIMENSIONS一致
 
 const float PI = 3.14159265359;
 
@@ -58,9 +60,13 @@ struct Light {
 };
 
 layout(local_size_x = 32, local_size_y = 32) in;
-layout(rgba32f, binding = 0) uniform image2D outputImage;
-layout(rgba32f, binding = 1) uniform image2D gPosition;
-layout(rgba16f, binding = 2) uniform image2D gNormal;
+layout(binding = 0) writeonly uniform image2D outputImage;  // 格式可配置（RGBA32F/RGBA16F/R11G11B10F），由glBindImageTexture决定
+layout(r32f, binding = 1) uniform image2D gDepth;        // 主光线命中点的线性深度（视空间-z），0 = 天空
+layout(rg16_snorm, binding = 2) uniform image2D gNormal; // 八面体编码的法线
+layout(rg16f, binding = 3) uniform image2D gMotion;   // 运动向量：上一帧UV - 当前帧UV
+layout(rgba16f, binding = 4) uniform image2D probeRayData; // 探针光线结果（probeUpdatePass）
+layout(r16f, binding = 5) uniform image2D rtaoImage;       // 光追AO结果（rtaoPass）
+layout(r32f, binding = 6) uniform writeonly image2D costImage; // 每像素开销（costMode != 0时写入）
 
 layout(std430, binding = 0) buffer Objects {
     Object objects[];
@@ -68,6 +74,42 @@ layout(std430, binding = 0) buffer Objects {
 layout(std430, binding = 1) buffer Lights {
     Light lights[];
 };
+// Sobol生成矩阵（CPU端启动时上传）
+layout(std430, binding = 2) readonly buffer SobolMatrices {
+    uint sobolMatrices[]; // SOBOL_DIMENSIONS * 32
+};
+// 路径长度统计（每帧清零，CPU异步回读）
+layout(std430, binding = 4) buffer PathStats {
+    uint pathLengthHistogram[MAX_PATH_LENGTH + 1];
+    uint rouletteTerminations;
+};
+shared uint groupPathHistogram[MAX_PATH_LENGTH + 2]; // 最后一项为轮盘赌终止数
+
+// 光线/相交计数（可选，每帧清零，CPU异步回读），需与GPUCounters.h一致
+#define RAY_COUNTER_PRIMARY   0
+#define RAY_COUNTER_BOUNCE    1
+#define RAY_COUNTER_SHADOW    2
+#define RAY_COUNTER_SSS       3
+#define RAY_COUNTER_PROBE     4
+#define RAY_COUNTER_AO        5
+#define RAY_COUNTER_PRIMITIVE 6   // 球/平面相交测试
+#define RAY_COUNTER_AABB      7   // 包围盒（加速结构节点）访问
+#define RAY_COUNTER_COUNT     8
+layout(std430, binding = 5) buffer RayCounters {
+    uint rayCounters[RAY_COUNTER_COUNT * 2];  // 64位计数：[2i]低32位，[2i + 1]高32位
+};
+shared uint groupRayCounters[RAY_COUNTER_COUNT];
+uint rayCount[RAY_COUNTER_COUNT];             // 每个调用私有，dispatch结束时汇总
+
+// 天空盒重要性采样的别名表（切换天空盒时重建）
+struct EnvAliasEntry {
+    float q;        // 保留自身的概率阈值
+    uint alias;     // 别名索引
+    float pdf;      // 该单元的离散概率
+};
+layout(std430, binding = 3) readonly buffer EnvAliasTable {
+    EnvAliasEntry envAlias[];
+};
 
 uniform int numObjects;
 uniform int numLights;
@@ -81,6 +123,8 @@ uniform float focalLength = 1.0;   // 焦距
 
 uniform samplerCube skybox;
 uniform bool useSkybox;
+uniform bool useEnvSampling;     // 天空盒显式采样（MIS）
+uniform ivec2 envDistSize;       // 别名表对应的经纬图分辨率
 
 uniform float maxRayDistance = 114514.0; // 最大射线距离限制
 
@@ -88,6 +132,37 @@ uniform sampler2D blueNoiseTex;
 uniform vec2 noiseScale;
 uniform int frameCount;
 
+uniform mat4 prevViewProj;           // 上一帧的视图投影矩阵（用于计算运动向量）
+uniform bool useFixedJitter;         // TAAU：全屏统一的Halton亚像素偏移，上采样时已知每个采样的位置
+uniform vec2 jitterOffset;           // 渲染像素单位，[-0.5, 0.5]
+
+// 辐照度探针体（见ProbeVolume）
+uniform bool useProbes;
+uniform bool probeUpdatePass;        // true时本次dispatch追踪探针光线而不是相机光线
+uniform vec3 probeGridMin;
+uniform vec3 probeSpacing;
+uniform ivec3 probeCounts;
+uniform float probeNormalBias;
+uniform float probeMaxDistance;
+uniform float probeRoughnessThreshold;
+uniform int probeFirst;
+uniform int probeUpdateCount;
+uniform int probeRaysPerProbe;
+uniform mat4 probeRayRotation;
+uniform sampler2D irradianceAtlas;   // 八面体映射，rgb = E / PI
+uniform sampler2D distanceAtlas;     // 八面体映射，rg = 距离的一阶、二阶矩
+
+uniform bool rtaoPass;               // true时本次dispatch追踪AO遮挡光线（读取本帧G-Buffer）
+uniform int rtaoRays;
+uniform float rtaoRadius;            // 遮挡光线的tMax
+uniform int rtaoDivisor;             // AO缓冲相对G-Buffer的缩小倍数
+
+uniform int maxRayDepth = 3;         // 最大弹射次数（由PathLengthController动态调整）
+uniform int rouletteStartDepth = 1;  // 从该深度开始俄罗斯轮盘赌
+uniform bool collectPathStats;
+uniform bool collectRayCounters;
+uniform int costMode;                // 开销热力图：0 = 关闭，1 = 相交测试，2 = 阴影光线，3 = 弹射次数，4 = 着色器时钟
+
 bool intersectAABB(Ray ray, AABB aabb, out float tMin, out float tMax) {
     vec3 invDir = 1.0 / ray.direction;
     vec3 t0 = (aabb.min - ray.origin) * invDir;
@@ -160,9 +235,11 @@ bool intersectObjects(Ray ray, out Material hitMaterial, out vec3 hitNormal, out
         Object obj = objects[i];
         // 先检测AABB
         float boxTMin, boxTMax;
+        rayCount[RAY_COUNTER_AABB]++;
         if(!intersectAABB(ray, obj.bounds, boxTMin, boxTMax)) continue;
         
         // 再检测具体形状
+        rayCount[RAY_COUNTER_PRIMITIVE]++;
         float currentT;
         bool isHit = false;
 
@@ -195,13 +272,10 @@ bool intersectObjects(Ray ray, out Material hitMaterial, out vec3 hitNormal, out
     return hit;
 }
 
-void generateCameraRay(out Ray ray, vec2 jitter) {
-    ivec2 pixelCoords = ivec2(gl_GlobalInvocationID.xy);
-    ivec2 imageSize = imageSize(outputImage);
-    
+// 屏幕位置（像素坐标，可带亚像素偏移）对应的相机光线方向
+vec3 cameraRayDirection(vec2 pixelPos, ivec2 imageSize) {
     // 计算屏幕坐标（-1到1范围）
-    // 添加抖动偏移
-    vec2 uv = (vec2(pixelCoords) + 0.5 + jitter) / vec2(imageSize);
+    vec2 uv = pixelPos / vec2(imageSize);
     uv = uv * 2.0 - 1.0;
     
     // 根据FOV计算实际屏幕坐标
@@ -210,8 +284,15 @@ void generateCameraRay(out Ray ray, vec2 jitter) {
     uv.x *= aspect * tanFov * focalLength;
     uv.y *= tanFov * focalLength;
     
+    return normalize(cameraDir + uv.x * cameraRight + uv.y * cameraUp);
+}
+
+void generateCameraRay(out Ray ray, vec2 jitter) {
+    ivec2 pixelCoords = ivec2(gl_GlobalInvocationID.xy);
+    
+    // 添加抖动偏移
     ray.origin = cameraPos;
-    ray.direction = normalize(cameraDir + uv.x * cameraRight + uv.y * cameraUp);
+    ray.direction = cameraRayDirection(vec2(pixelCoords) + 0.5 + jitter, imageSize(outputImage));
     ray.energy = 1.0;
     ray.depth = 0;
 }
@@ -269,9 +350,104 @@ vec3 calculateRefraction(Ray ray, vec3 hitPoint, vec3 N, Material mat, inout flo
     return refractDir;
 }
 
-// 随机数生成器（用于采样分布）
-float random(vec2 st) {
-    return fract(sin(dot(st.xy, vec2(12.9898,78.233)))*43758.5453123);
+// PCG哈希：用像素、帧、弹射次数生成互不相关的种子
+uint pcgHash(uint v) {
+    uint state = v * 747796405u + 2891336453u;
+    uint word = ((state >> ((state >> 28u) + 4u)) ^ state) * 277803737u;
+    return (word >> 22u) ^ word;
+}
+
+uint hashCombine(uint seed, uint v) {
+    return seed ^ (pcgHash(v) + (seed << 6) + (seed >> 2));
+}
+
+// Sobol序列第dim维的第index个点（32位定点数）
+uint sobol(uint index, uint dim) {
+    uint result = 0u;
+    uint base = dim * 32u;
+    for(uint bit = 0u; index != 0u; index >>= 1u, ++bit) {
+        if((index & 1u) != 0u) result ^= sobolMatrices[base + bit];
+    }
+    return result;
+}
+
+// 基于哈希的Owen扰乱（Laine-Karras置换，Burley 2020的参数）
+uint laineKarrasPermutation(uint x, uint seed) {
+    x += seed;
+    x ^= x * 0x6c50b47cu;
+    x ^= x * 0xb82f1e52u;
+    x ^= x * 0xc7afe638u;
+    x ^= x * 0x8d22f6e6u;
+    return x;
+}
+
+uint nestedUniformScramble(uint x, uint seed) {
+    x = bitfieldReverse(x);
+    x = laineKarrasPermutation(x, seed);
+    return bitfieldReverse(x);
+}
+
+// 打乱+Owen扰乱的4维Sobol样本：索引打乱去除像素间相关性，每维独立扰乱
+vec4 sobolSample4D(uint sampleIndex, uint seed) {
+    uint index = nestedUniformScramble(sampleIndex, seed);
+    uvec4 x;
+    for(uint d = 0u; d < uint(SOBOL_DIMENSIONS); ++d) {
+        x[d] = nestedUniformScramble(sobol(index, d), hashCombine(seed, d));
+    }
+    return vec4(x >> 8u) * (1.0 / 16777216.0); // 取高24位，保证结果 < 1.0
+}
+
+// 每个像素、每次弹射使用独立的种子；样本索引随帧递增
+// stream区分同一次弹射中的不同用途（0 = BSDF，1 = 天空盒采样），相当于维度填充
+vec4 pathSample(int depth, uint stream) {
+    ivec2 pixel = ivec2(gl_GlobalInvocationID.xy);
+    uint pixelSeed = pcgHash(uint(pixel.x) ^ pcgHash(uint(pixel.y)));
+    uint seed = hashCombine(hashCombine(pixelSeed, uint(depth)), stream);
+    return sobolSample4D(uint(frameCount), seed);
+}
+
+// ---------------- 天空盒重要性采样 ----------------
+// 与skyboxFs.glsl的经纬图映射一致：u = atan(z, x) / 2π + 0.5，v = asin(y) / π + 0.5
+vec2 envUV(vec3 dir) {
+    return vec2(atan(dir.z, dir.x) / (2.0 * PI) + 0.5, asin(clamp(dir.y, -1.0, 1.0)) / PI + 0.5);
+}
+
+vec3 envDirection(vec2 uv) {
+    float phi = (uv.x - 0.5) * 2.0 * PI;
+    float lat = (uv.y - 0.5) * PI;
+    return vec3(cos(lat) * cos(phi), sin(lat), cos(lat) * sin(phi));
+}
+
+// 离散概率转换为立体角上的pdf：单元立体角 = (2π/W)(π/H)cos(纬度)
+float envSolidAnglePdf(int index, float v) {
+    float cosLat = cos((v - 0.5) * PI);
+    if(cosLat <= 1e-4) return 0.0;
+    return envAlias[index].pdf * float(envDistSize.x * envDistSize.y) / (2.0 * PI * PI * cosLat);
+}
+
+float envPdf(vec3 dir) {
+    vec2 uv = envUV(dir);
+    ivec2 cell = min(ivec2(uv * vec2(envDistSize)), envDistSize - 1);
+    return envSolidAnglePdf(cell.y * envDistSize.x + cell.x, uv.y);
+}
+
+// 别名表O(1)采样：u.x选单元（小数部分复用于别名判断），u.yz在单元内抖动
+vec3 sampleEnvironment(vec3 u, out float pdf) {
+    int count = envDistSize.x * envDistSize.y;
+    float x = u.x * float(count);
+    int index = min(int(x), count - 1);
+    if(fract(x) >= envAlias[index].q) index = int(envAlias[index].alias);
+
+    ivec2 cell = ivec2(index % envDistSize.x, index / envDistSize.x);
+    vec2 uv = (vec2(cell) + u.yz) / vec2(envDistSize);
+    pdf = envSolidAnglePdf(index, uv.y);
+    return envDirection(uv);
+}
+
+float powerHeuristic(float pdfA, float pdfB) {
+    float a = pdfA * pdfA;
+    float b = pdfB * pdfB;
+    return a + b > 0.0 ? a / (a + b) : 0.0;
 }
 
 // 低差异序列确保采样点均匀分布，减少噪声。
@@ -330,6 +506,7 @@ vec3 computeSubsurfaceScattering(vec3 P, vec3 N, Material mat) {
         Material tempMat;
         vec3 tempNormal;
         float t;
+        rayCount[RAY_COUNTER_SSS]++;
         if(intersectObjects(sssRay, tempMat, tempNormal, t)) {
             float attenuation = exp(-t / mat.scatterDistance);
             sss += tempMat.albedo * attenuation;
@@ -385,6 +562,7 @@ float pcfShadow(vec3 point, vec3 normal, Light light, vec3 lightDir, float light
         Material tempMat;
         vec3 tempNormal;
         float t;
+        rayCount[RAY_COUNTER_SHADOW]++;
         bool isOccluded = intersectObjects(shadowRay, tempMat, tempNormal, t);
 
         if(light.type == 0 || light.type == 2) { // 点/区域光源需要距离判断
@@ -416,6 +594,7 @@ float pcssShadow(vec3 point, vec3 normal, Light light, vec3 lightDir, float ligh
         Material tempMat;
         vec3 tempNormal;
         float t;
+        rayCount[RAY_COUNTER_SHADOW]++;
         bool isOccluded = intersectObjects(shadowRay, tempMat, tempNormal, t);
 
         if(light.type != 1) { // 非定向光需要距离判断
@@ -506,10 +685,271 @@ vec3 computeLighting(vec3 P, vec3 N, Material mat, vec3 V) {
     return Lo;
 }
 
+// 天空盒显式采样：与漫反射BSDF采样（余弦pdf）做MIS
+// 当前BSDF采样方向按粗糙度混合了镜面方向，因此按粗糙度缩放该策略的权重
+vec3 sampleEnvironmentLight(vec3 P, vec3 N, Material mat, vec3 u) {
+    float lightPdf;
+    vec3 L = sampleEnvironment(u, lightPdf);
+    float NdotL = dot(N, L);
+    if(NdotL <= 0.0 || lightPdf <= 0.0) return vec3(0.0);
+
+    Ray shadowRay;
+    shadowRay.origin = P + N * 0.001;
+    shadowRay.direction = L;
+    shadowRay.depth = 0;
+
+    Material tempMat;
+    vec3 tempNormal;
+    float t;
+    rayCount[RAY_COUNTER_SHADOW]++;
+    if(intersectObjects(shadowRay, tempMat, tempNormal, t)) return vec3(0.0);
+
+    float bsdfPdf = NdotL / PI;
+    float weight = powerHeuristic(lightPdf, bsdfPdf) * mat.roughness;
+    vec3 brdf = mat.albedo * mat.diffuseStrength / PI;
+    return texture(skybox, L).rgb * brdf * NdotL * weight / lightPdf;
+}
+
+// ------------------------- 辐照度探针 -------------------------
+vec2 signNotZero(vec2 v) {
+    return vec2(v.x >= 0.0 ? 1.0 : -1.0, v.y >= 0.0 ? 1.0 : -1.0);
+}
+
+vec2 octEncode(vec3 n) {
+    n /= abs(n.x) + abs(n.y) + abs(n.z);
+    return n.z >= 0.0 ? n.xy : (1.0 - abs(n.yx)) * signNotZero(n.xy);
+}
+
+vec3 octDecode(vec2 e) {
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    if(n.z < 0.0) n.xy = (1.0 - abs(n.yx)) * signNotZero(n.xy);
+    return normalize(n);
+}
+
+// 与probeUpdateCs.glsl中的方向生成保持一致
+vec3 sphericalFibonacci(int i, int n) {
+    const float GOLDEN_RATIO = 1.61803398875;
+    float phi = 2.0 * PI * fract(float(i) * (GOLDEN_RATIO - 1.0));
+    float cosTheta = 1.0 - (2.0 * float(i) + 1.0) / float(n);
+    float sinTheta = sqrt(clamp(1.0 - cosTheta * cosTheta, 0.0, 1.0));
+    return vec3(cos(phi) * sinTheta, sin(phi) * sinTheta, cosTheta);
+}
+
+vec3 probeWorldPosition(ivec3 coord) {
+    return probeGridMin + vec3(coord) * probeSpacing;
+}
+
+int probeLinearIndex(ivec3 coord) {
+    return coord.x + coord.y * probeCounts.x + coord.z * probeCounts.x * probeCounts.y;
+}
+
+vec2 probeAtlasUV(int probeIndex, vec3 dir, int texels, vec2 atlasSize) {
+    int columns = probeCounts.x * probeCounts.y;
+    vec2 origin = vec2(probeIndex % columns, probeIndex / columns) * float(texels + 2) + 1.0;
+    return (origin + (octEncode(dir) * 0.5 + 0.5) * float(texels)) / atlasSize;
+}
+
+// 周围8个探针的三线性插值，按背向和切比雪夫可见性加权，返回 E / PI
+vec3 sampleProbeIrradiance(vec3 P, vec3 N, vec3 V) {
+    vec2 irradianceSize = vec2(textureSize(irradianceAtlas, 0));
+    vec2 distanceSize = vec2(textureSize(distanceAtlas, 0));
+    const int irradianceTexels = 8, distanceTexels = 16;
+
+    vec3 biasedP = P + (N * 0.2 + V * 0.8) * probeNormalBias;
+    vec3 gridPos = (biasedP - probeGridMin) / probeSpacing;
+    ivec3 baseCoord = clamp(ivec3(floor(gridPos)), ivec3(0), probeCounts - 2);
+    vec3 alpha = clamp(gridPos - vec3(baseCoord), 0.0, 1.0);
+
+    vec3 irradiance = vec3(0.0);
+    float weightSum = 0.0;
+    for(int i = 0; i < 8; ++i) {
+        ivec3 offset = ivec3(i & 1, (i >> 1) & 1, (i >> 2) & 1);
+        ivec3 coord = baseCoord + offset;
+        int probeIndex = probeLinearIndex(coord);
+        vec3 probePos = probeWorldPosition(coord);
+
+        vec3 trilinear = mix(1.0 - alpha, alpha, vec3(offset));
+        float weight = trilinear.x * trilinear.y * trilinear.z;
+
+        // 背向表面的探针权重降低
+        vec3 dirToProbe = normalize(probePos - P);
+        float wrap = (dot(dirToProbe, N) + 1.0) * 0.5;
+        weight *= wrap * wrap + 0.2;
+
+        // 切比雪夫可见性测试，避免漏光
+        vec3 probeToPoint = biasedP - probePos;
+        float dist = length(probeToPoint);
+        vec2 moments = texture(distanceAtlas, probeAtlasUV(probeIndex, probeToPoint / max(dist, 1e-4), distanceTexels, distanceSize)).rg;
+        if(dist > moments.x) {
+            float variance = abs(moments.y - moments.x * moments.x);
+            float d = dist - moments.x;
+            float chebyshev = variance / (variance + d * d);
+            weight *= max(chebyshev * chebyshev * chebyshev, 0.0);
+        }
+
+        weight = max(weight, 1e-6);
+        irradiance += weight * texture(irradianceAtlas, probeAtlasUV(probeIndex, N, irradianceTexels, irradianceSize)).rgb;
+        weightSum += weight;
+    }
+    return irradiance / weightSum;
+}
+
+// 探针更新pass：x = 光线序号，y = 本帧更新的探针槽位
+void traceProbeRay() {
+    ivec2 id = ivec2(gl_GlobalInvocationID.xy);
+    if(id.x >= probeRaysPerProbe || id.y >= probeUpdateCount) return;
+
+    int probeIndex = (probeFirst + id.y) % (probeCounts.x * probeCounts.y * probeCounts.z);
+    ivec3 coord = ivec3(probeIndex % probeCounts.x, (probeIndex / probeCounts.x) % probeCounts.y, probeIndex / (probeCounts.x * probeCounts.y));
+
+    Ray ray;
+    ray.origin = probeWorldPosition(coord);
+    ray.direction = normalize(mat3(probeRayRotation) * sphericalFibonacci(id.x, probeRaysPerProbe));
+    ray.energy = 1.0;
+    ray.depth = 0;
+
+    Material mat;
+    vec3 N;
+    float t;
+    vec4 result;
+    rayCount[RAY_COUNTER_PROBE]++;
+    if(!intersectObjects(ray, mat, N, t)) {
+        result = vec4(useSkybox ? texture(skybox, ray.direction).rgb : vec3(0.0), probeMaxDistance);
+    } else if(dot(N, ray.direction) > 0.0) {
+        result = vec4(0.0, 0.0, 0.0, -0.2 * t); // 击中背面：探针在几何体内部
+    } else {
+        vec3 P = ray.origin + ray.direction * t;
+        vec3 V = -ray.direction;
+        vec3 radiance = computeLighting(P, N, mat, V);
+        // 读取上一轮的探针结果得到多次弹射
+        radiance += mat.albedo * mat.diffuseStrength * sampleProbeIrradiance(P, N, V);
+        result = vec4(radiance, t);
+    }
+    imageStore(probeRayData, id, result);
+}
+
+// 遮挡查询：只需知道tMax内是否有任意命中，找到即返回
+bool occluded(Ray ray, float tMax) {
+    for(int i = 0; i < numObjects; i++) {
+        Object obj = objects[i];
+        float boxTMin, boxTMax;
+        rayCount[RAY_COUNTER_AABB]++;
+        if(!intersectAABB(ray, obj.bounds, boxTMin, boxTMax) || boxTMin > tMax) continue;
+
+        rayCount[RAY_COUNTER_PRIMITIVE]++;
+        float t;
+        bool isHit = false;
+        if(obj.type == 0) isHit = intersectSphere(ray, obj, t);
+        else if(obj.type == 1) isHit = intersectPlane(ray, obj, t);
+        if(isHit && t > 0.0 && t < tMax) return true;
+    }
+    return false;
+}
+
+// 光追AO pass：x,y = AO缓冲像素，从G-Buffer读取主光线命中点，发射余弦分布的短距离遮挡光线
+void traceAmbientOcclusion() {
+    ivec2 aoPixel = ivec2(gl_GlobalInvocationID.xy);
+    if(any(greaterThanEqual(aoPixel, imageSize(rtaoImage)))) return;
+
+    ivec2 gPixel = aoPixel * rtaoDivisor;
+    float depth = imageLoad(gDepth, gPixel).r;
+    if(depth <= 0.0) {
+        imageStore(rtaoImage, aoPixel, vec4(1.0));
+        return;
+    }
+    // 沿像素中心的相机光线重建命中点（线性深度 = 到相机平面的距离）
+    vec3 dir = cameraRayDirection(vec2(gPixel) + 0.5, imageSize(gDepth));
+    vec3 position = cameraPos + dir * (depth / dot(dir, cameraDir));
+    vec3 N = octDecode(imageLoad(gNormal, gPixel).xy);
+    if(dot(N, cameraPos - position) < 0.0) N = -N; // 平面法线可能背向相机
+
+    Ray ray;
+    ray.origin = position + N * 0.001;
+    ray.energy = 1.0;
+    ray.depth = 0;
+
+    uint seed = hashCombine(pcgHash(uint(aoPixel.x) + uint(aoPixel.y) * 65536u), uint(frameCount));
+    float visibility = 0.0;
+    for(int i = 0; i < rtaoRays; ++i) {
+        vec2 u = vec2(pcgHash(seed + uint(2 * i)), pcgHash(seed + uint(2 * i + 1))) / 4294967296.0;
+        ray.direction = cosineWeightedHemisphere(u, N);
+        rayCount[RAY_COUNTER_AO]++;
+        if(!occluded(ray, rtaoRadius)) visibility += 1.0;
+    }
+    imageStore(rtaoImage, aoPixel, vec4(visibility / float(rtaoRays)));
+}
+
+// 将世界坐标（w=1）或无穷远方向（w=0）投影到上一帧的屏幕UV，位于相机后方时返回屏幕外坐标
+vec2 previousScreenUV(vec4 world) {
+    vec4 clip = prevViewProj * world;
+    if(clip.w <= 1e-5) return vec2(-1.0);
+    return clip.xy / clip.w * 0.5 + 0.5;
+}
+
+// 先在共享内存中累计工作组的直方图，再每个bin做一次全局原子操作，降低争用
+void recordPathLength(bool isActive, int pathLength, bool rouletteTerminated) {
+    uint localIndex = gl_LocalInvocationIndex;
+    if(localIndex < uint(MAX_PATH_LENGTH + 2)) groupPathHistogram[localIndex] = 0u;
+    barrier();
+
+    if(isActive) {
+        atomicAdd(groupPathHistogram[min(pathLength, MAX_PATH_LENGTH)], 1u);
+        if(rouletteTerminated) atomicAdd(groupPathHistogram[MAX_PATH_LENGTH + 1], 1u);
+    }
+    barrier();
+
+    if(localIndex <= uint(MAX_PATH_LENGTH)) {
+        uint count = groupPathHistogram[localIndex];
+        if(count > 0u) atomicAdd(pathLengthHistogram[localIndex], count);
+    } else if(localIndex == uint(MAX_PATH_LENGTH + 1)) {
+        uint count = groupPathHistogram[localIndex];
+        if(count > 0u) atomicAdd(rouletteTerminations, count);
+    }
+}
+
+// 与路径统计相同：工作组内先在共享内存中汇总，每个计数器只做一次全局原子操作
+// 低32位溢出时向高32位进位（GL 4.3没有64位原子操作）
+void recordRayCounters() {
+    uint localIndex = gl_LocalInvocationIndex;
+    if(localIndex < uint(RAY_COUNTER_COUNT)) groupRayCounters[localIndex] = 0u;
+    barrier();
+
+    for(int i = 0; i < RAY_COUNTER_COUNT; ++i) {
+        if(rayCount[i] > 0u) atomicAdd(groupRayCounters[i], rayCount[i]);
+    }
+    barrier();
+
+    if(localIndex < uint(RAY_COUNTER_COUNT)) {
+        uint count = groupRayCounters[localIndex];
+        if(count > 0u) {
+            uint previous = atomicAdd(rayCounters[2u * localIndex], count);
+            if(previous + count < previous) atomicAdd(rayCounters[2u * localIndex + 1u], 1u);
+        }
+    }
+}
+
 void main() {
+    for(int i = 0; i < RAY_COUNTER_COUNT; ++i) rayCount[i] = 0u;
+
+    // 各pass内的提前返回只退出函数，汇总时整个工作组仍然到达barrier
+    if(probeUpdatePass) {
+        traceProbeRay();
+        if(collectRayCounters) recordRayCounters();
+        return;
+    }
+    if(rtaoPass) {
+        traceAmbientOcclusion();
+        if(collectRayCounters) recordRayCounters();
+        return;
+    }
+
+#ifdef GL_ARB_shader_clock
+    uvec2 clockStart = clock2x32ARB();
+#endif
     ivec2 pixelCoords = ivec2(gl_GlobalInvocationID.xy);
+    bool insideImage = all(lessThan(pixelCoords, imageSize(outputImage)));
     
-    vec2 jitter = vec2(
+    vec2 jitter = useFixedJitter ? jitterOffset : vec2(
         texture(blueNoiseTex, (gl_GlobalInvocationID.xy + frameCount) * noiseScale).xy
     ) * 2.0 - 1.0; // 范围映射到[-1,1]
 
@@ -523,28 +963,72 @@ void main() {
     vec3 V;
     vec3 N;
 
-    for(int depth = 0; depth < MAX_RAY_DEPTH; ++depth) {
+    // 主光线命中信息（写入G-Buffer，供AO和TAA重投影使用）
+    vec3 primaryDir = ray.direction;
+    vec3 primaryP = vec3(0.0);
+    vec3 primaryN = vec3(0.0);
+    bool primaryHit = false;
+
+    // 上一次漫反射弹射的余弦pdf和粗糙度（用于未命中时的MIS权重）
+    float lastBsdfPdf = 0.0;
+    float lastMisRoughness = 0.0;
+
+    int pathLength = 0;             // 实际追踪的光线段数
+    bool rouletteTerminated = false;
+    int depthLimit = insideImage ? min(maxRayDepth, MAX_PATH_LENGTH) : 0;
+
+    for(int depth = 0; depth < depthLimit; ++depth) {
         Material mat;
         float t;
         
+        pathLength++;
+        rayCount[depth == 0 ? RAY_COUNTER_PRIMARY : RAY_COUNTER_BOUNCE]++;
         if(!intersectObjects(ray, mat, N, t)) {
-            if(useSkybox) finalColor += throughput * texture(skybox, ray.direction).rgb;
+            if(useSkybox) {
+                vec3 envColor = texture(skybox, ray.direction).rgb;
+                if(useEnvSampling && lastMisRoughness > 0.0) {
+                    float weight = powerHeuristic(lastBsdfPdf, envPdf(ray.direction));
+                    envColor *= mix(1.0, weight, lastMisRoughness);
+                }
+                finalColor += throughput * envColor;
+            }
             else finalColor += throughput * vec3(0.0);
             break;
         }
         
         P = ray.origin + ray.direction * t;
         V = normalize(-ray.direction);
+        if(depth == 0) {
+            primaryP = P;
+            primaryN = N;
+            primaryHit = true;
+        }
         
         // 计算表面光照
         vec3 Lo = computeLighting(P, N, mat, V);
         finalColor += throughput * Lo;
+
+        // 粗糙漫反射表面的间接光由探针提供（已包含天空光），路径在此终止
+        if(useProbes && mat.diffuseStrength > 0.0 && mat.roughness >= probeRoughnessThreshold) {
+            finalColor += throughput * mat.albedo * mat.diffuseStrength * sampleProbeIrradiance(P, N, V);
+            break;
+        }
+
+        // 天空盒显式采样（仅漫反射表面）
+        if(useSkybox && useEnvSampling && mat.diffuseStrength > 0.0) {
+            finalColor += throughput * sampleEnvironmentLight(P, N, mat, pathSample(depth, 1u).xyz);
+        }
         
-        // 俄罗斯轮盘赌终止条件
-        if(depth > 2) {
-            float diffuseWeight = length(mat.albedo) * mat.diffuseStrength;
-            float continueProb = min(max(throughput.x, max(throughput.y, throughput.z)) * 0.95 + diffuseWeight, 0.99);
-            if(random(gl_GlobalInvocationID.xy + depth) > continueProb) break;
+        // 本次弹射的低差异样本：xy = 方向采样，z = 俄罗斯轮盘赌
+        vec4 u = pathSample(depth, 0u);
+
+        // 俄罗斯轮盘赌：按路径通量决定继续概率，低贡献路径尽早终止
+        if(depth >= rouletteStartDepth && depth + 1 < depthLimit) {
+            float continueProb = min(max(throughput.x, max(throughput.y, throughput.z)), 0.95);
+            if(u.z >= continueProb) {
+                rouletteTerminated = true;
+                break;
+            }
             throughput /= continueProb;
         }
         
@@ -553,32 +1037,54 @@ void main() {
         
         // 选择反射或折射（选择射线方向）给下一次用
         if (mat.diffuseStrength > 0.0) {
-            // 生成低差异随机数
-            vec2 rand = hammersley(depth * 64 + frameCount, 64);
-    
             // 重要性采样：根据粗糙度混合镜面与漫反射
             vec3 specularDir = reflect(ray.direction, N);
-            vec3 diffuseDir = cosineWeightedHemisphere(rand, N);
+            vec3 diffuseDir = cosineWeightedHemisphere(u.xy, N);
             vec3 mixedDir = mix(specularDir, diffuseDir, mat.roughness);
     
             // 更新光线
             ray.direction = normalize(mixedDir);
             ray.origin = P + N * 0.001;
             throughput *= mat.albedo * mat.diffuseStrength;
+            lastBsdfPdf = max(dot(N, ray.direction), 0.0) / PI;
+            lastMisRoughness = mat.roughness;
         }else if(mat.transparency > 0.0) {
             ray.direction = calculateRefraction(ray, P, N, mat, ray.energy);
             ray.origin = P - N * 0.001;
             throughput *= mat.albedo * (1.0 - F) * mat.transparency;
+            lastMisRoughness = 0.0;
         } else {
             ray.direction = reflect(ray.direction, N);
             ray.origin = P + N * 0.001;
             throughput *= mat.albedo * F;
+            lastMisRoughness = 0.0;
         }
         
         ray.energy *= 0.8; // 能量衰减
     }
     
+    if(collectPathStats) recordPathLength(insideImage, pathLength, rouletteTerminated);
+    if(collectRayCounters) recordRayCounters();
+    if(!insideImage) return;
+
+    // 运动向量：命中点按位置重投影，天空按方向重投影（只受相机旋转影响）
+    // TAAU时以实际采样位置为起点
+    vec2 currentUV = (vec2(pixelCoords) + 0.5 + (useFixedJitter ? jitterOffset : vec2(0.0))) / vec2(imageSize(outputImage));
+    vec2 prevUV = primaryHit ? previousScreenUV(vec4(primaryP, 1.0)) : previousScreenUV(vec4(primaryDir, 0.0));
+
     imageStore(outputImage, pixelCoords, vec4(finalColor, 1.0));
-    imageStore(gPosition, pixelCoords, vec4(P, 1.0));
-    imageStore(gNormal, pixelCoords, vec4(N, 1.0));
+    imageStore(gDepth, pixelCoords, vec4(primaryHit ? dot(primaryP - cameraPos, cameraDir) : 0.0));
+    imageStore(gNormal, pixelCoords, vec4(primaryHit ? octEncode(primaryN) : vec2(0.0), 0.0, 0.0));
+    imageStore(gMotion, pixelCoords, vec4(prevUV - currentUV, 0.0, 0.0));
+
+    if(costMode != 0) {
+        float cost = 0.0;
+        if(costMode == 1) cost = float(rayCount[RAY_COUNTER_AABB] + rayCount[RAY_COUNTER_PRIMITIVE]);
+        else if(costMode == 2) cost = float(rayCount[RAY_COUNTER_SHADOW]);
+        else if(costMode == 3) cost = float(pathLength);
+#ifdef GL_ARB_shader_clock
+        else if(costMode == 4) cost = float(clock2x32ARB().x - clockStart.x); // 只取低32位，无符号减法可处理一次回绕
+#endif
+        imageStore(costImage, pixelCoords, vec4(cost));
+    }
 }
\ No newline at end of file
@@ -0,0 +1,50 @@
+#version 430 core
+// 光追AO的时域累积：按运动向量重投影历史，r = AO，g = 已累积帧数
+out vec2 FragColor;
+
+uniform sampler2D currentAO;
+uniform sampler2D historyAO;
+uniform sampler2D gDepth;           // 线性深度，0 表示天空
+uniform sampler2D uMotion;
+uniform sampler2D uPrevDepth;
+uniform int resolutionDivisor;
+uniform bool historyValid;
+uniform int maxHistory;             // 累积帧数上限，决定最小混合权重
+uniform float depthTolerance;
+uniform mat4 invProjection;
+uniform mat4 invView;
+uniform mat4 prevViewProj;
+
+// 由线性深度（视空间-z）重建世界空间位置；主光线的亚像素抖动不保存，按像素中心重建
+vec3 reconstructPosition(vec2 uv, float depth) {
+    vec4 viewRay = invProjection * vec4(uv * 2.0 - 1.0, 1.0, 1.0);
+    vec3 viewPos = viewRay.xyz / viewRay.w;
+    return (invView * vec4(viewPos * (depth / -viewPos.z), 1.0)).xyz;
+}
+
+void main() {
+    ivec2 aoPixel = ivec2(gl_FragCoord.xy);
+    ivec2 gPixel = aoPixel * resolutionDivisor;
+    float current = texelFetch(currentAO, aoPixel, 0).r;
+
+    float depth = texelFetch(gDepth, gPixel, 0).r;
+    if(!historyValid || depth <= 0.0) {
+        FragColor = vec2(current, 1.0);
+        return;
+    }
+
+    vec2 uv = (vec2(gPixel) + 0.5) / vec2(textureSize(gDepth, 0));
+    vec2 prevUV = uv + texelFetch(uMotion, gPixel, 0).xy;
+    bool offscreen = any(lessThan(prevUV, vec2(0.0))) || any(greaterThan(prevUV, vec2(1.0)));
+    // 当前点在上一帧的线性深度（clip.w）与上一帧G-Buffer比较
+    float expectedDepth = (prevViewProj * vec4(reconstructPosition(uv, depth), 1.0)).w;
+    float prevDepth = texture(uPrevDepth, prevUV).r;
+    if(offscreen || prevDepth <= 0.0 || abs(prevDepth - expectedDepth) > depthTolerance * expectedDepth) {
+        FragColor = vec2(current, 1.0);
+        return;
+    }
+
+    vec2 history = texture(historyAO, prevUV).rg;
+    float count = min(history.g + 1.0, float(maxHistory));
+    FragColor = vec2(mix(history.r, current, 1.0 / count), count);
+}
@@ -0,0 +1,53 @@
+#version 430 core
+// 共享内存可分离高斯模糊：每个工作组把输出tile及其apron一次性读入共享内存，
+// 水平和垂直两趟都在共享内存中完成，每个像素只读写显存一次
+#define TILE_SIZE 16
+#define RADIUS 4
+#define APRON_SIZE (TILE_SIZE + 2 * RADIUS)
+
+layout(local_size_x = TILE_SIZE, local_size_y = TILE_SIZE) in;
+layout(binding = 7) writeonly uniform image2D outputImage; // 格式由glBindImageTexture决定
+
+uniform sampler2D inputImage;
+
+// 与gaussian_blurFs.glsl相同的9-tap高斯核
+const float weight[RADIUS + 1] = float[] (0.227027, 0.1945946, 0.1216216, 0.054054, 0.016216);
+
+shared vec4 inputTile[APRON_SIZE][APRON_SIZE];
+shared vec4 horizontalTile[APRON_SIZE][TILE_SIZE]; // 水平模糊结果（保留上下apron行）
+
+void main() {
+    ivec2 size = textureSize(inputImage, 0);
+    ivec2 tileOrigin = ivec2(gl_WorkGroupID.xy) * TILE_SIZE - RADIUS;
+    int tid = int(gl_LocalInvocationIndex);
+
+    // 读取tile和apron（边界处钳制）
+    for(int i = tid; i < APRON_SIZE * APRON_SIZE; i += TILE_SIZE * TILE_SIZE) {
+        ivec2 local = ivec2(i % APRON_SIZE, i / APRON_SIZE);
+        ivec2 coord = clamp(tileOrigin + local, ivec2(0), size - 1);
+        inputTile[local.y][local.x] = texelFetch(inputImage, coord, 0);
+    }
+    barrier();
+
+    // 水平：每个线程处理apron范围内的若干行
+    for(int i = tid; i < APRON_SIZE * TILE_SIZE; i += TILE_SIZE * TILE_SIZE) {
+        int x = i % TILE_SIZE, y = i / TILE_SIZE;
+        vec4 result = inputTile[y][x + RADIUS] * weight[0];
+        for(int k = 1; k <= RADIUS; ++k) {
+            result += (inputTile[y][x + RADIUS + k] + inputTile[y][x + RADIUS - k]) * weight[k];
+        }
+        horizontalTile[y][x] = result;
+    }
+    barrier();
+
+    // 垂直
+    ivec2 local = ivec2(gl_LocalInvocationID.xy);
+    ivec2 pixel = ivec2(gl_GlobalInvocationID.xy);
+    if(any(greaterThanEqual(pixel, size))) return;
+
+    vec4 result = horizontalTile[local.y + RADIUS][local.x] * weight[0];
+    for(int k = 1; k <= RADIUS; ++k) {
+        result += (horizontalTile[local.y + RADIUS + k][local.x] + horizontalTile[local.y + RADIUS - k][local.x]) * weight[k];
+    }
+    imageStore(outputImage, pixel, result);
+}
\ No newline at end of file
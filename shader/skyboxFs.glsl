@@ -3,7 +3,7 @@ in vec3 localPos;
 out vec4 FragColor;
 uniform sampler2D equirectangularMap;
 
-const vec2 invAtan = vec2(0.1591, 0.3183); // 1/(2)  1/
+const vec2 invAtan = vec2(0.1591, 0.3183); // 1/(2π) 和 1/π
 
 vec2 SampleSphericalMap(vec3 v) {
     vec2 uv = vec2(atan(v.z, v.x), asin(v.y));
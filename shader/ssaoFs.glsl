@@ -1,48 +1,81 @@
 #version 430 core
+#define MAX_KERNEL_SIZE 64
 out float FragColor;
-in vec2 TexCoords;
 
-uniform sampler2D gPosition;
-uniform sampler2D gNormal;
-uniform sampler2D texNoise;
+uniform sampler2D gDepth;       // 线性深度（视空间-z），0 表示天空
+uniform sampler2D gNormal;      // 八面体编码的世界空间法线
+uniform sampler2D texNoise;     // 4x4随机旋转，按像素平铺
 
-uniform vec3 samples[64];
+// 采样核只在采样数变化时上传
+layout(std140, binding = 0) uniform SSAOKernel {
+    vec4 samples[MAX_KERNEL_SIZE];
+};
+uniform int kernelSize;
+uniform float radius;
+uniform float bias;
+uniform int resolutionDivisor;  // AO缓冲相对G-Buffer的缩小倍数
 uniform mat4 projection;
+uniform mat4 invProjection;
 uniform mat4 view;
 
-// Ļߴ
-const vec2 noiseScale = vec2(800.0/4.0, 800.0/4.0); // ʵʷֱʵ
+vec2 signNotZero(vec2 v) {
+    return vec2(v.x >= 0.0 ? 1.0 : -1.0, v.y >= 0.0 ? 1.0 : -1.0);
+}
+
+vec3 octDecode(vec2 e) {
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    if(n.z < 0.0) n.xy = (1.0 - abs(n.yx)) * signNotZero(n.xy);
+    return normalize(n);
+}
+
+// 由线性深度重建视空间位置
+vec3 reconstructViewPosition(vec2 uv, float depth) {
+    vec4 viewRay = invProjection * vec4(uv * 2.0 - 1.0, 1.0, 1.0);
+    vec3 viewPos = viewRay.xyz / viewRay.w;
+    return viewPos * (depth / -viewPos.z);
+}
 
 void main() {
-    // ȡ
-    vec3 fragPos = texture(gPosition, TexCoords).xyz;
-    vec3 normal = normalize(texture(gNormal, TexCoords).rgb);
-    vec3 randomVec = normalize(texture(texNoise, TexCoords * noiseScale).xyz);
-    
-    // TBN
+    // 低分辨率像素对应G-Buffer中的左上角像素（与上采样时一致）
+    ivec2 aoPixel = ivec2(gl_FragCoord.xy);
+    ivec2 gPixel = aoPixel * resolutionDivisor;
+    float depth = texelFetch(gDepth, gPixel, 0).r;
+    if(depth <= 0.0) {
+        FragColor = 1.0;
+        return;
+    }
+
+    // 在视空间计算：采样点深度直接与G-Buffer中的线性深度比较
+    vec2 uv = (vec2(gPixel) + 0.5) / vec2(textureSize(gDepth, 0));
+    vec3 fragPos = reconstructViewPosition(uv, depth);
+    vec3 normal = normalize(mat3(view) * octDecode(texelFetch(gNormal, gPixel, 0).rg));
+    vec3 randomVec = normalize(texelFetch(texNoise, aoPixel & 3, 0).xyz);
+    float fragDepth = fragPos.z;
+
+    // 创建TBN矩阵
     vec3 tangent = normalize(randomVec - normal * dot(randomVec, normal));
     vec3 bitangent = cross(normal, tangent);
     mat3 TBN = mat3(tangent, bitangent, normal);
-    
-    // 㻷ڱ
+
+    // 计算环境遮蔽（视空间深度比较，相机看向-z）
     float occlusion = 0.0;
-    for(int i = 0; i < 64; ++i) {
-        // ȡλ
-        vec3 samplePos = TBN * samples[i];
-        samplePos = fragPos + samplePos * 0.5; // 뾶
-        
-        // ͶӰĻռ
-        vec4 offset = vec4(samplePos, 1.0);
-        offset = projection * view * offset;
+    for(int i = 0; i < kernelSize; ++i) {
+        vec3 samplePos = fragPos + TBN * samples[i].xyz * radius;
+        float sampleDepth = samplePos.z;
+
+        // 投影到屏幕空间
+        vec4 offset = projection * vec4(samplePos, 1.0);
         offset.xy /= offset.w;
         offset.xy = offset.xy * 0.5 + 0.5;
-        
-        // ȡ
-        float sampleDepth = texture(gPosition, offset.xy).z;
-        
-        // Χ+ۻ
-        float rangeCheck = smoothstep(0.0, 1.0, 0.5 / abs(fragPos.z - sampleDepth));
-        occlusion += (sampleDepth >= samplePos.z + 0.025 ? 1.0 : 0.0) * rangeCheck;
+        if(any(lessThan(offset.xy, vec2(0.0))) || any(greaterThan(offset.xy, vec2(1.0)))) continue;
+
+        float sceneLinearDepth = texture(gDepth, offset.xy).r;
+        if(sceneLinearDepth <= 0.0) continue;
+        float sceneDepth = -sceneLinearDepth;
+
+        // 范围检查+累积
+        float rangeCheck = smoothstep(0.0, 1.0, radius / abs(fragDepth - sceneDepth));
+        occlusion += (sceneDepth >= sampleDepth + bias ? 1.0 : 0.0) * rangeCheck;
     }
-    FragColor = 1.0 - (occlusion / 64.0);
-}
\ No newline at end of file
+    FragColor = 1.0 - (occlusion / float(kernelSize));
+}
@@ -0,0 +1,60 @@
+#version 430 core
+// 低分辨率AO的联合双边上采样：双线性权重乘以深度和法线相似度，避免AO越过几何边缘
+out float FragColor;
+
+uniform sampler2D aoLowRes;
+uniform sampler2D gDepth;       // 线性深度，0 表示天空
+uniform sampler2D gNormal;      // 八面体编码
+uniform int resolutionDivisor;
+
+vec2 signNotZero(vec2 v) {
+    return vec2(v.x >= 0.0 ? 1.0 : -1.0, v.y >= 0.0 ? 1.0 : -1.0);
+}
+
+vec3 octDecode(vec2 e) {
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    if(n.z < 0.0) n.xy = (1.0 - abs(n.yx)) * signNotZero(n.xy);
+    return normalize(n);
+}
+
+void main() {
+    ivec2 pixel = ivec2(gl_FragCoord.xy);
+    float depth = texelFetch(gDepth, pixel, 0).r;
+    if(depth <= 0.0) {
+        FragColor = 1.0;
+        return;
+    }
+    vec3 normal = octDecode(texelFetch(gNormal, pixel, 0).rg);
+
+    // 低分辨率像素i对应G-Buffer像素i * resolutionDivisor
+    ivec2 lowSize = textureSize(aoLowRes, 0);
+    vec2 lowCoord = vec2(pixel) / float(resolutionDivisor);
+    ivec2 base = ivec2(floor(lowCoord));
+    vec2 f = lowCoord - vec2(base);
+
+    float sum = 0.0, weightSum = 0.0;
+    float nearestAO = 1.0, nearestDiff = 1e30;
+    for(int y = 0; y <= 1; ++y) {
+        for(int x = 0; x <= 1; ++x) {
+            ivec2 lowPixel = min(base + ivec2(x, y), lowSize - 1);
+            ivec2 gPixel = lowPixel * resolutionDivisor;
+            float sampleDepth = texelFetch(gDepth, gPixel, 0).r;
+            float ao = texelFetch(aoLowRes, lowPixel, 0).r;
+
+            float bilinear = (x == 1 ? f.x : 1.0 - f.x) * (y == 1 ? f.y : 1.0 - f.y);
+            float depthDiff = abs(sampleDepth - depth);
+            float depthWeight = sampleDepth <= 0.0 ? 0.0 : 1.0 / (1e-3 + depthDiff / max(depth, 1e-3) * 100.0);
+            float normalWeight = pow(max(dot(normal, octDecode(texelFetch(gNormal, gPixel, 0).rg)), 0.0), 8.0);
+            float weight = bilinear * depthWeight * normalWeight;
+
+            sum += ao * weight;
+            weightSum += weight;
+            if(sampleDepth > 0.0 && depthDiff < nearestDiff) {
+                nearestDiff = depthDiff;
+                nearestAO = ao;
+            }
+        }
+    }
+    // 所有样本都不匹配时退回深度最接近的样本
+    FragColor = weightSum > 1e-4 ? sum / weightSum : nearestAO;
+}
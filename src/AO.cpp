@@ -1,20 +1,25 @@
 // AO.cpp
 #include "AO.h"
 #include <random>
+#include <algorithm>
 #include <iostream>
 #include <imgui.h>
 #include "global.h"
+#include "GPUMemoryTracker.h"
 
 AOManager::AOManager(int width, int height)
     : screenWidth(width), screenHeight(height) {
 }
 
 AOManager::~AOManager() {
-    glDeleteTextures(1, &ssaoColorBuffer);
-    glDeleteTextures(1, &ssaoBlurBuffer);
+    gpuMemory.DeleteTextures(1, &ssaoColorBuffer);
+    gpuMemory.DeleteTextures(1, &ssaoBlurBuffer);
     glDeleteFramebuffers(1, &ssaoFBO);
-    glDeleteFramebuffers(1, &ssaoBlurFBO);
-    glDeleteTextures(1, &noiseTexture);
+    glDeleteFramebuffers(1, &aoFBO);
+    gpuMemory.DeleteTextures(2, rtaoHistory);
+    glDeleteFramebuffers(1, &rtaoFBO);
+    gpuMemory.DeleteTextures(1, &noiseTexture);
+    gpuMemory.DeleteBuffers(1, &kernelUBO);
 }
 
 void AOManager::Init() {
@@ -24,19 +29,6 @@ void AOManager::Init() {
 void AOManager::InitSSAO() {
     std::uniform_real_distribution<float> randomFloats(0.0, 1.0);
     std::default_random_engine generator;
-    for (unsigned int i = 0; i < 64; ++i) {
-        glm::vec3 sample(
-            randomFloats(generator) * 2.0 - 1.0,
-            randomFloats(generator) * 2.0 - 1.0,
-            randomFloats(generator)
-        );
-        sample = glm::normalize(sample);
-        sample *= randomFloats(generator);
-        float scale = (float)i / 64.0f;
-        scale = 0.1f + (scale * scale) * 0.9f;
-        sample *= scale;
-        ssaoKernel.push_back(sample);
-    }
 
     std::vector<glm::vec3> ssaoNoise;
     for (unsigned int i = 0; i < 16; i++) {
@@ -50,65 +42,215 @@ void AOManager::InitSSAO() {
     glGenTextures(1, &noiseTexture);
     glBindTexture(GL_TEXTURE_2D, noiseTexture);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA32F, 4, 4, 0, GL_RGB, GL_FLOAT, &ssaoNoise[0]);
+    gpuMemory.TrackTexture(noiseTexture, "AO", "SSAO noise", GL_RGBA32F, 4, 4);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
 
+    // 采样核放在UBO中（binding = 0），std140下每个元素按vec4对齐
+    glGenBuffers(1, &kernelUBO);
+    glBindBuffer(GL_UNIFORM_BUFFER, kernelUBO);
+    glBufferData(GL_UNIFORM_BUFFER, MAX_KERNEL_SIZE * sizeof(glm::vec4), nullptr, GL_STATIC_DRAW);
+    gpuMemory.TrackBuffer(kernelUBO, "AO", "SSAO kernel", MAX_KERNEL_SIZE * sizeof(glm::vec4));
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    UpdateKernel();
+
     glGenFramebuffers(1, &ssaoFBO);
-    glGenFramebuffers(1, &ssaoBlurFBO);
+    glGenFramebuffers(1, &aoFBO);
+    glGenFramebuffers(1, &rtaoFBO);
+    CreateTargets();
 
+    ssaoShader = Shader("shader/outputVs.glsl", "shader/ssaoFs.glsl");
+    upsampleShader = Shader("shader/outputVs.glsl", "shader/ssao_upsampleFs.glsl");
+    accumulateShader = Shader("shader/outputVs.glsl", "shader/rtao_accumulateFs.glsl");
+    ssaoBlur.Init();
+}
+
+void AOManager::UpdateKernel() {
+    const std::vector<glm::vec4> kernel = GenerateSSAOKernel(kernelSize);
+    glBindBuffer(GL_UNIFORM_BUFFER, kernelUBO);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, kernel.size() * sizeof(glm::vec4), kernel.data());
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    uploadedKernelSize = kernelSize;
+}
+
+void AOManager::CreateTargets() {
+    gpuMemory.DeleteTextures(1, &ssaoColorBuffer);
+    gpuMemory.DeleteTextures(1, &ssaoBlurBuffer);
+    gpuMemory.DeleteTextures(2, rtaoHistory);
+
+    aoWidth = std::max(screenWidth / resolutionDivisor, 1);
+    aoHeight = std::max(screenHeight / resolutionDivisor, 1);
+
+    // compute模糊需要sized格式（图像单元写入）
     glGenTextures(1, &ssaoColorBuffer);
     glBindTexture(GL_TEXTURE_2D, ssaoColorBuffer);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, screenWidth, screenHeight, 0, GL_RGB, GL_FLOAT, NULL);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R16F, aoWidth, aoHeight, 0, GL_RED, GL_FLOAT, NULL);
+    gpuMemory.TrackTexture(ssaoColorBuffer, "AO", "SSAO", GL_R16F, aoWidth, aoHeight);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
 
     glGenTextures(1, &ssaoBlurBuffer);
     glBindTexture(GL_TEXTURE_2D, ssaoBlurBuffer);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, screenWidth, screenHeight, 0, GL_RGB, GL_FLOAT, NULL);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R16F, aoWidth, aoHeight, 0, GL_RED, GL_FLOAT, NULL);
+    gpuMemory.TrackTexture(ssaoBlurBuffer, "AO", "SSAO blur", GL_R16F, aoWidth, aoHeight);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 
-    ssaoShader = Shader("shader/outputVs.glsl", "shader/ssaoFs.glsl");
-    ssaoBlurShader = Shader("shader/outputVs.glsl", "shader/ssao_blurFs.glsl");
-}
+    glBindFramebuffer(GL_FRAMEBUFFER, ssaoFBO);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, ssaoColorBuffer, 0);
 
-void AOManager::Render(GLuint positionTex, GLuint normalTex, const glm::mat4& view, const glm::mat4& projection) {
-    if (enableAO) {
-        RenderSSAO(positionTex, normalTex, view, projection);
+    // RTAO历史（低分辨率，双缓冲）
+    glGenTextures(2, rtaoHistory);
+    for (int i = 0; i < 2; i++) {
+        glBindTexture(GL_TEXTURE_2D, rtaoHistory[i]);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RG16F, aoWidth, aoHeight, 0, GL_RG, GL_FLOAT, NULL);
+        gpuMemory.TrackTexture(rtaoHistory[i], "AO", "RTAO history " + std::to_string(i), GL_RG16F, aoWidth, aoHeight);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
     }
+    rtaoHistoryValid = false;
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
 }
 
-void AOManager::RenderSSAO(GLuint positionTex, GLuint normalTex, const glm::mat4& view, const glm::mat4& projection) {
+void AOManager::Render(GLuint depthTex, GLuint normalTex, GLuint motionTex, GLuint prevDepthTex,
+    const glm::mat4& view, const glm::mat4& projection, const glm::mat4& prevViewProj, Shader& raytracingShader, GLuint targetTex) {
+    if (!enableAO || mode != Mode::RTAO) rtaoHistoryValid = false;
+    if (!enableAO) return;
+    if (kernelSize != uploadedKernelSize) UpdateKernel();
+
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+
+    if (mode == Mode::SSAO) RenderSSAO(depthTex, normalTex, view, projection);
+    else RenderRTAO(depthTex, motionTex, prevDepthTex, view, projection, prevViewProj, raytracingShader);
+    Upsample(depthTex, normalTex, targetTex);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+}
+
+void AOManager::RenderSSAO(GLuint depthTex, GLuint normalTex, const glm::mat4& view, const glm::mat4& projection) {
     glBindFramebuffer(GL_FRAMEBUFFER, ssaoFBO);
+    glViewport(0, 0, aoWidth, aoHeight);
     glClear(GL_COLOR_BUFFER_BIT);
 
     ssaoShader.use();
-    for (unsigned int i = 0; i < 64; ++i)
-        ssaoShader.setVec3("samples[" + std::to_string(i) + "]", ssaoKernel[i]);
+    glBindBufferBase(GL_UNIFORM_BUFFER, 0, kernelUBO);
+    ssaoShader.setInt("kernelSize", kernelSize);
+    ssaoShader.setFloat("radius", radius);
+    ssaoShader.setFloat("bias", bias);
+    ssaoShader.setInt("resolutionDivisor", resolutionDivisor);
     ssaoShader.setMat4("projection", projection);
+    ssaoShader.setMat4("invProjection", glm::inverse(projection));
     ssaoShader.setMat4("view", view);
-    ssaoShader.setInt("gPosition", 0);
+    ssaoShader.setInt("gDepth", 0);
     ssaoShader.setInt("gNormal", 1);
     ssaoShader.setInt("texNoise", 2);
 
     glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, positionTex);
+    glBindTexture(GL_TEXTURE_2D, depthTex);
     glActiveTexture(GL_TEXTURE1);
     glBindTexture(GL_TEXTURE_2D, normalTex);
     glActiveTexture(GL_TEXTURE2);
     glBindTexture(GL_TEXTURE_2D, noiseTexture);
 
     RenderQuad();
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
 
-    glBindFramebuffer(GL_FRAMEBUFFER, ssaoBlurFBO);
-    glClear(GL_COLOR_BUFFER_BIT);
-    ssaoBlurShader.use();
+    // 共享内存compute模糊（水平+垂直一次完成），在低分辨率下进行
+    ssaoBlur.Blur(ssaoColorBuffer, ssaoBlurBuffer, GL_R16F, aoWidth, aoHeight);
+}
+
+void AOManager::RenderRTAO(GLuint depthTex, GLuint motionTex, GLuint prevDepthTex, const glm::mat4& view, const glm::mat4& projection,
+    const glm::mat4& prevViewProj, Shader& raytracingShader) {
+    // 步骤1: 遮挡光线（复用光追着色器的场景数据和求交），结果写入ssaoColorBuffer
+    raytracingShader.use();
+    raytracingShader.setBool("rtaoPass", true);
+    raytracingShader.setInt("rtaoRays", rtaoRays);
+    raytracingShader.setFloat("rtaoRadius", rtaoRadius);
+    raytracingShader.setInt("rtaoDivisor", resolutionDivisor);
+    glBindImageTexture(5, ssaoColorBuffer, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_R16F);
+    glDispatchCompute((aoWidth + 31) / 32, (aoHeight + 31) / 32, 1);
+    glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+    raytracingShader.setBool("rtaoPass", false);
+
+    // 步骤2: 时域累积
+    const int previous = rtaoCurrent;
+    rtaoCurrent = 1 - rtaoCurrent;
+    glBindFramebuffer(GL_FRAMEBUFFER, rtaoFBO);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, rtaoHistory[rtaoCurrent], 0);
+    glViewport(0, 0, aoWidth, aoHeight);
+
+    accumulateShader.use();
+    accumulateShader.setInt("currentAO", 0);
+    accumulateShader.setInt("historyAO", 1);
+    accumulateShader.setInt("gDepth", 2);
+    accumulateShader.setInt("uMotion", 3);
+    accumulateShader.setInt("uPrevDepth", 4);
+    accumulateShader.setInt("resolutionDivisor", resolutionDivisor);
+    accumulateShader.setBool("historyValid", rtaoHistoryValid);
+    accumulateShader.setInt("maxHistory", rtaoMaxHistory);
+    accumulateShader.setFloat("depthTolerance", 0.05f);
+    accumulateShader.setMat4("invProjection", glm::inverse(projection));
+    accumulateShader.setMat4("invView", glm::inverse(view));
+    accumulateShader.setMat4("prevViewProj", prevViewProj);
     glActiveTexture(GL_TEXTURE0);
     glBindTexture(GL_TEXTURE_2D, ssaoColorBuffer);
-    glDrawArrays(GL_TRIANGLES, 0, 6);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, rtaoHistory[previous]);
+    glActiveTexture(GL_TEXTURE2);
+    glBindTexture(GL_TEXTURE_2D, depthTex);
+    glActiveTexture(GL_TEXTURE3);
+    glBindTexture(GL_TEXTURE_2D, motionTex);
+    glActiveTexture(GL_TEXTURE4);
+    glBindTexture(GL_TEXTURE_2D, prevDepthTex);
+    glActiveTexture(GL_TEXTURE0);
+    RenderQuad();
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    rtaoHistoryValid = true;
+
+    // 步骤3: 与SSAO共用的compute模糊降噪
+    ssaoBlur.Blur(rtaoHistory[rtaoCurrent], ssaoBlurBuffer, GL_R16F, aoWidth, aoHeight);
+}
+
+void AOManager::RecordTiming(double gpuMs) {
+    if (!enableAO || gpuMs <= 0.0) return;
+    double& ms = modeMs[static_cast<int>(mode)];
+    ms = ms == 0.0 ? gpuMs : ms * 0.9 + gpuMs * 0.1;
+}
+
+void AOManager::SetResolutionDivisor(int divisor) {
+    if (divisor == resolutionDivisor) return;
+    resolutionDivisor = divisor;
+    CreateTargets();
+}
+
+void AOManager::Upsample(GLuint depthTex, GLuint normalTex, GLuint targetTex) {
+    glBindFramebuffer(GL_FRAMEBUFFER, aoFBO);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, targetTex, 0);
+    glViewport(0, 0, screenWidth, screenHeight);
+
+    upsampleShader.use();
+    upsampleShader.setInt("aoLowRes", 0);
+    upsampleShader.setInt("gDepth", 1);
+    upsampleShader.setInt("gNormal", 2);
+    upsampleShader.setInt("resolutionDivisor", resolutionDivisor);
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, ssaoBlurBuffer);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, depthTex);
+    glActiveTexture(GL_TEXTURE2);
+    glBindTexture(GL_TEXTURE_2D, normalTex);
+    glActiveTexture(GL_TEXTURE0);
+
+    RenderQuad();
 }
 
 void AOManager::DrawUI() {
@@ -117,17 +259,39 @@ void AOManager::DrawUI() {
     ImGui::Begin("AO Settings", &showSettings);
     ImGui::Checkbox("Enable AO", &enableAO);
     ImGui::SliderFloat("AO Strength", &aoStrength, 0.0f, 2.0f);
-    aoStrength *= enableAO;
+
+    int modeIndex = static_cast<int>(mode);
+    const char* modes[] = { "SSAO", "Ray Traced" };
+    if (ImGui::Combo("Mode", &modeIndex, modes, IM_ARRAYSIZE(modes))) {
+        mode = static_cast<Mode>(modeIndex);
+    }
+
+    int resolutionIndex = resolutionDivisor == 1 ? 0 : (resolutionDivisor == 2 ? 1 : 2);
+    const char* resolutions[] = { "Full", "Half", "Quarter" };
+    if (ImGui::Combo("Resolution", &resolutionIndex, resolutions, IM_ARRAYSIZE(resolutions))) {
+        SetResolutionDivisor(1 << resolutionIndex);
+    }
+    if (mode == Mode::SSAO) {
+        ImGui::SliderInt("Samples", &kernelSize, 4, MAX_KERNEL_SIZE);
+        ImGui::SliderFloat("Radius", &radius, 0.05f, 2.0f);
+        ImGui::SliderFloat("Bias", &bias, 0.0f, 0.1f);
+        ImGui::Text("AO buffer: %dx%d, %d samples/pixel", aoWidth, aoHeight, kernelSize);
+    }
+    else {
+        ImGui::SliderInt("Rays Per Pixel", &rtaoRays, 1, 4);
+        ImGui::SliderFloat("Ray Length", &rtaoRadius, 0.05f, 2.0f);
+        ImGui::SliderInt("Max History", &rtaoMaxHistory, 1, 64);
+        ImGui::Text("AO buffer: %dx%d, %d rays/pixel", aoWidth, aoHeight, rtaoRays);
+    }
+
+    // 两种模式各自最近一次测得的GPU耗时（切换模式后更新）
+    ImGui::Separator();
+    ImGui::Text("GPU time  SSAO: %.3f ms  RTAO: %.3f ms", modeMs[0], modeMs[1]);
     ImGui::End();
 }
 
 void AOManager::Resize(int width, int height) {
     screenWidth = width;
     screenHeight = height;
-
-    glBindTexture(GL_TEXTURE_2D, ssaoColorBuffer);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, width, height, 0, GL_RGB, GL_FLOAT, NULL);
-
-    glBindTexture(GL_TEXTURE_2D, ssaoBlurBuffer);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, width, height, 0, GL_RGB, GL_FLOAT, NULL);
-}
\ No newline at end of file
+    CreateTargets();
+}
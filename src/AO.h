@@ -2,33 +2,78 @@
 #pragma once
 #include <glm/glm.hpp>
 #include "Shader.h"
+#include "SeparableBlur.h"
 #include <vector>
 
 class AOManager {
 public:
+    enum class Mode {
+        SSAO,   // 屏幕空间，基于G-Buffer
+        RTAO    // 光追短距离遮挡光线 + 时域累积
+    };
+
+    static constexpr int MAX_KERNEL_SIZE = 64;  // 需与ssaoFs.glsl一致
+
     AOManager(int width, int height);
     ~AOManager();
 
     void Init();
     void Resize(int width, int height);
-    void Render(GLuint positionTex, GLuint normalTex, const glm::mat4& view, const glm::mat4& projection);
+    // 低分辨率AO -> 模糊 -> 深度/法线感知上采样到全分辨率
+    // G-Buffer为线性深度 + 八面体法线；RTAO需要运动向量、上一帧深度和视图投影矩阵（时域累积）以及光追着色器，
+    // G-Buffer须以可读方式绑定在图像单元1/2。结果写入targetTex（全分辨率R8，由渲染图分配）
+    void Render(GLuint depthTex, GLuint normalTex, GLuint motionTex, GLuint prevDepthTex,
+        const glm::mat4& view, const glm::mat4& projection, const glm::mat4& prevViewProj, Shader& raytracingShader, GLuint targetTex);
+    // 记录本帧AO阶段的GPU耗时，用于两种模式的对比
+    void RecordTiming(double gpuMs);
+    // 修改分辨率并重建AO缓冲（帧回放时使用）
+    void SetResolutionDivisor(int divisor);
     void DrawUI();
 
-    // 
+    // 参数
     int screenWidth, screenHeight;
     bool enableAO = true;
+    Mode mode = Mode::SSAO;
     float aoStrength = 1.0f;
+    int resolutionDivisor = 2;      // 1 = 全分辨率，2 = 半分辨率，4 = 四分之一
+    int kernelSize = 16;
+    float radius = 0.5f;
+    float bias = 0.025f;
+    int rtaoRays = 1;               // 每像素遮挡光线数
+    float rtaoRadius = 0.5f;
+    int rtaoMaxHistory = 16;
     bool showSettings = true;
 
 private:
     void InitSSAO();
-    void RenderSSAO(GLuint positionTex, GLuint normalTex, const glm::mat4& view, const glm::mat4& projection);
+    void CreateTargets();
+    void UpdateKernel();
+    void RenderSSAO(GLuint depthTex, GLuint normalTex, const glm::mat4& view, const glm::mat4& projection);
+    void RenderRTAO(GLuint depthTex, GLuint motionTex, GLuint prevDepthTex, const glm::mat4& view, const glm::mat4& projection,
+        const glm::mat4& prevViewProj, Shader& raytracingShader);
+    void Upsample(GLuint depthTex, GLuint normalTex, GLuint targetTex);
+
+    int aoWidth = 0, aoHeight = 0;
 
-    // SSAO
-    GLuint ssaoFBO, ssaoBlurFBO;
-    GLuint ssaoColorBuffer, ssaoBlurBuffer;
-    GLuint noiseTexture;
-    std::vector<glm::vec3> ssaoKernel;
+    // SSAO相关（低分辨率）
+    GLuint ssaoFBO = 0;
+    GLuint ssaoColorBuffer = 0, ssaoBlurBuffer = 0;
+    GLuint noiseTexture = 0;
+    GLuint kernelUBO = 0;          // 采样核，只在采样数变化时更新
+    int uploadedKernelSize = 0;
     Shader ssaoShader;
-    Shader ssaoBlurShader;
-};
\ No newline at end of file
+    SeparableBlur ssaoBlur;
+
+    // RTAO时域累积（RG16F：r = AO，g = 累积帧数）
+    GLuint rtaoHistory[2] = {}, rtaoFBO = 0;
+    int rtaoCurrent = 0;
+    bool rtaoHistoryValid = false;
+    Shader accumulateShader;
+
+    // 每种模式最近的GPU耗时（指数平滑）
+    double modeMs[2] = {};
+
+    // 双边上采样（全分辨率）
+    GLuint aoFBO = 0;
+    Shader upsampleShader;
+};
@@ -0,0 +1,421 @@
+// Benchmark.cpp
+#include "Benchmark.h"
+#include "PerformanceProfiler.h"
+#include "GPUMemoryTracker.h"
+#include "Json.h"
+#include <GL/glew.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+static void PrintUsage() {
+    std::cout <<
+        "Usage: opengl_rt [--benchmark] [options]\n"
+        "  --benchmark              run the scripted benchmark and write a JSON report\n"
+        "  --scene <file>           scene to load (default res/Scene/performance_test.scene)\n"
+        "  --camera-path <file>     camera path (default res/Benchmark/orbit.campath)\n"
+        "  --replay <file>          replay a frame capture instead of --scene/--camera-path (implies --benchmark)\n"
+        "  --warmup <N>             frames rendered before recording (default 60)\n"
+        "  --frames <M>             frames recorded (default 300)\n"
+        "  --render-scale <s>       fixed render resolution scale, 0.5-1.0 (default 1.0)\n"
+        "  --output <file>          report path (default benchmark_result.json)\n"
+        "  --baseline <file>        compare the report against a stored baseline\n"
+        "  --compare <file>         compare an existing report against --baseline without rendering\n"
+        "  --metric <name>          p50, p95, p99 or mean (default p50)\n"
+        "  --threshold <percent>    regression threshold relative to the baseline (default 10)\n"
+        "  --min-delta <ms>         ignore differences smaller than this (default 0.05)\n";
+}
+
+bool BenchmarkOptions::Parse(int argc, char** argv, BenchmarkOptions& options) {
+    static const char* valueOptions[] = {
+        "--scene", "--camera-path", "--replay", "--warmup", "--frames", "--render-scale", "--output",
+        "--baseline", "--compare", "--metric", "--threshold", "--min-delta"
+    };
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--benchmark") {
+            options.enabled = true;
+            continue;
+        }
+        if (std::find(std::begin(valueOptions), std::end(valueOptions), arg) == std::end(valueOptions)) {
+            if (arg != "--help") std::cerr << "Unknown option: " << arg << std::endl;
+            PrintUsage();
+            return false;
+        }
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << arg << std::endl;
+            PrintUsage();
+            return false;
+        }
+
+        const std::string value = argv[++i];
+        if (arg == "--scene") options.scenePath = value;
+        else if (arg == "--camera-path") options.cameraPath = value;
+        else if (arg == "--replay") {
+            options.replayPath = value;
+            options.enabled = true;
+        }
+        else if (arg == "--warmup") options.warmupFrames = std::max(std::atoi(value.c_str()), 0);
+        else if (arg == "--frames") {
+            options.frames = std::max(std::atoi(value.c_str()), 1);
+            options.framesSet = true;
+        }
+        else if (arg == "--render-scale") options.renderScale = static_cast<float>(std::atof(value.c_str()));
+        else if (arg == "--output") options.outputPath = value;
+        else if (arg == "--baseline") options.baselinePath = value;
+        else if (arg == "--compare") options.comparePath = value;
+        else if (arg == "--metric") options.metric = value;
+        else if (arg == "--threshold") options.thresholdPercent = static_cast<float>(std::atof(value.c_str()));
+        else if (arg == "--min-delta") options.minDeltaMs = static_cast<float>(std::atof(value.c_str()));
+    }
+
+    if (options.metric != "p50" && options.metric != "p95" && options.metric != "p99" && options.metric != "mean") {
+        std::cerr << "Unknown metric: " << options.metric << std::endl;
+        return false;
+    }
+    if (!options.comparePath.empty() && options.baselinePath.empty()) {
+        std::cerr << "--compare requires --baseline" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// 相机路径
+
+bool CameraPath::Load(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) return false;
+
+    m_Keys.clear();
+    std::string line;
+    while (std::getline(file, line)) {
+        std::istringstream iss(line);
+        std::string type;
+        iss >> type;
+        if (type != "KEY") continue;
+
+        Key key;
+        iss >> key.time >> key.position.x >> key.position.y >> key.position.z >> key.yaw >> key.pitch >> key.fov;
+        if (iss.fail()) return false;
+        m_Keys.push_back(key);
+    }
+    std::stable_sort(m_Keys.begin(), m_Keys.end(), [](const Key& a, const Key& b) { return a.time < b.time; });
+    return !m_Keys.empty();
+}
+
+void CameraPath::Apply(float time, Camera& camera) const {
+    if (m_Keys.empty()) return;
+
+    const float duration = GetDuration();
+    const float t = duration > 0.0f ? std::fmod(time, duration) : 0.0f;
+    const int last = static_cast<int>(m_Keys.size()) - 1;
+    int i = 0;
+    while (i < last - 1 && m_Keys[i + 1].time <= t) ++i;
+
+    const Key& k1 = m_Keys[i];
+    const Key& k2 = m_Keys[std::min(i + 1, last)];
+    const glm::vec3& p0 = m_Keys[std::max(i - 1, 0)].position;
+    const glm::vec3& p3 = m_Keys[std::min(i + 2, last)].position;
+    const float span = k2.time - k1.time;
+    const float u = span > 0.0f ? std::clamp((t - k1.time) / span, 0.0f, 1.0f) : 0.0f;
+
+    // Catmull-Rom，两端重复端点
+    const glm::vec3& p1 = k1.position;
+    const glm::vec3& p2 = k2.position;
+    camera.Position = 0.5f * (2.0f * p1 + (p2 - p0) * u + (2.0f * p0 - 5.0f * p1 + 4.0f * p2 - p3) * u * u
+        + (3.0f * p1 - p0 - 3.0f * p2 + p3) * u * u * u);
+    camera.Yaw = k1.yaw + (k2.yaw - k1.yaw) * u;
+    camera.Pitch = k1.pitch + (k2.pitch - k1.pitch) * u;
+    camera.FOV = k1.fov + (k2.fov - k1.fov) * u;
+    camera.UpdateVectors();
+}
+
+// ---------------------------------------------------------------------------
+// 记录
+
+void Benchmark::Fail(const std::string& message) {
+    std::cerr << "Benchmark: " << message << std::endl;
+    m_ExitCode = 2;
+}
+
+bool Benchmark::Init(int renderWidth, int renderHeight) {
+    // 回放时相机来自捕获文件
+    if (m_Options.replayPath.empty() && !m_Path.Load(m_Options.cameraPath)) {
+        Fail("failed to load camera path " + m_Options.cameraPath);
+        return false;
+    }
+
+    const GLubyte* renderer = glGetString(GL_RENDERER);
+    const GLubyte* version = glGetString(GL_VERSION);
+    m_Renderer = renderer ? reinterpret_cast<const char*>(renderer) : "unknown";
+    m_GLVersion = version ? reinterpret_cast<const char*>(version) : "unknown";
+    m_RenderWidth = renderWidth;
+    m_RenderHeight = renderHeight;
+    m_NextFrame = m_Options.warmupFrames;
+
+    std::cout << "Benchmark: " << m_Renderer << " (" << m_GLVersion << "), "
+        << m_Options.warmupFrames << " warmup + " << m_Options.frames << " frames at "
+        << renderWidth << "x" << renderHeight << std::endl;
+    return true;
+}
+
+void Benchmark::ApplyCamera(long long frameIndex, Camera& camera) const {
+    m_Path.Apply(static_cast<float>(frameIndex) / PATH_FPS, camera);
+}
+
+void Benchmark::Record(const PerformanceProfiler& profiler, long long frameIndex) {
+    const PerformanceProfiler::FrameStats& stats = *profiler.FindStats(frameIndex);
+    const std::vector<PerformanceProfiler::ScopeNode>& scopes = profiler.GetScopes();
+
+    m_Stages["Frame"].cpuMs.push_back(static_cast<float>(stats.cpuTime));
+    double gpuTotal = 0.0;
+    for (size_t i = 0; i < stats.scopes.size(); ++i) {
+        const PerformanceProfiler::ScopeTiming& timing = stats.scopes[i];
+        if (timing.calls == 0) continue;
+
+        // 同名作用域可能出现在不同父作用域下，用完整路径区分
+        std::string path = scopes[i].name;
+        for (int parent = scopes[i].parent; parent >= 0; parent = scopes[parent].parent) {
+            path = scopes[parent].name + "/" + path;
+        }
+        StageSamples& stage = m_Stages[path];
+        stage.gpu = scopes[i].gpu;
+        stage.cpuMs.push_back(static_cast<float>(timing.cpuMs));
+        if (stage.gpu) stage.gpuMs.push_back(static_cast<float>(timing.gpuMs));
+        if (scopes[i].parent < 0) gpuTotal += timing.gpuMs;
+    }
+
+    StageSamples& total = m_Stages["GPU Total"];
+    total.gpu = true;
+    total.gpuMs.push_back(static_cast<float>(gpuTotal));
+}
+
+bool Benchmark::Update(const PerformanceProfiler& profiler) {
+    const long long endFrame = static_cast<long long>(m_Options.warmupFrames) + m_Options.frames;
+    const PerformanceProfiler::FrameStats& latest = profiler.GetLatestStats();
+
+    // 按帧序收集；已经越过的帧找不到说明被profiler丢弃（GPU落后超过查询环深度）
+    while (m_NextFrame < endFrame) {
+        if (profiler.FindStats(m_NextFrame)) {
+            Record(profiler, m_NextFrame);
+            m_RecordedFrames++;
+        }
+        else if (latest.gpuDataValid && latest.frameIndex > m_NextFrame) {
+            m_DroppedFrames++;
+        }
+        else {
+            break;
+        }
+        m_NextFrame++;
+    }
+
+    if (m_NextFrame < endFrame) {
+        // 驱动一直不返回时间戳结果时不要无限运行
+        if (profiler.GetFrameIndex() > endFrame + 120) {
+            Fail("timed out waiting for GPU timer results");
+            return true;
+        }
+        return false;
+    }
+
+    if (m_RecordedFrames == 0) {
+        Fail("no frames recorded");
+        return true;
+    }
+    if (!WriteReport()) {
+        Fail("failed to write " + m_Options.outputPath);
+        return true;
+    }
+    std::cout << "Benchmark: " << m_RecordedFrames << " frames recorded (" << m_DroppedFrames
+        << " dropped), report written to " << m_Options.outputPath << std::endl;
+
+    if (!m_Options.baselinePath.empty()) m_ExitCode = Compare(m_Options.outputPath, m_Options.baselinePath, m_Options);
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// 报告
+
+struct Summary {
+    double mean = 0.0, p50 = 0.0, p95 = 0.0, p99 = 0.0, min = 0.0, max = 0.0;
+};
+
+// 精确分位数（最近秩），样本只有几百个，直接排序
+static Summary Summarize(std::vector<float> values) {
+    Summary s;
+    if (values.empty()) return s;
+    std::sort(values.begin(), values.end());
+    auto percentile = [&](double p) {
+        const size_t rank = static_cast<size_t>(std::ceil(p * values.size()));
+        return static_cast<double>(values[std::clamp<size_t>(rank, 1, values.size()) - 1]);
+    };
+    double sum = 0.0;
+    for (float v : values) sum += v;
+    s.mean = sum / values.size();
+    s.p50 = percentile(0.50);
+    s.p95 = percentile(0.95);
+    s.p99 = percentile(0.99);
+    s.min = values.front();
+    s.max = values.back();
+    return s;
+}
+
+static void WriteSummary(std::ofstream& file, const char* name, const std::vector<float>& values) {
+    const Summary s = Summarize(values);
+    file << "\"" << name << "\": {\"mean\": " << s.mean << ", \"p50\": " << s.p50 << ", \"p95\": " << s.p95
+        << ", \"p99\": " << s.p99 << ", \"min\": " << s.min << ", \"max\": " << s.max << "}";
+}
+
+bool Benchmark::WriteReport() const {
+    std::ofstream file(m_Options.outputPath);
+    if (!file.is_open()) return false;
+
+    file << std::fixed << std::setprecision(4);
+    file << "{\n";
+    file << "  \"version\": 1,\n";
+    if (!m_Options.replayPath.empty()) {
+        file << "  \"replay\": \"" << JsonEscape(m_Options.replayPath) << "\",\n";
+    }
+    else {
+        file << "  \"scene\": \"" << JsonEscape(m_Options.scenePath) << "\",\n";
+        file << "  \"cameraPath\": \"" << JsonEscape(m_Options.cameraPath) << "\",\n";
+    }
+    file << "  \"renderer\": \"" << JsonEscape(m_Renderer) << "\",\n";
+    file << "  \"glVersion\": \"" << JsonEscape(m_GLVersion) << "\",\n";
+    file << "  \"renderSize\": [" << m_RenderWidth << ", " << m_RenderHeight << "],\n";
+    file << "  \"warmupFrames\": " << m_Options.warmupFrames << ",\n";
+    file << "  \"recordedFrames\": " << m_RecordedFrames << ",\n";
+    file << "  \"droppedFrames\": " << m_DroppedFrames << ",\n";
+
+    // 显存：报告写出时的总量、运行期间的峰值和各模块占用（字节）
+    file << "  \"gpuMemory\": {\"totalBytes\": " << gpuMemory.GetTotalBytes() << ", \"peakBytes\": " << gpuMemory.GetPeakBytes()
+        << ", \"resources\": " << gpuMemory.GetResourceCount() << ", \"warnings\": " << gpuMemory.GetWarningCount() << ", \"owners\": {";
+    bool firstOwner = true;
+    for (const GPUMemoryTracker::OwnerTotal& total : gpuMemory.GetOwnerTotals()) {
+        file << (firstOwner ? "" : ", ") << "\"" << JsonEscape(total.owner) << "\": " << total.bytes;
+        firstOwner = false;
+    }
+    file << "}},\n";
+    file << "  \"stages\": {";
+
+    bool first = true;
+    for (const auto& [name, stage] : m_Stages) {
+        file << (first ? "\n" : ",\n") << "    \"" << JsonEscape(name) << "\": {\"samples\": "
+            << std::max(stage.gpuMs.size(), stage.cpuMs.size());
+        if (!stage.gpuMs.empty()) {
+            file << ", ";
+            WriteSummary(file, "gpu", stage.gpuMs);
+        }
+        if (!stage.cpuMs.empty()) {
+            file << ", ";
+            WriteSummary(file, "cpu", stage.cpuMs);
+        }
+        file << "}";
+        first = false;
+    }
+    file << "\n  }\n}\n";
+    return file.good();
+}
+
+// ---------------------------------------------------------------------------
+// 比较
+
+static bool LoadReport(const std::string& path, JsonValue& report) {
+    if (!LoadJsonFile(path, report) || !report.Find("stages")) {
+        std::cerr << "Benchmark: " << path << " is not a benchmark report" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// GPU作用域比较GPU时间，仅CPU的阶段（帧时间、UI）比较CPU时间
+static bool StageMetric(const JsonValue& stage, const std::string& metric, double& value, const char*& clock) {
+    const JsonValue* timings = stage.Find("gpu");
+    clock = "gpu";
+    if (!timings) {
+        timings = stage.Find("cpu");
+        clock = "cpu";
+    }
+    const JsonValue* number = timings ? timings->Find(metric) : nullptr;
+    if (!number || number->type != JsonValue::Type::Number) return false;
+    value = number->number;
+    return true;
+}
+
+int Benchmark::Compare(const std::string& resultPath, const std::string& baselinePath, const BenchmarkOptions& options) {
+    JsonValue result, baseline;
+    if (!LoadReport(resultPath, result) || !LoadReport(baselinePath, baseline)) return 2;
+
+    const JsonValue* resultRenderer = result.Find("renderer");
+    const JsonValue* baselineRenderer = baseline.Find("renderer");
+    if (resultRenderer && baselineRenderer && resultRenderer->string != baselineRenderer->string) {
+        std::cout << "Warning: renderer differs from baseline (" << resultRenderer->string
+            << " vs " << baselineRenderer->string << ")" << std::endl;
+    }
+
+    const JsonValue& resultStages = *result.Find("stages");
+    const JsonValue& baselineStages = *baseline.Find("stages");
+    int regressions = 0, improvements = 0;
+
+    std::printf("%-40s %5s %10s %10s %9s\n", "Stage", "", "Baseline", "Current", "Change");
+    for (size_t i = 0; i < baselineStages.keys.size(); ++i) {
+        const std::string& name = baselineStages.keys[i];
+        double before = 0.0, after = 0.0;
+        const char* clock = "";
+        if (!StageMetric(baselineStages.items[i], options.metric, before, clock)) continue;
+
+        const JsonValue* stage = resultStages.Find(name);
+        const char* resultClock = "";
+        if (!stage || !StageMetric(*stage, options.metric, after, resultClock)) {
+            std::printf("%-40s %5s %10.3f %10s %9s  missing\n", name.c_str(), clock, before, "-", "-");
+            continue;
+        }
+
+        const double delta = after - before;
+        const double percent = before > 0.0 ? delta / before * 100.0 : 0.0;
+        const char* status = "";
+        if (percent > options.thresholdPercent && delta > options.minDeltaMs) {
+            status = "REGRESSION";
+            regressions++;
+        }
+        else if (percent < -options.thresholdPercent && -delta > options.minDeltaMs) {
+            status = "improved";
+            improvements++;
+        }
+        std::printf("%-40s %5s %10.3f %10.3f %+8.1f%%  %s\n", name.c_str(), clock, before, after, percent, status);
+    }
+
+    // 显存峰值：同样按百分比阈值，绝对差至少MEMORY_MIN_DELTA_MB
+    const JsonValue* resultMemory = result.Find("gpuMemory");
+    const JsonValue* baselineMemory = baseline.Find("gpuMemory");
+    const JsonValue* resultPeak = resultMemory ? resultMemory->Find("peakBytes") : nullptr;
+    const JsonValue* baselinePeak = baselineMemory ? baselineMemory->Find("peakBytes") : nullptr;
+    if (resultPeak && baselinePeak) {
+        const double before = baselinePeak->number / (1024.0 * 1024.0);
+        const double after = resultPeak->number / (1024.0 * 1024.0);
+        const double delta = after - before;
+        const double percent = before > 0.0 ? delta / before * 100.0 : 0.0;
+        const char* status = "";
+        if (percent > options.thresholdPercent && delta > MEMORY_MIN_DELTA_MB) {
+            status = "REGRESSION";
+            regressions++;
+        }
+        else if (percent < -options.thresholdPercent && -delta > MEMORY_MIN_DELTA_MB) {
+            status = "improved";
+            improvements++;
+        }
+        std::printf("%-40s %5s %10.3f %10.3f %+8.1f%%  %s\n", "GPU memory peak (MB)", "", before, after, percent, status);
+    }
+
+    std::printf("%s: %d regression(s), %d improvement(s) (metric %s, threshold %.1f%%, min delta %.3f ms)\n",
+        regressions > 0 ? "FAILED" : "PASSED", regressions, improvements,
+        options.metric.c_str(), options.thresholdPercent, options.minDeltaMs);
+    return regressions > 0 ? 1 : 0;
+}
@@ -0,0 +1,101 @@
+// Benchmark.h
+#pragma once
+#include <map>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+#include "Camera.h"
+
+class PerformanceProfiler;
+
+// 命令行参数：
+//   --benchmark                  加载场景、播放相机路径、预热后记录各阶段耗时并写出JSON报告
+//   --scene <file>               默认res/Scene/performance_test.scene
+//   --camera-path <file>         默认res/Benchmark/orbit.campath
+//   --replay <file>              回放帧捕获（.rtcap）代替场景和相机路径，隐含--benchmark
+//   --warmup <N> --frames <M>    预热帧数 / 记录帧数
+//   --render-scale <s>           固定渲染分辨率缩放（关闭动态分辨率）
+//   --output <file>              默认benchmark_result.json
+//   --baseline <file>            写出报告后与基线比较，有回归时退出码为1
+//   --compare <file>             不渲染，只把已有报告与--baseline比较
+//   --metric p50|p95|p99|mean    比较的统计量
+//   --threshold <percent>        相对基线变慢超过该百分比，
+//   --min-delta <ms>             且绝对差超过该值时记为回归（过滤很短阶段的噪声）
+struct BenchmarkOptions {
+    bool enabled = false;
+    std::string scenePath = "res/Scene/performance_test.scene";
+    std::string cameraPath = "res/Benchmark/orbit.campath";
+    std::string outputPath = "benchmark_result.json";
+    std::string baselinePath;
+    std::string comparePath;
+    std::string replayPath;
+    int warmupFrames = 60;
+    int frames = 300;
+    bool framesSet = false;         // 指定了--frames（回放时默认为捕获的帧数）
+    float renderScale = 1.0f;
+    std::string metric = "p50";
+    float thresholdPercent = 10.0f;
+    float minDeltaMs = 0.05f;
+
+    // 出错时打印用法并返回false
+    static bool Parse(int argc, char** argv, BenchmarkOptions& options);
+};
+
+// 相机路径文件：每行 KEY 时间(秒) x y z yaw pitch fov，'#'开头为注释；
+// 位置按Catmull-Rom插值，角度线性插值，超过最后一个关键帧后循环
+class CameraPath {
+public:
+    struct Key {
+        float time = 0.0f;
+        glm::vec3 position = glm::vec3(0.0f);
+        float yaw = -90.0f, pitch = 0.0f, fov = 45.0f;
+    };
+
+    bool Load(const std::string& path);
+    void Apply(float time, Camera& camera) const;
+    float GetDuration() const { return m_Keys.empty() ? 0.0f : m_Keys.back().time; }
+
+private:
+    std::vector<Key> m_Keys;
+};
+
+// 基准测试：相机按固定帧率推进（与实际帧率无关，保证每次运行渲染相同的画面序列），
+// 预热后记录M帧的GPU/CPU阶段耗时，GPU结果异步回读，全部到齐后写出报告
+class Benchmark {
+public:
+    static constexpr float PATH_FPS = 60.0f;
+    static constexpr double MEMORY_MIN_DELTA_MB = 1.0;  // 显存峰值回归的最小绝对差
+
+    explicit Benchmark(const BenchmarkOptions& options) : m_Options(options) {}
+
+    // 加载相机路径并记录GL渲染器信息，失败时返回false
+    bool Init(int renderWidth, int renderHeight);
+    void ApplyCamera(long long frameIndex, Camera& camera) const;
+    // 每帧profiler.EndFrame之后调用，收集已回读的帧；报告写出后返回true
+    bool Update(const PerformanceProfiler& profiler);
+    // 0 = 通过，1 = 有回归，2 = 出错
+    int GetExitCode() const { return m_ExitCode; }
+    void Fail(const std::string& message);
+
+    // 比较两份报告并打印结果，返回退出码
+    static int Compare(const std::string& resultPath, const std::string& baselinePath, const BenchmarkOptions& options);
+
+private:
+    struct StageSamples {
+        bool gpu = false;
+        std::vector<float> gpuMs, cpuMs;
+    };
+
+    void Record(const PerformanceProfiler& profiler, long long frameIndex);
+    bool WriteReport() const;
+
+    BenchmarkOptions m_Options;
+    CameraPath m_Path;
+    std::string m_Renderer, m_GLVersion;
+    int m_RenderWidth = 0, m_RenderHeight = 0;
+
+    long long m_NextFrame = 0;                  // 下一个等待回读的帧
+    int m_RecordedFrames = 0, m_DroppedFrames = 0;
+    std::map<std::string, StageSamples> m_Stages; // 键为作用域路径，如RenderGraph/RayTracing
+    int m_ExitCode = 0;
+};
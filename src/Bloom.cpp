@@ -0,0 +1,279 @@
+// Bloom.cpp
+#include "Bloom.h"
+#include <imgui.h>
+#include <algorithm>
+#include "global.h"
+#include "GPUMemoryTracker.h"
+
+BloomManager::BloomManager(int width, int height)
+    : screenWidth(width), screenHeight(height) {
+}
+
+BloomManager::~BloomManager() {
+    gpuMemory.DeleteTextures(static_cast<GLsizei>(m_MipTextures.size()), m_MipTextures.data());
+    glDeleteFramebuffers(static_cast<GLsizei>(m_MipFBOs.size()), m_MipFBOs.data());
+    gpuMemory.DeleteTextures(2, m_PingPongTextures);
+    glDeleteFramebuffers(2, m_PingPongFBOs);
+    glDeleteQueries(QUERY_FRAMES * 2 * MAX_MIP_LEVELS * 2, &m_LevelQueries[0][0][0][0]);
+}
+
+void BloomManager::Init() {
+    glGenQueries(QUERY_FRAMES * 2 * MAX_MIP_LEVELS * 2, &m_LevelQueries[0][0][0][0]);
+
+    m_PrefilterShader.Init("shader/outputVs.glsl", "shader/bloom_downsampleFs.glsl");
+    m_DownsampleShader.Init("shader/outputVs.glsl", "shader/bloom_downsampleFs.glsl");
+    m_UpsampleShader.Init("shader/outputVs.glsl", "shader/bloom_upsampleFs.glsl");
+    m_BlurShader.Init("shader/outputVs.glsl", "shader/gaussian_blurFs.glsl");
+    m_ComputeBlur.Init();
+
+    InitMipChain();
+    InitGaussian();
+}
+
+void BloomManager::InitMipChain() {
+    gpuMemory.DeleteTextures(static_cast<GLsizei>(m_MipTextures.size()), m_MipTextures.data());
+    glDeleteFramebuffers(static_cast<GLsizei>(m_MipFBOs.size()), m_MipFBOs.data());
+    m_MipTextures.clear();
+    m_MipFBOs.clear();
+    m_MipSizes.clear();
+
+    // 第0级为半分辨率，之后每级减半，边长不足2时停止
+    glm::ivec2 size(std::max(screenWidth / 2, 1), std::max(screenHeight / 2, 1));
+    for (int i = 0; i < MAX_MIP_LEVELS; ++i) {
+        m_MipSizes.push_back(size);
+        if (size.x < 4 || size.y < 4) break;
+        size = glm::ivec2(size.x / 2, size.y / 2);
+    }
+
+    const int count = static_cast<int>(m_MipSizes.size());
+    m_MipTextures.resize(count);
+    m_MipFBOs.resize(count);
+    glGenTextures(count, m_MipTextures.data());
+    glGenFramebuffers(count, m_MipFBOs.data());
+    for (int i = 0; i < count; ++i) {
+        glBindTexture(GL_TEXTURE_2D, m_MipTextures[i]);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, m_MipSizes[i].x, m_MipSizes[i].y, 0, GL_RGBA, GL_FLOAT, NULL);
+        gpuMemory.TrackTexture(m_MipTextures[i], "Bloom", "Mip " + std::to_string(i), GL_RGBA16F, m_MipSizes[i].x, m_MipSizes[i].y);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+        glBindFramebuffer(GL_FRAMEBUFFER, m_MipFBOs[i]);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_MipTextures[i], 0);
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+void BloomManager::InitGaussian() {
+    gpuMemory.DeleteTextures(2, m_PingPongTextures);
+    glDeleteFramebuffers(2, m_PingPongFBOs);
+
+    glGenFramebuffers(2, m_PingPongFBOs);
+    glGenTextures(2, m_PingPongTextures);
+    // 创建亮度提取和模糊用的纹理
+    for (int i = 0; i < 2; i++) {
+        glBindTexture(GL_TEXTURE_2D, m_PingPongTextures[i]);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, screenWidth, screenHeight, 0, GL_RGBA, GL_FLOAT, NULL);
+        gpuMemory.TrackTexture(m_PingPongTextures[i], "Bloom", "Ping-pong " + std::to_string(i), GL_RGBA16F, screenWidth, screenHeight);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+        glBindFramebuffer(GL_FRAMEBUFFER, m_PingPongFBOs[i]);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_PingPongTextures[i], 0);
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+void BloomManager::Resize(int width, int height) {
+    screenWidth = width;
+    screenHeight = height;
+    InitMipChain();
+    InitGaussian();
+}
+
+GLuint BloomManager::GetBloomTexture() const {
+    if (mode == Mode::MipChain) return m_MipTextures[0];
+    // compute：5次dispatch，结果在[1]；片元：10趟交替，结果在[0]
+    return m_PingPongTextures[useComputeBlur ? 1 : 0];
+}
+
+float BloomManager::GetCombineStrength() const {
+    if (mode == Mode::MipChain) return bloomStrength / std::max(m_ActiveLevels, 1);
+    return bloomStrength;
+}
+
+void BloomManager::Render(GLuint sceneTex, PerformanceProfiler& profiler) {
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+
+    if (mode == Mode::MipChain) RenderMipChain(sceneTex, profiler);
+    else RenderGaussian(sceneTex, profiler);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+}
+
+void BloomManager::RenderMipChain(GLuint sceneTex, PerformanceProfiler& profiler) {
+    ReadLevelTimings();
+    const int frame = m_QueryFrame;
+    m_ActiveLevels = std::min(mipLevels, static_cast<int>(m_MipSizes.size()));
+
+    // 步骤1: 阈值 + 降采样到半分辨率（Karis平均抑制萤火虫噪点）
+    {
+        PerformanceProfiler::Scope extractScope(profiler, "BloomExtract");
+        glQueryCounter(m_LevelQueries[frame][0][0][0], GL_TIMESTAMP);
+        glBindFramebuffer(GL_FRAMEBUFFER, m_MipFBOs[0]);
+        glViewport(0, 0, m_MipSizes[0].x, m_MipSizes[0].y);
+        m_PrefilterShader.use();
+        m_PrefilterShader.setInt("srcTexture", 0);
+        m_PrefilterShader.setBool("prefilter", true);
+        m_PrefilterShader.setFloat("threshold", threshold);
+        m_PrefilterShader.setFloat("softKnee", softKnee);
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, sceneTex);
+        RenderQuad();
+        glQueryCounter(m_LevelQueries[frame][0][0][1], GL_TIMESTAMP);
+    }
+
+    {
+        PerformanceProfiler::Scope blurScope(profiler, "BloomBlur");
+
+        // 步骤2: 13-tap逐级降采样
+        m_DownsampleShader.use();
+        m_DownsampleShader.setInt("srcTexture", 0);
+        m_DownsampleShader.setBool("prefilter", false);
+        for (int i = 1; i < m_ActiveLevels; ++i) {
+            glQueryCounter(m_LevelQueries[frame][0][i][0], GL_TIMESTAMP);
+            glBindFramebuffer(GL_FRAMEBUFFER, m_MipFBOs[i]);
+            glViewport(0, 0, m_MipSizes[i].x, m_MipSizes[i].y);
+            glBindTexture(GL_TEXTURE_2D, m_MipTextures[i - 1]);
+            RenderQuad();
+            glQueryCounter(m_LevelQueries[frame][0][i][1], GL_TIMESTAMP);
+        }
+
+        // 步骤3: tent滤波逐级升采样，叠加到上一级
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_ONE, GL_ONE);
+        glBlendEquation(GL_FUNC_ADD);
+        m_UpsampleShader.use();
+        m_UpsampleShader.setInt("srcTexture", 0);
+        m_UpsampleShader.setFloat("filterRadius", filterRadius);
+        for (int i = m_ActiveLevels - 2; i >= 0; --i) {
+            glQueryCounter(m_LevelQueries[frame][1][i][0], GL_TIMESTAMP);
+            glBindFramebuffer(GL_FRAMEBUFFER, m_MipFBOs[i]);
+            glViewport(0, 0, m_MipSizes[i].x, m_MipSizes[i].y);
+            glBindTexture(GL_TEXTURE_2D, m_MipTextures[i + 1]);
+            RenderQuad();
+            glQueryCounter(m_LevelQueries[frame][1][i][1], GL_TIMESTAMP);
+        }
+        glDisable(GL_BLEND);
+    }
+
+    m_QueryIssued[frame] = true;
+    m_QueryLevels[frame] = m_ActiveLevels;
+    m_QueryFrame = (frame + 1) % QUERY_FRAMES;
+}
+
+void BloomManager::RenderGaussian(GLuint sceneTex, PerformanceProfiler& profiler) {
+    glViewport(0, 0, screenWidth, screenHeight);
+
+    // 步骤1: 亮度提取已在后处理解析pass（post_resolveCs.glsl）中写入GetBrightTexture()
+
+    // 步骤2: 高斯模糊（5次水平+垂直，迭代次数越多效果越平滑）
+    PerformanceProfiler::Scope blurScope(profiler, "BloomBlur");
+    if (useComputeBlur) {
+        // 每次dispatch在共享内存中完成两个方向
+        for (int i = 0; i < 5; i++) {
+            m_ComputeBlur.Blur(m_PingPongTextures[i % 2], m_PingPongTextures[(i + 1) % 2], GL_RGBA16F, screenWidth, screenHeight);
+        }
+    }
+    else {
+        bool horizontal = true;
+        m_BlurShader.use();
+        for (int i = 0; i < 10; i++) { // 模糊迭代次数（例如10次）
+            glBindFramebuffer(GL_FRAMEBUFFER, m_PingPongFBOs[horizontal]);
+            m_BlurShader.setBool("horizontal", horizontal);
+            glActiveTexture(GL_TEXTURE0);
+            glBindTexture(GL_TEXTURE_2D, m_PingPongTextures[!horizontal]);
+            RenderQuad();
+            horizontal = !horizontal;
+        }
+    }
+}
+
+void BloomManager::ReadLevelTimings() {
+    // 读取即将被覆盖的最旧一帧，结果未就绪时跳过，不阻塞CPU
+    const int frame = m_QueryFrame;
+    if (!m_QueryIssued[frame]) return;
+    m_QueryIssued[frame] = false;
+
+    const int levels = m_QueryLevels[frame];
+    GLuint available = 0;
+    glGetQueryObjectuiv(m_LevelQueries[frame][1][0][1], GL_QUERY_RESULT_AVAILABLE, &available);
+    if (levels > 1 && !available) return;
+
+    for (int i = 0; i < levels; ++i) {
+        GLuint64 start = 0, end = 0;
+        glGetQueryObjectui64v(m_LevelQueries[frame][0][i][0], GL_QUERY_RESULT, &start);
+        glGetQueryObjectui64v(m_LevelQueries[frame][0][i][1], GL_QUERY_RESULT, &end);
+        m_DownsampleMs[i] = (end - start) / 1e6f;
+
+        m_UpsampleMs[i] = 0.0f;
+        if (i < levels - 1) {
+            glGetQueryObjectui64v(m_LevelQueries[frame][1][i][0], GL_QUERY_RESULT, &start);
+            glGetQueryObjectui64v(m_LevelQueries[frame][1][i][1], GL_QUERY_RESULT, &end);
+            m_UpsampleMs[i] = (end - start) / 1e6f;
+        }
+    }
+}
+
+void BloomManager::DrawUI() {
+    ImGui::SetNextWindowPos(ImVec2(10, 310), ImGuiCond_FirstUseEver);
+    ImGui::SetNextWindowCollapsed(true, ImGuiCond_FirstUseEver);
+    ImGui::Begin("Bloom", &showSettings);
+
+    int modeIndex = static_cast<int>(mode);
+    const char* modes[] = { "Mip Chain", "Gaussian" };
+    if (ImGui::Combo("Mode", &modeIndex, modes, IM_ARRAYSIZE(modes))) {
+        mode = static_cast<Mode>(modeIndex);
+    }
+    ImGui::SliderFloat("Strength", &bloomStrength, 0.0f, 2.0f);
+    ImGui::SliderFloat("Threshold", &threshold, 0.0f, 5.0f);
+
+    if (mode == Mode::MipChain) {
+        ImGui::SliderFloat("Soft Knee", &softKnee, 0.0f, 1.0f);
+        ImGui::SliderInt("Mip Levels", &mipLevels, 2, static_cast<int>(m_MipSizes.size()));
+        ImGui::SliderFloat("Filter Radius", &filterRadius, 0.5f, 3.0f);
+
+        ImGui::Separator();
+        float total = 0.0f;
+        for (int i = 0; i < m_ActiveLevels; ++i) {
+            ImGui::Text("L%d %4dx%-4d down %6.3f ms  up %6.3f ms",
+                i, m_MipSizes[i].x, m_MipSizes[i].y, m_DownsampleMs[i], m_UpsampleMs[i]);
+            total += m_DownsampleMs[i] + m_UpsampleMs[i];
+        }
+        ImGui::Text("Total: %.3f ms", total);
+    }
+    else {
+        ImGui::Checkbox("Compute Blur (shared memory)", &useComputeBlur);
+    }
+
+    // 片元两趟模糊与compute模糊的对比
+    ImGui::Separator();
+    if (ImGui::Button("Run Blur Benchmark")) {
+        m_BlurBenchmark = m_ComputeBlur.RunBenchmark(screenWidth, screenHeight);
+    }
+    if (m_BlurBenchmark.valid) {
+        const SeparableBlur::BenchmarkResult& b = m_BlurBenchmark;
+        ImGui::Text("%dx%d RGBA16F, %d iterations", b.width, b.height, b.iterations);
+        ImGui::Text("Fragment: %6.3f ms  %6.1f MB  %4.1f fetches/px", b.fragmentMs, b.fragmentMB, b.fragmentFetches);
+        ImGui::Text("Compute:  %6.3f ms  %6.1f MB  %4.1f fetches/px", b.computeMs, b.computeMB, b.computeFetches);
+        ImGui::Text("Traffic: -%.0f%%, speedup x%.2f",
+            100.0 * (1.0 - b.computeMB / b.fragmentMB), b.computeMs > 0.0 ? b.fragmentMs / b.computeMs : 0.0);
+    }
+
+    ImGui::End();
+}
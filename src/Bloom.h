@@ -0,0 +1,71 @@
+// Bloom.h
+#pragma once
+#include "Shader.h"
+#include "PerformanceProfiler.h"
+#include "SeparableBlur.h"
+#include <vector>
+
+class BloomManager {
+public:
+    enum class Mode {
+        MipChain,   // 半分辨率阈值 + 13-tap逐级降采样 + tent升采样叠加
+        Gaussian    // 全分辨率高斯模糊（5次水平+垂直）
+    };
+
+    static constexpr int MAX_MIP_LEVELS = 8;
+    static constexpr int QUERY_FRAMES = 3;  // 每级计时查询的环形缓冲深度
+
+    BloomManager(int width, int height);
+    ~BloomManager();
+
+    void Init();
+    void Resize(int width, int height);
+    // 提取高光并模糊，结果通过GetBloomTexture获取
+    // 高斯模式的亮度提取由后处理解析pass融合完成，sceneTex仅供mip链预滤波使用
+    void Render(GLuint sceneTex, PerformanceProfiler& profiler);
+    void DrawUI();
+
+    GLuint GetBloomTexture() const;
+    // 高斯模式下需要由解析pass写入的亮度提取目标，mip链模式返回0
+    GLuint GetBrightTexture() const { return mode == Mode::Gaussian ? m_PingPongTextures[0] : 0; }
+    // 合成时使用的强度（mip链叠加了多级结果，按级数归一化）
+    float GetCombineStrength() const;
+
+    // 参数
+    int screenWidth, screenHeight;
+    Mode mode = Mode::MipChain;
+    int mipLevels = 6;
+    float threshold = 1.0f;
+    float softKnee = 0.5f;
+    float filterRadius = 1.0f;     // tent滤波半径（以texel为单位）
+    float bloomStrength = 0.5f;
+    bool useComputeBlur = true;    // 高斯模式：共享内存compute模糊 / 旧的片元着色器两趟模糊
+    bool showSettings = true;
+
+private:
+    void InitMipChain();
+    void InitGaussian();
+    void RenderMipChain(GLuint sceneTex, PerformanceProfiler& profiler);
+    void RenderGaussian(GLuint sceneTex, PerformanceProfiler& profiler);
+    void ReadLevelTimings();
+
+    // mip链：每级一张纹理和一个FBO，第0级为半分辨率
+    std::vector<GLuint> m_MipTextures, m_MipFBOs;
+    std::vector<glm::ivec2> m_MipSizes;
+    int m_ActiveLevels = 0;
+    Shader m_PrefilterShader, m_DownsampleShader, m_UpsampleShader;
+
+    // 高斯模糊
+    GLuint m_PingPongFBOs[2] = {}, m_PingPongTextures[2] = {};
+    Shader m_BlurShader;
+    SeparableBlur m_ComputeBlur;
+    SeparableBlur::BenchmarkResult m_BlurBenchmark;
+
+    // 每级GPU耗时：[帧][降采样/升采样][级别][开始/结束]
+    GLuint m_LevelQueries[QUERY_FRAMES][2][MAX_MIP_LEVELS][2] = {};
+    bool m_QueryIssued[QUERY_FRAMES] = {};
+    int m_QueryLevels[QUERY_FRAMES] = {};
+    int m_QueryFrame = 0;
+    float m_DownsampleMs[MAX_MIP_LEVELS] = {};
+    float m_UpsampleMs[MAX_MIP_LEVELS] = {};
+};
@@ -0,0 +1,73 @@
+// CostHeatmap.cpp
+#include "CostHeatmap.h"
+#include "global.h"
+#include "GPUMemoryTracker.h"
+#include <imgui.h>
+
+CostHeatmap::~CostHeatmap() {
+    gpuMemory.DeleteTextures(1, &m_CostTex);
+}
+
+void CostHeatmap::Init() {
+    m_OverlayShader.Init("shader/outputVs.glsl", "shader/cost_heatmapFs.glsl");
+    // 不支持时着色器中的时钟模式输出0，UI中禁用该选项
+    m_ClockSupported = GLEW_ARB_shader_clock;
+}
+
+void CostHeatmap::Resize(int width, int height) {
+    if (width == m_Width && height == m_Height) return;
+    m_Width = width;
+    m_Height = height;
+
+    gpuMemory.DeleteTextures(1, &m_CostTex);
+    glGenTextures(1, &m_CostTex);
+    glBindTexture(GL_TEXTURE_2D, m_CostTex);
+    glTexStorage2D(GL_TEXTURE_2D, 1, GL_R32F, width, height);
+    gpuMemory.TrackTexture(m_CostTex, "CostHeatmap", "Cost", GL_R32F, width, height);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+}
+
+void CostHeatmap::Bind(Shader& raytracingShader) const {
+    raytracingShader.setInt("costMode", static_cast<int>(mode));
+    if (IsEnabled()) glBindImageTexture(6, m_CostTex, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+}
+
+void CostHeatmap::Render() {
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    m_OverlayShader.use();
+    m_OverlayShader.setInt("costTexture", 0);
+    m_OverlayShader.setFloat("maxValue", maxValue[static_cast<int>(mode)]);
+    m_OverlayShader.setBool("logScale", logScale);
+    m_OverlayShader.setFloat("opacity", opacity);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, m_CostTex);
+    RenderQuad();
+
+    glDisable(GL_BLEND);
+}
+
+void CostHeatmap::DrawUI() {
+    ImGui::SetNextWindowPos(ImVec2(10, 430), ImGuiCond_FirstUseEver);
+    ImGui::SetNextWindowCollapsed(true, ImGuiCond_FirstUseEver);
+    ImGui::Begin("Cost Heatmap", &showSettings);
+
+    const char* modes[] = { "Off", "Intersection Tests", "Shadow Rays", "Bounces", "Shader Clock" };
+    int modeIndex = static_cast<int>(mode);
+    if (ImGui::Combo("Mode", &modeIndex, modes, IM_ARRAYSIZE(modes))) {
+        mode = static_cast<Mode>(modeIndex);
+        if (mode == Mode::Clock && !m_ClockSupported) mode = Mode::Off;
+    }
+    if (!m_ClockSupported) ImGui::TextDisabled("Shader Clock: ARB_shader_clock not supported");
+
+    if (IsEnabled()) {
+        ImGui::DragFloat("Max", &maxValue[static_cast<int>(mode)], maxValue[static_cast<int>(mode)] * 0.01f, 1.0f, 1e9f, "%.0f");
+        ImGui::Checkbox("Log Scale", &logScale);
+        ImGui::SliderFloat("Opacity", &opacity, 0.0f, 1.0f);
+    }
+
+    ImGui::End();
+}
@@ -0,0 +1,45 @@
+// CostHeatmap.h
+#pragma once
+#include "Shader.h"
+
+// 每像素开销热力图：光追着色器在主光线pass中写出相交测试数/阴影光线数/弹射次数或着色器时钟（R32F），
+// 合成后以伪彩色叠加在最终画面上，用于定位昂贵的物体、材质和光源
+class CostHeatmap {
+public:
+    // 需与raytracingCs.glsl中的costMode一致
+    enum class Mode {
+        Off,
+        IntersectionTests,  // AABB + 图元相交测试
+        ShadowRays,
+        Bounces,
+        Clock,              // ARB_shader_clock周期数
+        Count
+    };
+
+    // 参数
+    Mode mode = Mode::Off;
+    float maxValue[static_cast<int>(Mode::Count)] = { 1.0f, 500.0f, 64.0f, 16.0f, 200000.0f };
+    bool logScale = false;
+    float opacity = 0.75f;
+    bool showSettings = true;
+
+    CostHeatmap() = default;
+    ~CostHeatmap();
+    void Init();
+    // 与光追输出同为渲染分辨率
+    void Resize(int width, int height);
+
+    bool IsEnabled() const { return mode != Mode::Off; }
+    GLuint GetTexture() const { return m_CostTex; }
+    // 主光追dispatch前调用：设置costMode并绑定图像单元6
+    void Bind(Shader& raytracingShader) const;
+    // 叠加到当前帧缓冲（合成之后）
+    void Render();
+    void DrawUI();
+
+private:
+    GLuint m_CostTex = 0;
+    int m_Width = 0, m_Height = 0;
+    bool m_ClockSupported = false;
+    Shader m_OverlayShader;
+};
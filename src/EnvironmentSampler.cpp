@@ -0,0 +1,89 @@
+// EnvironmentSampler.cpp
+#include "EnvironmentSampler.h"
+#include "GPUMemoryTracker.h"
+#include <algorithm>
+#include <cmath>
+
+EnvironmentSampler::~EnvironmentSampler() {
+    gpuMemory.DeleteBuffers(1, &id);
+}
+
+void EnvironmentSampler::Init() {
+    glGenBuffers(1, &id);
+}
+
+std::vector<EnvironmentSampler::AliasEntry> EnvironmentSampler::BuildAliasTable(const std::vector<float>& weights) {
+    const size_t n = weights.size();
+    std::vector<AliasEntry> result(n);
+
+    double sum = 0.0;
+    for (float w : weights) sum += w;
+    if (n == 0) return result;
+
+    // 全黑贴图退化为均匀分布
+    std::vector<double> scaled(n);
+    for (size_t i = 0; i < n; ++i) {
+        result[i].pdf = sum > 0.0 ? static_cast<float>(weights[i] / sum) : 1.0f / n;
+        scaled[i] = static_cast<double>(result[i].pdf) * n;
+    }
+
+    // Vose算法：小于1的单元用大于1的单元补齐
+    std::vector<uint32_t> small, large;
+    for (size_t i = 0; i < n; ++i) {
+        (scaled[i] < 1.0 ? small : large).push_back(static_cast<uint32_t>(i));
+    }
+    while (!small.empty() && !large.empty()) {
+        uint32_t s = small.back(); small.pop_back();
+        uint32_t l = large.back();
+        result[s].q = static_cast<float>(scaled[s]);
+        result[s].alias = l;
+        scaled[l] -= 1.0 - scaled[s];
+        if (scaled[l] < 1.0) {
+            large.pop_back();
+            small.push_back(l);
+        }
+    }
+    // 剩余单元（含浮点误差）概率为1
+    for (uint32_t i : large) { result[i].q = 1.0f; result[i].alias = i; }
+    for (uint32_t i : small) { result[i].q = 1.0f; result[i].alias = i; }
+    return result;
+}
+
+void EnvironmentSampler::Build(const float* data, int srcWidth, int srcHeight, int channels) {
+    valid = false;
+    if (!data || srcWidth <= 0 || srcHeight <= 0) return;
+
+    width = std::min(srcWidth, MAX_WIDTH);
+    height = std::min(srcHeight, MAX_HEIGHT);
+
+    // 每个单元的权重 = 平均亮度 * cos(纬度)（经纬图单元的立体角）
+    std::vector<float> weights(width * height);
+    for (int y = 0; y < height; ++y) {
+        const int y0 = y * srcHeight / height, y1 = std::max(y0 + 1, (y + 1) * srcHeight / height);
+        const float latitude = ((y + 0.5f) / height - 0.5f) * 3.14159265f;
+        const float cosLat = std::max(std::cos(latitude), 0.0f);
+        for (int x = 0; x < width; ++x) {
+            const int x0 = x * srcWidth / width, x1 = std::max(x0 + 1, (x + 1) * srcWidth / width);
+            double lum = 0.0;
+            for (int sy = y0; sy < y1; ++sy) {
+                for (int sx = x0; sx < x1; ++sx) {
+                    const float* p = data + (static_cast<size_t>(sy) * srcWidth + sx) * channels;
+                    lum += channels >= 3 ? 0.2126f * p[0] + 0.7152f * p[1] + 0.0722f * p[2] : p[0];
+                }
+            }
+            lum /= (y1 - y0) * (x1 - x0);
+            weights[y * width + x] = static_cast<float>(lum) * cosLat;
+        }
+    }
+
+    table = BuildAliasTable(weights);
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, id);
+    glBufferData(GL_SHADER_STORAGE_BUFFER,
+        table.size() * sizeof(AliasEntry),
+        table.data(),
+        GL_STATIC_DRAW);
+    gpuMemory.TrackBuffer(id, "Skybox", "Env alias table", table.size() * sizeof(AliasEntry));
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, id); // 绑定到索引3
+    valid = true;
+}
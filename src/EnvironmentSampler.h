@@ -0,0 +1,33 @@
+// EnvironmentSampler.h
+#pragma once
+#include <GL/glew.h>
+#include <vector>
+#include <cstdint>
+
+// 环境贴图重要性采样：按亮度*立体角构建二维分布，用Walker别名表O(1)采样
+// 别名表上传到SSBO（binding = 3），着色器中用于天空盒的显式光源采样（MIS）
+class EnvironmentSampler {
+public:
+    static constexpr int MAX_WIDTH = 512;   // 分布分辨率上限（经纬图降采样）
+    static constexpr int MAX_HEIGHT = 256;
+
+    // 与着色器中EnvAliasEntry布局一致（std430，12字节）
+    struct AliasEntry {
+        float q;            // 保留自身的概率阈值
+        uint32_t alias;     // 别名索引
+        float pdf;          // 该单元的离散概率
+    };
+
+    GLuint id = 0;
+    int width = 0, height = 0;
+    bool valid = false;
+    std::vector<AliasEntry> table;
+
+    EnvironmentSampler() = default;
+    ~EnvironmentSampler();
+    void Init();
+    // data为stbi_loadf得到的经纬图（已垂直翻转），channels为通道数
+    void Build(const float* data, int srcWidth, int srcHeight, int channels);
+
+    static std::vector<AliasEntry> BuildAliasTable(const std::vector<float>& weights);
+};
@@ -1,6 +1,7 @@
 #include "ForwardShadingPipeline.h"
 #include <iostream>
 #include "global.h"
+#include "GPUMemoryTracker.h"
 #include <stb_image.h>
 
 void ForwardShadingPipline::Init()
@@ -8,15 +9,23 @@ void ForwardShadingPipline::Init()
     InitFWEW();
     InitShdaer();
     InitBlueNoiseTex();
-    InitOutputTex();
     imguiManager.m_Window = window;
+    imguiManager.profiler = &gProfiler;
     imguiManager.Init();
     ssbo.Init();
     lightSSBO.Init();
+    sobolSampler.Init();
+    pathController.Init();
+    probeVolume.Init();
+    costHeatmap.Init();
     InitBloom();
     InitAO();
-    InitTAA();
+    InitPostProcess();
+    ResizeRenderTargets(WIDTH, HEIGHT, WIDTH, HEIGHT);
     gProfiler.Init();
+    gpuCounters.Init();
+    gProfiler.counters = &gpuCounters;
+    if (benchmarkOptions.enabled) InitBenchmark();
 }
 
 void ForwardShadingPipline::InitFWEW()
@@ -26,9 +35,13 @@ void ForwardShadingPipline::InitFWEW()
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    // 基准测试不显示窗口（构建机上配合Xvfb + llvmpipe运行）
+    if (benchmarkOptions.enabled) glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
 
     window = glfwCreateWindow(WIDTH, HEIGHT, "OpenGL Ray Tracing", nullptr, nullptr);
     glfwMakeContextCurrent(window);
+    // 基准测试不受垂直同步限制
+    if (benchmarkOptions.enabled) glfwSwapInterval(0);
     glewExperimental = GL_TRUE;
     glewInit();
 
@@ -44,6 +57,7 @@ void ForwardShadingPipline::InitBlueNoiseTex()
     glGenTextures(1, &blueNoiseTex);
     glBindTexture(GL_TEXTURE_2D, blueNoiseTex);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, width, height, 0, GL_RED, GL_UNSIGNED_BYTE, data);
+    gpuMemory.TrackTexture(blueNoiseTex, "Pipeline", "Blue noise", GL_R8, width, height);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
 }
@@ -54,56 +68,17 @@ void ForwardShadingPipline::InitShdaer()
     outputShader.Init("shader/outputVs.glsl", "shader/outputFs.glsl");
 }
 
-void ForwardShadingPipline::InitOutputTex()
-{
-    glGenTextures(1, &outputTex);
-    glBindTexture(GL_TEXTURE_2D, outputTex);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA32F, WIDTH, HEIGHT, 0, GL_RGBA, GL_FLOAT, nullptr);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glBindImageTexture(0, outputTex, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_RGBA32F);
-}
-
 void ForwardShadingPipline::InitBloom()
 {
-    glGenFramebuffers(2, bloomFBOs);
-    glGenTextures(2, bloomTextures);
-    // ȡģõ
-    for (int i = 0; i < 2; i++) {
-        glBindTexture(GL_TEXTURE_2D, bloomTextures[i]);
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, WIDTH, HEIGHT, 0, GL_RGBA, GL_FLOAT, NULL);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-
-        glBindFramebuffer(GL_FRAMEBUFFER, bloomFBOs[i]);
-        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, bloomTextures[i], 0);
-    }
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
-
-    extractShader.Init("shader/outputVs.glsl", "shader/brightness_extractFs.glsl");
-    blurShader.Init("shader/outputVs.glsl", "shader/gaussian_blurFs.glsl");
-    bloomCombineShader.Init("shader/outputVs.glsl", "shader/bloom_combineFs.glsl");
+    bloomManager = new BloomManager(WIDTH, HEIGHT);
+    bloomManager->Init();
 }
 
-void ForwardShadingPipline::InitTAA()
+void ForwardShadingPipline::InitPostProcess()
 {
-    glGenTextures(2, historyTex);
-    for (int i = 0; i < 2; i++) {
-        glBindTexture(GL_TEXTURE_2D, historyTex[i]);
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA32F, WIDTH, HEIGHT, 0, GL_RGBA, GL_FLOAT, nullptr);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    }
-    glGenFramebuffers(1, &taaFBO);
-    glBindFramebuffer(GL_FRAMEBUFFER, taaFBO);
-    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, historyTex[0], 0);
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    postProcessor = new PostProcessor(WIDTH, HEIGHT);
+    postProcessor->Init();
 
-    taaShader.Init("shader/outputVs.glsl", "shader/taaFs.glsl");
 }
 
 void ForwardShadingPipline::InitAO()
@@ -111,19 +86,73 @@ void ForwardShadingPipline::InitAO()
     aoManager = new AOManager(WIDTH, HEIGHT);
     aoManager->Init();
     imguiManager.aoManager = aoManager;
-    // λ
-    glGenTextures(1, &gPositionTex);
-    glBindTexture(GL_TEXTURE_2D, gPositionTex);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA32F, WIDTH, HEIGHT, 0, GL_RGBA, GL_FLOAT, nullptr);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glBindImageTexture(1, gPositionTex, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_RGBA32F);
-    glGenTextures(1, &gNormalTex);
-    glBindTexture(GL_TEXTURE_2D, gNormalTex);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, WIDTH, HEIGHT, 0, GL_RGBA, GL_FLOAT, nullptr);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glBindImageTexture(2, gNormalTex, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_RGBA16F);
+}
+
+void ForwardShadingPipline::InitBenchmark()
+{
+    // 回放：未指定--frames时记录整个捕获
+    const bool replay = !benchmarkOptions.replayPath.empty();
+    if (replay && frameCapture.Load(benchmarkOptions.replayPath, imguiManager.GetSkyboxCount()) && !benchmarkOptions.framesSet) {
+        benchmarkOptions.frames = frameCapture.GetFrameCount();
+    }
+    benchmark = new Benchmark(benchmarkOptions);
+
+    pathController.autoAdjust = false;
+    resolutionController.autoAdjust = false;
+    resolutionController.scale = std::clamp(benchmarkOptions.renderScale, ResolutionController::MIN_SCALE, ResolutionController::MAX_SCALE);
+
+    bool ok = true;
+    if (replay) {
+        // 场景、渲染缩放等设置来自捕获文件
+        ok = frameCapture.GetFrameCount() > 0;
+        if (!ok) benchmark->Fail("failed to load frame capture " + benchmarkOptions.replayPath);
+        else ApplyCapturedFrame(0);
+    }
+    else {
+        ok = imguiManager.LoadScene(benchmarkOptions.scenePath, ssbo, lightSSBO);
+        if (!ok) benchmark->Fail("failed to load scene " + benchmarkOptions.scenePath);
+    }
+    resolutionController.SetUpscaling(imguiManager.IsTAAEnabled() && postProcessor->upscale);
+    const glm::ivec2 renderSize = resolutionController.GetRenderSize(WIDTH, HEIGHT);
+    if (ok) ok = benchmark->Init(renderSize.x, renderSize.y);
+    if (!ok) glfwSetWindowShouldClose(window, GLFW_TRUE);
+}
+
+void ForwardShadingPipline::ResizeRenderTargets(int width, int height, int postWidth, int postHeight)
+{
+    // TAA之后的目标（历史、Bloom）：TAAU时为输出分辨率，否则与渲染分辨率相同
+    if (postWidth != postProcessor->screenWidth || postHeight != postProcessor->screenHeight) {
+        bloomManager->Resize(postWidth, postHeight);
+        postProcessor->Resize(postWidth, postHeight);
+        renderGraph.InvalidateImports();
+    }
+    if (width == renderWidth && height == renderHeight) return;
+    renderGraph.InvalidateImports();
+
+    renderWidth = width;
+    renderHeight = height;
+    // TAAU时后处理目标不随渲染分辨率重建，历史保留，但两套G-Buffer都是新分配的
+    postProcessor->InvalidatePrevGeometry();
+    aoManager->Resize(width, height);
+    costHeatmap.Resize(width, height);
+
+    // 创建几何缓冲区：两套交替写入，上一帧的一套直接用于TAA遮挡检测，无需每帧拷贝
+    gpuMemory.DeleteTextures(2, gDepthTex);
+    gpuMemory.DeleteTextures(2, gNormalTex);
+    glGenTextures(2, gDepthTex);
+    glGenTextures(2, gNormalTex);
+    for (int i = 0; i < 2; i++) {
+        glBindTexture(GL_TEXTURE_2D, gDepthTex[i]);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_R32F, width, height, 0, GL_RED, GL_FLOAT, nullptr);
+        gpuMemory.TrackTexture(gDepthTex[i], "GBuffer", "Depth " + std::to_string(i), GL_R32F, width, height);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glBindTexture(GL_TEXTURE_2D, gNormalTex[i]);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RG16_SNORM, width, height, 0, GL_RG, GL_SHORT, nullptr);
+        gpuMemory.TrackTexture(gNormalTex[i], "GBuffer", "Normal " + std::to_string(i), GL_RG16_SNORM, width, height);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    }
 }
 
 void ForwardShadingPipline::Render()
@@ -138,19 +167,51 @@ void ForwardShadingPipline::Render()
         glfwGetFramebufferSize(window, &fbWidth, &fbHeight);
         glViewport(0, 0, fbWidth, fbHeight);
 
-        static int frameCount = 0;
-        int currentHistory = frameCount % 2;
-
-        imguiManager.BeginFrame();
-        imguiManager.HandleCameraMovement(camera, deltaTime);
-        imguiManager.DrawFPS();
-        imguiManager.DrawObjectsList(ssbo);
-        imguiManager.DrawLightController(lightSSBO);
-        imguiManager.DrawCameraControls(camera);
-        imguiManager.LoadSave(ssbo, lightSSBO);
-        imguiManager.DrawTAASettings();
-        imguiManager.ChooseSkybox();
-        aoManager->DrawUI();
+        gProfiler.BeginFrame();
+        gpuCounters.BeginFrame(gProfiler.GetFrameIndex());
+        gpuMemory.BeginFrame();
+
+        {
+            // UI本身只有CPU开销，其中的SSBO上传和天空盒转换单独计GPU时间
+            PerformanceProfiler::Scope uiScope(gProfiler, "UI", false);
+            imguiManager.BeginFrame();
+            imguiManager.HandleCameraMovement(camera, deltaTime);
+            imguiManager.DrawFPS();
+            imguiManager.DrawObjectsList(ssbo);
+            imguiManager.DrawLightController(lightSSBO);
+            imguiManager.DrawCameraControls(camera);
+            imguiManager.LoadSave(ssbo, lightSSBO);
+            imguiManager.DrawTAASettings();
+            imguiManager.ChooseSkybox();
+            aoManager->DrawUI();
+            pathController.DrawUI();
+            resolutionController.DrawUI(WIDTH, HEIGHT);
+            probeVolume.DrawUI();
+            bloomManager->DrawUI();
+            postProcessor->DrawUI();
+            costHeatmap.DrawUI();
+            gpuMemory.DrawUI();
+            frameCapture.DrawUI(gProfiler.GetFrameIndex());
+        }
+        // 回放：整帧输入来自捕获文件；基准测试：相机由路径驱动
+        if (frameCapture.GetFrameCount() > 0) {
+            // 预热期间停在第0帧，记录窗口从第0帧起按顺序播放，只有--frames超过捕获长度时才循环
+            const long long replayFrame = std::max(gProfiler.GetFrameIndex() - benchmarkOptions.warmupFrames, 0LL);
+            ApplyCapturedFrame(static_cast<int>(replayFrame % frameCapture.GetFrameCount()));
+        }
+        else if (benchmark) benchmark->ApplyCamera(gProfiler.GetFrameIndex(), camera);
+        int currentGBuffer = frameCount % 2;
+        int previousGBuffer = 1 - currentGBuffer;
+
+        // 动态分辨率：缩放变化时重建渲染目标（普通TAA和RTAO历史随之重置，TAAU历史保留）
+        const bool taau = imguiManager.IsTAAEnabled() && postProcessor->upscale;
+        resolutionController.SetUpscaling(taau);
+        glm::ivec2 renderSize = resolutionController.GetRenderSize(WIDTH, HEIGHT);
+        glm::ivec2 postSize = taau ? glm::ivec2(WIDTH, HEIGHT) : renderSize;
+        ResizeRenderTargets(renderSize.x, renderSize.y, postSize.x, postSize.y);
+        if (frameCapture.IsRecording()) frameCapture.Record(CaptureFrame(), ssbo.objects, lightSSBO.lights);
+        // TAAU：全屏统一的亚像素抖动，上采样时按采样位置重建
+        const glm::vec2 jitter = taau ? postProcessor->NextJitter(renderWidth, renderHeight) : glm::vec2(0.0f);
 
         raytracingShader.use();
         raytracingShader.setInt("numObjects", ssbo.objects.size());
@@ -161,111 +222,325 @@ void ForwardShadingPipline::Render()
         raytracingShader.setVec3("cameraRight", camera.Right);
         raytracingShader.setFloat("fov", camera.FOV);
         raytracingShader.setInt("frameCount", frameCount);
+        glm::mat4 viewProj = camera.GetProjectionMatrix((float)WIDTH / HEIGHT) * camera.GetViewMatrix();
+        raytracingShader.setMat4("prevViewProj", frameCount > 0 ? prevViewProj : viewProj);
         raytracingShader.setVec2("noiseScale", glm::vec2(1.0f / 1024.0f));
+        raytracingShader.setInt("maxRayDepth", pathController.maxDepth);
+        raytracingShader.setInt("rouletteStartDepth", pathController.rouletteStart);
+        raytracingShader.setBool("collectPathStats", pathController.collectStats);
+        raytracingShader.setBool("collectRayCounters", gpuCounters.IsCollecting());
+        raytracingShader.setBool("useFixedJitter", taau);
+        raytracingShader.setVec2("jitterOffset", jitter);
 
         raytracingShader.setBool("useSkybox", imguiManager.IsSkyboxEnabled());
+        raytracingShader.setBool("useEnvSampling", imguiManager.IsSkyboxEnabled() && imguiManager.IsEnvSamplingEnabled());
+        raytracingShader.setIVec2("envDistSize", glm::ivec2(imguiManager.GetEnvironmentSampler().width, imguiManager.GetEnvironmentSampler().height));
         if (imguiManager.IsSkyboxEnabled()) {
             glActiveTexture(GL_TEXTURE0);
             glBindTexture(GL_TEXTURE_CUBE_MAP, imguiManager.GetCurrentSkyboxTexture());
         }
 
-        gProfiler.BeginFrame();
-        gProfiler.BeginGPUSection(PerformanceProfiler::Stage::RayTracing);
-
-        glDispatchCompute(
-            (WIDTH + 15) / 16,  // ȡ
-            (HEIGHT + 15) / 16,
-            1
-        );
-        glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
-
-        gProfiler.EndGPUSection(PerformanceProfiler::Stage::RayTracing);
-
-        // AO
-        aoManager->Render(gPositionTex, gNormalTex,
-            camera.GetViewMatrix(),
-            camera.GetProjectionMatrix((float)WIDTH / HEIGHT));
-
-        // ------------------------- Bloom -------------------------
-        // 1: ȡ
-        gProfiler.BeginGPUSection(PerformanceProfiler::Stage::BloomExtract);
-
-        glBindFramebuffer(GL_FRAMEBUFFER, bloomFBOs[0]);
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-        extractShader.use();
-        extractShader.setFloat("threshold", 1.0f); // ֵ
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, outputTex);
-        RenderQuad(); // Ⱦȫı
-
-        gProfiler.EndGPUSection(PerformanceProfiler::Stage::BloomExtract);
-
-        // 2: ˹ģˮƽʹֱģԽЧԽƽ
-        gProfiler.BeginGPUSection(PerformanceProfiler::Stage::BloomBlur);
-
-        bool horizontal = true;
-        blurShader.use();
-        for (int i = 0; i < 10; i++) { // ģ10Σ
-            glBindFramebuffer(GL_FRAMEBUFFER, bloomFBOs[horizontal]);
-            blurShader.setBool("horizontal", horizontal);
-            glActiveTexture(GL_TEXTURE0);
-            glBindTexture(GL_TEXTURE_2D, bloomTextures[!horizontal]);
-            RenderQuad();
-            horizontal = !horizontal;
-        }
-
-        gProfiler.EndGPUSection(PerformanceProfiler::Stage::BloomBlur);
-
-        // 3: ϲBloomЧ
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-        bloomCombineShader.use();
-        bloomCombineShader.setFloat("bloomStrength", 0.5f); // Bloomǿ
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, outputTex); // ԭʼ
-        glActiveTexture(GL_TEXTURE1);
-        glBindTexture(GL_TEXTURE_2D, bloomTextures[!horizontal]); // ģĸ߹
-        RenderQuad();
-
-        // TAA
-        gProfiler.BeginGPUSection(PerformanceProfiler::Stage::TAA);
-        if (imguiManager.IsTAAEnabled()) {
-            glBindFramebuffer(GL_FRAMEBUFFER, taaFBO);
-            glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, historyTex[currentHistory], 0);
-
-            taaShader.use();
-            taaShader.setFloat("uBlendFactor", imguiManager.GetTAABlendFactor());
-            taaShader.setInt("uCurrentFrame", 0);
-            taaShader.setInt("uHistory", 1);
-            taaShader.setInt("gNormal", 2);
-            taaShader.setFloat("uJitterX", haltonSequence(frameCount % 8, 2) * 0.5 / WIDTH);
-            taaShader.setFloat("uJitterY", haltonSequence(frameCount % 8, 3) * 0.5 / HEIGHT);
-
-            glActiveTexture(GL_TEXTURE0);
-            glBindTexture(GL_TEXTURE_2D, outputTex); // ǰ֡
-            glActiveTexture(GL_TEXTURE1);
-            glBindTexture(GL_TEXTURE_2D, historyTex[1 - currentHistory]); // һ֡
-            glActiveTexture(GL_TEXTURE2);
-            glBindTexture(GL_TEXTURE_2D, gNormalTex);
-
-            RenderQuad();
-
-            // ʷ
-            frameCount++;
-            glBindFramebuffer(GL_FRAMEBUFFER, 0);
-            glBindTexture(GL_TEXTURE_2D, historyTex[currentHistory]);
-            glGenerateMipmap(GL_TEXTURE_2D); // ѡMipmap֡
+        // RTAO会在同一着色器中读回G-Buffer，因此以读写方式绑定
+        glBindImageTexture(1, gDepthTex[currentGBuffer], 0, GL_FALSE, 0, GL_READ_WRITE, GL_R32F);
+        glBindImageTexture(2, gNormalTex[currentGBuffer], 0, GL_FALSE, 0, GL_READ_WRITE, GL_RG16_SNORM);
 
+        {
+            PerformanceProfiler::Scope graphScope(gProfiler, "RenderGraph");
+            BuildRenderGraph(currentGBuffer, previousGBuffer);
+            renderGraph.Compile();
+            renderGraph.Execute(gProfiler);
         }
-        gProfiler.EndGPUSection(PerformanceProfiler::Stage::TAA);
+        gpuCounters.EndFrame();
+        renderGraph.DrawUI();
+        renderGraph.Reset();
+        prevViewProj = viewProj;
 
-        gProfiler.EndFrame(deltaTime * 1000.0f);
         gProfiler.DrawImGuiPanel();
+        {
+            PerformanceProfiler::Scope imguiScope(gProfiler, "ImGuiRender");
+            imguiManager.EndFrame();
+        }
 
-        imguiManager.EndFrame();
+        frameCount++;
+        gProfiler.EndFrame(deltaTime * 1000.0f);
+        // GPU计时异步回读，只在拿到新结果时驱动控制器
+        if (gProfiler.HasNewResults()) {
+            // 两个控制器共用一个预算：分辨率优先调整，到达缩放上下限后才改变路径长度
+            // （判断放在分辨率更新前，避免同一次结果让两者同时调整）
+            const double rayTracingMs = gProfiler.GetGPUTime("RayTracing");
+            const bool pathMayReduce = !resolutionController.CanScaleDown();
+            const bool pathMayGrow = !resolutionController.CanScaleUp();
+            resolutionController.Update(rayTracingMs);
+            pathController.Update(rayTracingMs, resolutionController.targetMs, pathMayReduce, pathMayGrow);
+            aoManager->RecordTiming(gProfiler.GetGPUTime("AO"));
+        }
+        if (benchmark && benchmark->Update(gProfiler)) glfwSetWindowShouldClose(window, GLFW_TRUE);
 
         glfwSwapBuffers(window);
         glfwPollEvents();
 
     }
 }
+
+FrameCapture::Frame ForwardShadingPipline::CaptureFrame() const
+{
+    FrameCapture::Frame frame;
+    frame.frameCount = frameCount;
+    frame.position = camera.Position;
+    frame.front = camera.Front;
+    frame.up = camera.Up;
+    frame.right = camera.Right;
+    frame.fov = camera.FOV;
+    frame.yaw = camera.Yaw;
+    frame.pitch = camera.Pitch;
+    frame.prevViewProj = prevViewProj;
+    frame.renderScale = resolutionController.scale;
+    frame.maxDepth = pathController.maxDepth;
+    frame.rouletteStart = pathController.rouletteStart;
+    frame.costMode = static_cast<int>(costHeatmap.mode);
+    frame.sceneFormat = static_cast<int>(postProcessor->sceneFormat);
+    frame.historyFormat = static_cast<int>(postProcessor->historyFormat);
+    frame.taa = imguiManager.IsTAAEnabled();
+    frame.taau = postProcessor->upscale;
+    frame.jitterIndex = postProcessor->GetJitterIndex();
+    frame.taaBlend = imguiManager.GetTAABlendFactor();
+    frame.skybox = imguiManager.IsSkyboxEnabled();
+    frame.skyboxIndex = imguiManager.GetSkyboxIndex();
+    frame.envSampling = imguiManager.IsEnvSamplingEnabled();
+    frame.aoEnabled = aoManager->enableAO;
+    frame.aoMode = static_cast<int>(aoManager->mode);
+    frame.aoKernelSize = aoManager->kernelSize;
+    frame.aoResolutionDivisor = aoManager->resolutionDivisor;
+    frame.rtaoRays = aoManager->rtaoRays;
+    frame.aoStrength = aoManager->aoStrength;
+    frame.ssaoRadius = aoManager->radius;
+    frame.ssaoBias = aoManager->bias;
+    frame.rtaoRadius = aoManager->rtaoRadius;
+    frame.rtaoMaxHistory = aoManager->rtaoMaxHistory;
+    frame.bloomMode = static_cast<int>(bloomManager->mode);
+    frame.bloomStrength = bloomManager->bloomStrength;
+    frame.bloomThreshold = bloomManager->threshold;
+    frame.bloomMipLevels = bloomManager->mipLevels;
+    frame.bloomSoftKnee = bloomManager->softKnee;
+    frame.bloomFilterRadius = bloomManager->filterRadius;
+    frame.bloomComputeBlur = bloomManager->useComputeBlur;
+    frame.probes = probeVolume.enabled;
+    frame.probeRaysPerProbe = probeVolume.raysPerProbe;
+    frame.probeRayBudget = probeVolume.rayBudget;
+    frame.probeHysteresis = probeVolume.hysteresis;
+    frame.exposure = postProcessor->exposure;
+    return frame;
+}
+
+void ForwardShadingPipline::ApplyCapturedFrame(int index)
+{
+    const FrameCapture::Frame& frame = frameCapture.GetFrame(index);
+    frameCount = frame.frameCount;
+    camera.Position = frame.position;
+    camera.Front = frame.front;
+    camera.Up = frame.up;
+    camera.Right = frame.right;
+    camera.FOV = frame.fov;
+    camera.Yaw = frame.yaw;
+    camera.Pitch = frame.pitch;
+    prevViewProj = frame.prevViewProj;
+
+    // 控制器在回放时保持关闭，直接使用录制时的取值
+    pathController.maxDepth = frame.maxDepth;
+    pathController.rouletteStart = frame.rouletteStart;
+    resolutionController.scale = frame.renderScale;
+    costHeatmap.mode = static_cast<CostHeatmap::Mode>(frame.costMode);
+    imguiManager.SetTAA(frame.taa != 0, frame.taaBlend);
+    postProcessor->sceneFormat = static_cast<HDRFormat>(frame.sceneFormat);
+    postProcessor->SetHistorySettings(frame.taau != 0, static_cast<HDRFormat>(frame.historyFormat));
+    postProcessor->SetJitterIndex(frame.jitterIndex);
+    postProcessor->exposure = frame.exposure;
+    imguiManager.SetSkyboxEnabled(frame.skybox != 0, frame.envSampling != 0);
+    imguiManager.SelectSkybox(frame.skyboxIndex);
+
+    aoManager->enableAO = frame.aoEnabled != 0;
+    aoManager->mode = static_cast<AOManager::Mode>(frame.aoMode);
+    aoManager->kernelSize = frame.aoKernelSize;
+    aoManager->SetResolutionDivisor(frame.aoResolutionDivisor);
+    aoManager->rtaoRays = frame.rtaoRays;
+    aoManager->aoStrength = frame.aoStrength;
+    aoManager->radius = frame.ssaoRadius;
+    aoManager->bias = frame.ssaoBias;
+    aoManager->rtaoRadius = frame.rtaoRadius;
+    aoManager->rtaoMaxHistory = frame.rtaoMaxHistory;
+    bloomManager->mode = static_cast<BloomManager::Mode>(frame.bloomMode);
+    bloomManager->bloomStrength = frame.bloomStrength;
+    bloomManager->threshold = frame.bloomThreshold;
+    bloomManager->mipLevels = frame.bloomMipLevels;
+    bloomManager->softKnee = frame.bloomSoftKnee;
+    bloomManager->filterRadius = frame.bloomFilterRadius;
+    bloomManager->useComputeBlur = frame.bloomComputeBlur != 0;
+    probeVolume.enabled = frame.probes != 0;
+    probeVolume.raysPerProbe = frame.probeRaysPerProbe;
+    probeVolume.rayBudget = frame.probeRayBudget;
+    probeVolume.hysteresis = frame.probeHysteresis;
+
+    // 场景快照与上一次回放的帧不同时才上传（预热停在第0帧时不会每帧重复上传）
+    if (frameCapture.GetSceneIndex(index) != replayScene) {
+        replayScene = frameCapture.GetSceneIndex(index);
+        const FrameCapture::Scene& scene = frameCapture.GetScene(index);
+        imguiManager.SetScene(scene.objects, scene.lights, ssbo, lightSSBO);
+    }
+}
+
+void ForwardShadingPipline::BuildRenderGraph(int currentGBuffer, int previousGBuffer)
+{
+    using Access = RenderGraph::Access;
+    using Handle = RenderGraph::ResourceHandle;
+    using Builder = RenderGraph::PassBuilder;
+
+    const bool taaEnabled = imguiManager.IsTAAEnabled();
+    const bool useAO = aoManager->enableAO && aoManager->aoStrength > 0.0f;
+    const bool useBloom = bloomManager->bloomStrength > 0.0f;
+    const bool useProbes = probeVolume.enabled;
+    const GLuint brightTex = useBloom ? bloomManager->GetBrightTexture() : 0;
+    const bool rtao = aoManager->mode == AOManager::Mode::RTAO;
+    const GLenum sceneFormat = postProcessor->GetSceneGLFormat();
+
+    // 外部持有的纹理
+    Handle depth = renderGraph.Import("gDepth", gDepthTex[currentGBuffer]);
+    Handle normal = renderGraph.Import("gNormal", gNormalTex[currentGBuffer]);
+    Handle prevDepth = renderGraph.Import("gDepthPrev", gDepthTex[previousGBuffer]);
+    Handle prevNormal = renderGraph.Import("gNormalPrev", gNormalTex[previousGBuffer]);
+    Handle irradiance = renderGraph.Import("ProbeIrradiance", probeVolume.GetIrradianceTexture());
+    Handle distance = renderGraph.Import("ProbeDistance", probeVolume.GetDistanceTexture());
+    Handle bloom = renderGraph.Import("Bloom", bloomManager->GetBloomTexture());
+    Handle bright = brightTex ? renderGraph.Import("BloomBright", brightTex) : -1;
+    Handle cost = renderGraph.Import("CostMap", costHeatmap.GetTexture());
+
+    // 瞬态纹理（渲染分辨率）
+    Handle color = renderGraph.Create("SceneColor", { renderWidth, renderHeight, sceneFormat, GL_LINEAR });
+    Handle motion = renderGraph.Create("Motion", { renderWidth, renderHeight, GL_RG16F, GL_NEAREST });
+    Handle ao = renderGraph.Create("AO", { renderWidth, renderHeight, GL_R8, GL_NEAREST });
+    // TAA开启时场景为新的历史，否则直接使用光追输出
+    Handle scene = taaEnabled ? renderGraph.Import("TAAHistory", postProcessor->GetResolveTarget()) : color;
+
+    // 探针更新：固定光线预算，复用光追着色器
+    renderGraph.AddPass("ProbeUpdate",
+        [&](Builder& pass) {
+            if (!useProbes) return;
+            pass.Read(irradiance, Access::ImageRead);
+            pass.Read(distance, Access::ImageRead);
+            pass.Write(irradiance, Access::ImageWrite);
+            pass.Write(distance, Access::ImageWrite);
+        },
+        [this](RenderGraph&) { probeVolume.Update(raytracingShader); });
+
+    // G-Buffer跨帧使用、路径统计写入SSBO，因此光追pass不参与剔除
+    renderGraph.AddPass("RayTracing",
+        [&](Builder& pass) {
+            if (useProbes) {
+                pass.Read(irradiance);
+                pass.Read(distance);
+            }
+            pass.Write(color);
+            pass.Write(depth);
+            pass.Write(normal);
+            pass.Write(motion);
+            if (costHeatmap.IsEnabled()) pass.Write(cost);
+            pass.SideEffect();
+        },
+        [this, color, motion, sceneFormat](RenderGraph& graph) {
+            raytracingShader.use();
+            probeVolume.Bind(raytracingShader);
+            costHeatmap.Bind(raytracingShader);
+            glBindImageTexture(0, graph.GetTexture(color), 0, GL_FALSE, 0, GL_WRITE_ONLY, sceneFormat);
+            glBindImageTexture(3, graph.GetTexture(motion), 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_RG16F);
+            pathController.BeginFrame();
+            glDispatchCompute(
+                (renderWidth + 31) / 32,  // 向上取整，与local_size(32x32)一致
+                (renderHeight + 31) / 32,
+                1
+            );
+            pathController.EndFrame();
+        });
+
+    // HDR格式精度测试：读回本帧RGBA32F的光追输出
+    renderGraph.AddPass("PrecisionBenchmark",
+        [&](Builder& pass) {
+            if (!postProcessor->IsBenchmarkRequested()) return;
+            pass.Read(color);
+            pass.SideEffect();
+        },
+        [this, color](RenderGraph& graph) {
+            postProcessor->RunPrecisionBenchmark(graph.GetTexture(color), renderWidth, renderHeight, imguiManager.GetTAABlendFactor());
+        });
+
+    // AO（低分辨率计算，结果在最终合成时应用）
+    renderGraph.AddPass("AO",
+        [&](Builder& pass) {
+            if (!aoManager->enableAO) return;
+            pass.Read(depth, rtao ? Access::ImageRead : Access::Sampled);
+            pass.Read(normal, rtao ? Access::ImageRead : Access::Sampled);
+            if (rtao) {
+                pass.Read(motion);
+                pass.Read(prevDepth);
+            }
+            pass.Write(ao, Access::Attachment);
+        },
+        [this, currentGBuffer, previousGBuffer, motion, ao](RenderGraph& graph) {
+            aoManager->Render(gDepthTex[currentGBuffer], gNormalTex[currentGBuffer],
+                graph.GetTexture(motion), gDepthTex[previousGBuffer], camera.GetViewMatrix(),
+                camera.GetProjectionMatrix((float)WIDTH / HEIGHT), prevViewProj, raytracingShader, graph.GetTexture(ao));
+        });
+
+    // TAA解析 + 亮度提取：先在HDR空间做时域累积，Bloom使用累积后的结果
+    renderGraph.AddPass("Resolve",
+        [&](Builder& pass) {
+            if (!taaEnabled && !brightTex) return;
+            pass.Read(color);
+            if (taaEnabled) {
+                pass.Read(depth);
+                pass.Read(normal);
+                pass.Read(motion);
+                pass.Read(prevDepth);
+                pass.Read(prevNormal);
+                pass.Write(scene);
+            }
+            if (brightTex) pass.Write(bright);
+        },
+        [this, currentGBuffer, previousGBuffer, color, motion, taaEnabled, brightTex](RenderGraph& graph) {
+            postProcessor->Resolve(graph.GetTexture(color), gDepthTex[currentGBuffer], gNormalTex[currentGBuffer], graph.GetTexture(motion),
+                gDepthTex[previousGBuffer], gNormalTex[previousGBuffer],
+                camera.GetViewMatrix(), camera.GetProjectionMatrix((float)WIDTH / HEIGHT), prevViewProj,
+                taaEnabled, imguiManager.GetTAABlendFactor(), brightTex, bloomManager->threshold);
+        });
+
+    // Bloom模糊（各阶段耗时由BloomManager自己记录）
+    renderGraph.AddPass("Bloom",
+        [&](Builder& pass) {
+            if (!useBloom) return;
+            if (brightTex) pass.Read(bright);
+            else pass.Read(scene);
+            const bool computeBlur = bloomManager->mode == BloomManager::Mode::Gaussian && bloomManager->useComputeBlur;
+            pass.Write(bloom, computeBlur ? Access::ImageWrite : Access::Attachment);
+        },
+        [this, scene](RenderGraph& graph) { bloomManager->Render(graph.GetTexture(scene), gProfiler); });
+
+    // 合并AO、Bloom效果 + 色调映射到最终输出
+    renderGraph.AddPass("Composite",
+        [&](Builder& pass) {
+            pass.Read(scene);
+            if (useBloom) pass.Read(bloom);
+            if (useAO) pass.Read(ao);
+            pass.SideEffect();
+        },
+        [this, useBloom, useAO, scene, ao](RenderGraph& graph) {
+            postProcessor->Composite(graph.GetTexture(scene), useBloom ? bloomManager->GetBloomTexture() : 0, useBloom ? bloomManager->GetCombineStrength() : 0.0f,
+                useAO ? graph.GetTexture(ao) : 0, aoManager->aoStrength);
+        });
+
+    // 开销热力图：叠加在合成结果上
+    renderGraph.AddPass("CostOverlay",
+        [&](Builder& pass) {
+            if (!costHeatmap.IsEnabled()) return;
+            pass.Read(cost, Access::Sampled);
+            pass.SideEffect();
+        },
+        [this](RenderGraph&) { costHeatmap.Render(); });
+}
@@ -3,6 +3,18 @@
 #include "ImGUIManager.h"
 #include "SSBO.h"
 #include "PerformanceProfiler.h"
+#include "GPUCounters.h"
+#include "SobolSampler.h"
+#include "PathLengthController.h"
+#include "ResolutionController.h"
+#include "ProbeVolume.h"
+#include "CostHeatmap.h"
+#include "Bloom.h"
+#include "PostProcess.h"
+#include "RenderGraph.h"
+#include "Benchmark.h"
+#include "GPUMemoryTracker.h"
+#include "FrameCapture.h"
 #include <GLFW/glfw3.h>
 
 class ForwardShadingPipline {
@@ -11,38 +23,50 @@ private:
 	ImGuiManager imguiManager;
 	SSBO ssbo;
 	LightSSBO lightSSBO;
+	SobolSampler sobolSampler;
+	PathLengthController pathController;
+	ResolutionController resolutionController;
+	ProbeVolume probeVolume;
+	CostHeatmap costHeatmap;
 	// GPU Time Query
 	PerformanceProfiler gProfiler;
+	GPUCounters gpuCounters;
+	RenderGraph renderGraph;
 
-	GLuint blueNoiseTex;
+	GLuint blueNoiseTex = 0;
 	Shader raytracingShader;
 	// display
 	Shader outputShader;
-	GLuint outputTex;
 	// bloom
-	GLuint bloomFBOs[2], bloomTextures[2];
-	Shader extractShader; 
-	Shader blurShader; 
-	Shader bloomCombineShader; 
-	// TAA ʷ
-	GLuint historyTex[2]; // ˫
-	GLuint taaFBO;
-	Shader taaShader;
+	BloomManager* bloomManager = nullptr;
+	// 后处理：TAA解析 + 亮度提取 / Bloom合成 + 色调映射
+	PostProcessor* postProcessor = nullptr;
+	glm::mat4 prevViewProj = glm::mat4(1.0f);
+	int frameCount = 0;
 	// AO
 	AOManager* aoManager = nullptr;
-	GLuint gPositionTex, gNormalTex; // λ
-
+	// 几何缓冲区，按帧交替，上一帧用于TAA遮挡检测
+	// 线性深度R32F + 八面体法线RG16_SNORM（8字节/像素），位置由逆投影重建
+	GLuint gDepthTex[2] = {}, gNormalTex[2] = {};
+	// 渲染分辨率（光追、G-Buffer、AO、TAA），输出分辨率为WIDTH x HEIGHT
+	int renderWidth = 0, renderHeight = 0;
+	// 基准测试模式（--benchmark）
+	BenchmarkOptions benchmarkOptions;
+	Benchmark* benchmark = nullptr;
+	// 帧捕获 / 回放（--replay）
+	FrameCapture frameCapture;
+	int replayScene = -1;           // 最近一次上传的场景快照
 
 public:
-	ForwardShadingPipline() { Init(); }
+	ForwardShadingPipline(const BenchmarkOptions& options = BenchmarkOptions()) : benchmarkOptions(options) { Init(); }
 	~ForwardShadingPipline() {
-		glDeleteTextures(1, &outputTex);
-		glDeleteFramebuffers(2, bloomFBOs);
-		glDeleteTextures(2, bloomTextures);
-		glDeleteFramebuffers(1, &taaFBO);
-		glDeleteTextures(2, historyTex);
-		glDeleteTextures(1, &gPositionTex);
-		glDeleteTextures(1, &gNormalTex);
+		delete bloomManager;
+		delete postProcessor;
+		delete aoManager;
+		delete benchmark;
+		gpuMemory.DeleteTextures(2, gDepthTex);
+		gpuMemory.DeleteTextures(2, gNormalTex);
+		gpuMemory.DeleteTextures(1, &blueNoiseTex);
 
 		glfwTerminate();
 	}
@@ -50,10 +74,21 @@ public:
 	void InitFWEW();
 	void InitBlueNoiseTex();
 	void InitShdaer();
-	void InitOutputTex();
 	void InitBloom();
-	void InitTAA();
+	void InitPostProcess();
 	void InitAO();
+	// 加载基准场景，关闭自适应控制器以固定每帧工作量
+	void InitBenchmark();
+	// 渲染分辨率或TAA之后的分辨率变化时重建G-Buffer和各后处理的渲染目标
+	void ResizeRenderTargets(int width, int height, int postWidth, int postHeight);
 
 	void Render();
+	// 基准测试的结果（0 = 通过，1 = 有回归，2 = 出错），交互模式下为0
+	int GetExitCode() const { return benchmark ? benchmark->GetExitCode() : 0; }
+	// 声明本帧的渲染图（光追输出和运动向量为瞬态纹理）
+	void BuildRenderGraph(int currentGBuffer, int previousGBuffer);
+	// 本帧的渲染输入（在NextJitter之前调用）
+	FrameCapture::Frame CaptureFrame() const;
+	// 回放：把捕获的一帧写回相机、控制器和各模块的参数
+	void ApplyCapturedFrame(int index);
 };
\ No newline at end of file
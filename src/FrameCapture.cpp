@@ -0,0 +1,212 @@
+// FrameCapture.cpp
+#include "FrameCapture.h"
+#include "global.h"
+#include "AO.h"
+#include "Bloom.h"
+#include "CostHeatmap.h"
+#include "HDRPrecision.h"
+#include "PathLengthController.h"
+#include "ProbeVolume.h"
+#include "ResolutionController.h"
+#include <imgui.h>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+
+template <typename T>
+static bool SameBytes(const std::vector<T>& a, const std::vector<T>& b) {
+    return a.size() == b.size() && (a.empty() || std::memcmp(a.data(), b.data(), a.size() * sizeof(T)) == 0);
+}
+
+template <typename T>
+static void WriteArray(std::ofstream& file, const std::vector<T>& values) {
+    const uint32_t count = static_cast<uint32_t>(values.size());
+    file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    if (count) file.write(reinterpret_cast<const char*>(values.data()), count * sizeof(T));
+}
+
+// 长度来自文件，超过剩余字节数的视为损坏，不按它分配内存
+template <typename T>
+static bool ReadArray(std::ifstream& file, std::streamoff fileSize, std::vector<T>& values) {
+    uint32_t count = 0;
+    if (!file.read(reinterpret_cast<char*>(&count), sizeof(count))) return false;
+    if (static_cast<uint64_t>(count) * sizeof(T) > static_cast<uint64_t>(fileSize - file.tellg())) return false;
+    values.resize(count);
+    return count == 0 || file.read(reinterpret_cast<char*>(values.data()), count * sizeof(T)).good();
+}
+
+template <typename T>
+static bool InRange(T value, T min, T max) {
+    return value >= min && value <= max;    // NaN同样不通过
+}
+
+// 返回第一个越界字段的名称，全部有效时返回nullptr
+static const char* FindInvalidField(const FrameCapture::Frame& f, int skyboxCount) {
+    if (f.frameCount < 0) return "frameCount";
+    if (!InRange(f.fov, 1.0f, 179.0f)) return "fov";
+    if (!InRange(f.renderScale, ResolutionController::MIN_SCALE, ResolutionController::MAX_SCALE)) return "renderScale";
+    if (!InRange(f.maxDepth, 1, PathLengthController::MAX_PATH_LENGTH)) return "maxDepth";
+    if (!InRange(f.rouletteStart, 0, f.maxDepth)) return "rouletteStart";
+    if (!InRange(f.costMode, 0, static_cast<int>(CostHeatmap::Mode::Count) - 1)) return "costMode";
+    if (!InRange(f.sceneFormat, 0, static_cast<int>(HDRFormat::Count) - 1)) return "sceneFormat";
+    if (!InRange(f.historyFormat, 0, static_cast<int>(HDRFormat::Count) - 1)) return "historyFormat";
+    if (f.jitterIndex < 0) return "jitterIndex";
+    if (!InRange(f.skyboxIndex, 0, skyboxCount - 1)) return "skyboxIndex";
+    if (!InRange(f.aoMode, 0, static_cast<int>(AOManager::Mode::RTAO))) return "aoMode";
+    if (!InRange(f.aoKernelSize, 1, AOManager::MAX_KERNEL_SIZE)) return "aoKernelSize";
+    if (f.aoResolutionDivisor != 1 && f.aoResolutionDivisor != 2 && f.aoResolutionDivisor != 4) return "aoResolutionDivisor";
+    if (!InRange(f.rtaoRays, 1, 4)) return "rtaoRays";
+    if (!InRange(f.rtaoMaxHistory, 1, 64)) return "rtaoMaxHistory";
+    if (!InRange(f.bloomMode, 0, static_cast<int>(BloomManager::Mode::Gaussian))) return "bloomMode";
+    if (f.bloomMipLevels < 1) return "bloomMipLevels";
+    if (!InRange(f.probeRaysPerProbe, 1, ProbeVolume::MAX_RAYS_PER_PROBE)) return "probeRaysPerProbe";
+    if (f.probeRayBudget < 1) return "probeRayBudget";
+    return nullptr;
+}
+
+FrameCapture::~FrameCapture() {
+    Stop();
+}
+
+bool FrameCapture::Start(const std::string& path) {
+    Stop();
+    m_File.open(path, std::ios::binary | std::ios::trunc);
+    if (!m_File.is_open()) {
+        m_Status = "Failed to open " + path;
+        return false;
+    }
+
+    Header header;
+    header.width = WIDTH;
+    header.height = HEIGHT;
+    m_File.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    m_Path = path;
+    m_RecordedFrames = 0;
+    m_Bytes = sizeof(header);
+    m_HasScene = false;
+    m_Status.clear();
+    return true;
+}
+
+void FrameCapture::Record(const Frame& frame, const std::vector<Object>& objects, const std::vector<Light>& lights) {
+    if (!IsRecording()) return;
+
+    // 场景只在变化时写入（第一帧总是写入）
+    const uint32_t hasScene = !m_HasScene || !SameBytes(objects, m_LastObjects) || !SameBytes(lights, m_LastLights);
+    m_File.write(reinterpret_cast<const char*>(&frame), sizeof(frame));
+    m_File.write(reinterpret_cast<const char*>(&hasScene), sizeof(hasScene));
+    m_Bytes += sizeof(frame) + sizeof(hasScene);
+    if (hasScene) {
+        WriteArray(m_File, objects);
+        WriteArray(m_File, lights);
+        m_Bytes += 2 * sizeof(uint32_t) + objects.size() * sizeof(Object) + lights.size() * sizeof(Light);
+        m_LastObjects = objects;
+        m_LastLights = lights;
+        m_HasScene = true;
+    }
+
+    m_RecordedFrames++;
+    if (captureFrames > 0 && m_RecordedFrames >= captureFrames) Stop();
+}
+
+void FrameCapture::Stop() {
+    if (!IsRecording()) return;
+
+    // 回填帧数
+    const uint32_t frameCount = static_cast<uint32_t>(m_RecordedFrames);
+    m_File.seekp(offsetof(Header, frameCount));
+    m_File.write(reinterpret_cast<const char*>(&frameCount), sizeof(frameCount));
+    const bool ok = m_File.good();
+    m_File.close();
+
+    m_Status = ok ? "Wrote " + m_Path + " (" + std::to_string(m_RecordedFrames) + " frames, "
+        + std::to_string(m_Bytes / 1024) + " KB)" : "Failed to write " + m_Path;
+    std::cout << "FrameCapture: " << m_Status << std::endl;
+    m_LastObjects.clear();
+    m_LastLights.clear();
+}
+
+bool FrameCapture::Load(const std::string& path, int skyboxCount) {
+    m_Frames.clear();
+    m_FrameScenes.clear();
+    m_Scenes.clear();
+
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        std::cerr << "FrameCapture: failed to open " << path << std::endl;
+        return false;
+    }
+    const std::streamoff fileSize = file.tellg();
+    file.seekg(0);
+
+    Header header, expected;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) || std::memcmp(header.magic, expected.magic, 4) != 0) {
+        std::cerr << "FrameCapture: " << path << " is not a frame capture" << std::endl;
+        return false;
+    }
+    if (header.version != VERSION || header.frameSize != expected.frameSize
+        || header.objectSize != expected.objectSize || header.lightSize != expected.lightSize) {
+        std::cerr << "FrameCapture: " << path << " was written by an incompatible build (version " << header.version << ")" << std::endl;
+        return false;
+    }
+    if (header.width != WIDTH || header.height != HEIGHT) {
+        std::cout << "FrameCapture: captured at " << header.width << "x" << header.height
+            << ", replaying at " << WIDTH << "x" << HEIGHT << std::endl;
+    }
+
+    if (header.frameCount == 0) {
+        std::cerr << "FrameCapture: " << path << " contains no frames" << std::endl;
+        return false;
+    }
+
+    // 每帧至少有Frame和场景标记，帧数超过文件能容纳的上限说明文件被截断或损坏
+    if (static_cast<uint64_t>(header.frameCount) * (sizeof(Frame) + sizeof(uint32_t)) > static_cast<uint64_t>(fileSize - file.tellg())) {
+        std::cerr << "FrameCapture: " << path << " is truncated" << std::endl;
+        return false;
+    }
+
+    m_Frames.resize(header.frameCount);
+    m_FrameScenes.resize(header.frameCount);
+    std::string error = "is truncated";
+    for (uint32_t i = 0; i < header.frameCount; ++i) {
+        uint32_t hasScene = 0;
+        if (!file.read(reinterpret_cast<char*>(&m_Frames[i]), sizeof(Frame))
+            || !file.read(reinterpret_cast<char*>(&hasScene), sizeof(hasScene))) break;
+        if (const char* field = FindInvalidField(m_Frames[i], skyboxCount)) {
+            error = "has an invalid " + std::string(field) + " in frame " + std::to_string(i);
+            break;
+        }
+        if (hasScene) {
+            m_Scenes.emplace_back();
+            if (!ReadArray(file, fileSize, m_Scenes.back().objects) || !ReadArray(file, fileSize, m_Scenes.back().lights)) break;
+        }
+        if (m_Scenes.empty()) break;
+        m_FrameScenes[i] = static_cast<int>(m_Scenes.size()) - 1;
+        if (i + 1 == header.frameCount) return true;
+    }
+
+    std::cerr << "FrameCapture: " << path << " " << error << std::endl;
+    m_Frames.clear();
+    m_FrameScenes.clear();
+    m_Scenes.clear();
+    return false;
+}
+
+void FrameCapture::DrawUI(long long currentFrame) {
+    ImGui::SetNextWindowPos(ImVec2(10, 490), ImGuiCond_FirstUseEver);
+    ImGui::SetNextWindowCollapsed(true, ImGuiCond_FirstUseEver);
+    ImGui::Begin("Frame Capture", &showSettings);
+
+    ImGui::SliderInt("Frames", &captureFrames, 0, 3000, captureFrames == 0 ? "until stopped" : "%d");
+    if (IsRecording()) {
+        ImGui::Text("Recording %s: %d frames, %zu KB", m_Path.c_str(), m_RecordedFrames, m_Bytes / 1024);
+        if (ImGui::Button("Stop")) Stop();
+    }
+    else if (ImGui::Button("Capture")) {
+        Start("capture_" + std::to_string(currentFrame) + ".rtcap");
+    }
+    if (!m_Status.empty()) ImGui::TextWrapped("%s", m_Status.c_str());
+    ImGui::TextDisabled("Replay: opengl_rt --replay <file>");
+
+    ImGui::End();
+}
@@ -0,0 +1,107 @@
+// FrameCapture.h
+#pragma once
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <glm/glm.hpp>
+#include "Object.h"
+#include "Light.h"
+
+// 帧捕获：逐帧记录渲染输入（相机、着色器参数和影响工作量的设置、frameCount、天空盒索引），
+// 场景SSBO内容只在变化的帧写入，整体写成紧凑的二进制文件（.rtcap）。
+// --replay用基准测试模式无头回放这些帧，得到可重复的A/B测量
+class FrameCapture {
+public:
+    static constexpr uint32_t VERSION = 2;
+
+    // 一帧的渲染输入，按原样写入文件（全部为4字节字段，没有填充）
+    struct Frame {
+        int32_t frameCount = 0;
+        // 相机
+        glm::vec3 position = glm::vec3(0.0f), front = glm::vec3(0.0f, 0.0f, -1.0f);
+        glm::vec3 up = glm::vec3(0.0f, 1.0f, 0.0f), right = glm::vec3(1.0f, 0.0f, 0.0f);
+        float fov = 45.0f, yaw = -90.0f, pitch = 0.0f;
+        glm::mat4 prevViewProj = glm::mat4(1.0f);
+        // 光追
+        float renderScale = 1.0f;
+        int32_t maxDepth = 3, rouletteStart = 1;
+        int32_t costMode = 0;                   // 开销热力图（开启时光追额外写入计数）
+        // HDR中间纹理格式（HDRFormat）
+        int32_t sceneFormat = 1, historyFormat = 1;
+        // TAA（jitterIndex为本帧NextJitter之前的相位）
+        int32_t taa = 1, taau = 0, jitterIndex = 0;
+        float taaBlend = 0.1f;
+        // 天空盒
+        int32_t skybox = 1, skyboxIndex = 0, envSampling = 1;
+        // AO
+        int32_t aoEnabled = 1, aoMode = 0, aoKernelSize = 16, aoResolutionDivisor = 2, rtaoRays = 1;
+        float aoStrength = 1.0f;
+        float ssaoRadius = 0.5f, ssaoBias = 0.025f, rtaoRadius = 0.5f;
+        int32_t rtaoMaxHistory = 16;
+        // Bloom
+        int32_t bloomMode = 0;
+        float bloomStrength = 0.5f, bloomThreshold = 1.0f;
+        int32_t bloomMipLevels = 6;
+        float bloomSoftKnee = 0.5f, bloomFilterRadius = 1.0f;
+        int32_t bloomComputeBlur = 1;
+        // 探针
+        int32_t probes = 0, probeRaysPerProbe = 128, probeRayBudget = 16384;
+        float probeHysteresis = 0.97f;
+        // 色调映射
+        float exposure = 1.0f;
+    };
+    static_assert(std::is_trivially_copyable<Frame>::value, "Frame is written as raw bytes");
+
+    struct Scene {
+        std::vector<Object> objects;
+        std::vector<Light> lights;
+    };
+
+    // 参数
+    int captureFrames = 300;    // 0 = 直到手动停止
+    bool showSettings = true;
+
+    ~FrameCapture();
+
+    // 录制：Start之后每帧调用一次Record，录满captureFrames帧后自动结束
+    bool Start(const std::string& path);
+    void Record(const Frame& frame, const std::vector<Object>& objects, const std::vector<Light>& lights);
+    void Stop();
+    bool IsRecording() const { return m_File.is_open(); }
+
+    // 回放：整个文件读入内存，场景快照按帧索引共享。
+    // 数组长度按剩余文件大小检查，枚举、分辨率除数、天空盒索引（0 ~ skyboxCount-1）等字段越界的文件拒绝回放
+    bool Load(const std::string& path, int skyboxCount);
+    int GetFrameCount() const { return static_cast<int>(m_Frames.size()); }
+    const Frame& GetFrame(int index) const { return m_Frames[index]; }
+    const Scene& GetScene(int index) const { return m_Scenes[m_FrameScenes[index]]; }
+    // 该帧使用的场景快照编号，相邻帧编号相同即场景未变化
+    int GetSceneIndex(int index) const { return m_FrameScenes[index]; }
+
+    void DrawUI(long long currentFrame);
+
+private:
+    struct Header {
+        char magic[4] = { 'R', 'T', 'F', 'C' };
+        uint32_t version = VERSION;
+        uint32_t frameSize = sizeof(Frame);     // 结构体大小不一致（不同版本/编译器）的文件拒绝回放
+        uint32_t objectSize = sizeof(Object);
+        uint32_t lightSize = sizeof(Light);
+        int32_t width = 0, height = 0;
+        uint32_t frameCount = 0;                // 录制结束时回填
+    };
+
+    std::ofstream m_File;
+    std::string m_Path, m_Status;
+    int m_RecordedFrames = 0;
+    size_t m_Bytes = 0;
+    std::vector<Object> m_LastObjects;          // 上一次写入的场景，用于判断是否变化
+    std::vector<Light> m_LastLights;
+    bool m_HasScene = false;
+
+    std::vector<Frame> m_Frames;
+    std::vector<int> m_FrameScenes;             // 每帧使用的场景快照
+    std::vector<Scene> m_Scenes;
+};
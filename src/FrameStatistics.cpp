@@ -0,0 +1,208 @@
+// FrameStatistics.cpp
+#include "FrameStatistics.h"
+#include "PerformanceProfiler.h"
+#include <imgui.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+void RollingStats::Reset(int window) {
+    m_Values.assign(std::max(window, 1), 0.0f);
+    m_MaxQueue.assign(m_Values.size(), MaxEntry());
+    m_Head = m_Count = 0;
+    m_MaxFront = m_MaxSize = 0;
+    m_Sequence = 0;
+    m_Latest = 0.0f;
+    std::fill(m_Histogram, m_Histogram + BIN_COUNT, 0);
+}
+
+float RollingStats::BinLowerBound(int bin) {
+    return MIN_MS * std::pow(MAX_MS / MIN_MS, static_cast<float>(bin) / BIN_COUNT);
+}
+
+int RollingStats::BinIndex(float value) {
+    if (value <= MIN_MS) return 0;
+    const int bin = static_cast<int>(std::log(value / MIN_MS) / std::log(MAX_MS / MIN_MS) * BIN_COUNT);
+    return std::clamp(bin, 0, BIN_COUNT - 1);
+}
+
+void RollingStats::Add(float value) {
+    if (m_Values.empty()) Reset(1);
+    const int window = static_cast<int>(m_Values.size());
+
+    // 窗口已满：淘汰最旧的样本
+    if (m_Count == window) m_Histogram[BinIndex(m_Values[m_Head])]--;
+    else m_Count++;
+    m_Values[m_Head] = value;
+    m_Histogram[BinIndex(value)]++;
+    m_Head = (m_Head + 1) % window;
+
+    // 先移除滑出窗口的队首，再从队尾弹出不大于新值的样本，队列长度不会超过窗口
+    if (m_MaxSize > 0 && m_MaxQueue[m_MaxFront].sequence <= m_Sequence - window) {
+        m_MaxFront = (m_MaxFront + 1) % window;
+        m_MaxSize--;
+    }
+    while (m_MaxSize > 0 && m_MaxQueue[(m_MaxFront + m_MaxSize - 1) % window].value <= value) m_MaxSize--;
+    MaxEntry& entry = m_MaxQueue[(m_MaxFront + m_MaxSize) % window];
+    entry.sequence = m_Sequence;
+    entry.value = value;
+    m_MaxSize++;
+
+    m_Sequence++;
+    m_Latest = value;
+}
+
+float RollingStats::Max() const {
+    return m_MaxSize > 0 ? m_MaxQueue[m_MaxFront].value : 0.0f;
+}
+
+float RollingStats::Percentile(float p) const {
+    if (m_Count == 0) return 0.0f;
+
+    const float target = p * m_Count;
+    int cumulative = 0;
+    for (int i = 0; i < BIN_COUNT; ++i) {
+        if (m_Histogram[i] == 0) continue;
+        if (cumulative + m_Histogram[i] >= target) {
+            const float fraction = std::clamp((target - cumulative) / m_Histogram[i], 0.0f, 1.0f);
+            const float lower = BinLowerBound(i), upper = BinLowerBound(i + 1);
+            // 两端的bin包含范围外的样本，用最大值截断估计
+            return std::min(lower * std::pow(upper / lower, fraction), Max());
+        }
+        cumulative += m_Histogram[i];
+    }
+    return Max();
+}
+
+void FrameStatistics::ResetAll() {
+    window = std::clamp(window, 60, 3600);
+    m_AppliedWindow = window;
+    m_FrameStats.Reset(window);
+    m_GPUStats.Reset(window);
+    for (RollingStats& stats : m_ScopeStats) stats.Reset(window);
+    m_HitchHead = m_HitchCount = 0;
+    m_TotalHitches = 0;
+    m_TotalFrames = 0;
+}
+
+void FrameStatistics::AddFrame(long long frameIndex, float frameMs, float gpuMs, int scopeCount) {
+    if (window != m_AppliedWindow) ResetAll();
+    // 新注册的作用域，只在第一次出现时分配
+    while (static_cast<int>(m_ScopeStats.size()) < scopeCount) {
+        m_ScopeStats.emplace_back();
+        m_ScopeStats.back().Reset(m_AppliedWindow);
+    }
+
+    // 与加入本帧之前的中位数比较，窗口样本太少时只用绝对阈值
+    const float median = m_FrameStats.GetCount() >= 30 ? m_FrameStats.Percentile(0.5f) : 0.0f;
+    m_CurrentIsHitch = frameMs > std::max(hitchThresholdMs, hitchFactor * median);
+    if (m_CurrentIsHitch) {
+        Hitch& hitch = m_Hitches[m_HitchHead];
+        hitch = Hitch();
+        hitch.frameIndex = frameIndex;
+        hitch.frameMs = frameMs;
+        hitch.gpuMs = gpuMs;
+        m_HitchHead = (m_HitchHead + 1) % MAX_HITCHES;
+        m_HitchCount = std::min(m_HitchCount + 1, MAX_HITCHES);
+        m_TotalHitches++;
+    }
+
+    m_FrameStats.Add(frameMs);
+    m_GPUStats.Add(gpuMs);
+    m_TotalFrames++;
+}
+
+void FrameStatistics::AddScope(int node, float inclusiveMs, float exclusiveMs) {
+    if (node < 0 || node >= static_cast<int>(m_ScopeStats.size())) return;
+    m_ScopeStats[node].Add(inclusiveMs);
+    if (!m_CurrentIsHitch) return;
+
+    // 插入排序，只保留独占时间最大的HITCH_STAGES个阶段
+    HitchStage* stages = m_Hitches[(m_HitchHead + MAX_HITCHES - 1) % MAX_HITCHES].stages;
+    int i = HITCH_STAGES - 1;
+    if (stages[i].node >= 0 && stages[i].ms >= exclusiveMs) return;
+    while (i > 0 && (stages[i - 1].node < 0 || stages[i - 1].ms < exclusiveMs)) {
+        stages[i] = stages[i - 1];
+        --i;
+    }
+    stages[i].node = node;
+    stages[i].ms = exclusiveMs;
+}
+
+static void DrawStatsRow(const char* label, int depth, const RollingStats& stats) {
+    ImGui::Text("%*s%s", depth * 2, "", label);
+    ImGui::SameLine(200);
+    ImGui::Text("%7.2f %7.2f %7.2f %7.2f", stats.Percentile(0.5f), stats.Percentile(0.95f),
+        stats.Percentile(0.99f), stats.Max());
+}
+
+void FrameStatistics::DrawScopeRow(const PerformanceProfiler& profiler, int node, int depth) const {
+    const PerformanceProfiler::ScopeNode& scope = profiler.GetScopes()[node];
+    if (node < static_cast<int>(m_ScopeStats.size()) && m_ScopeStats[node].GetCount() > 0) {
+        const std::string label = scope.gpu ? scope.name : scope.name + " (CPU)";
+        DrawStatsRow(label.c_str(), depth, m_ScopeStats[node]);
+    }
+    for (int child : scope.children) DrawScopeRow(profiler, child, depth + 1);
+}
+
+void FrameStatistics::DrawUI(const PerformanceProfiler& profiler) {
+    const std::vector<PerformanceProfiler::ScopeNode>& scopes = profiler.GetScopes();
+
+    ImGui::SliderInt("Window (frames)", &window, 60, 3600);
+    ImGui::Text("Samples: %d", m_FrameStats.GetCount());
+
+    ImGui::TextColored(ImVec4(0, 1, 1, 1), "Stage (ms):");
+    ImGui::SameLine(200);
+    ImGui::TextColored(ImVec4(0, 1, 1, 1), "    p50     p95     p99     max");
+    DrawStatsRow("Frame", 0, m_FrameStats);
+    DrawStatsRow("GPU Total", 0, m_GPUStats);
+    for (size_t i = 0; i < scopes.size(); ++i) {
+        if (scopes[i].parent < 0) DrawScopeRow(profiler, static_cast<int>(i), 0);
+    }
+
+    // 直方图：只显示有样本的bin范围
+    ImGui::Separator();
+    std::vector<std::string> seriesNames = { "Frame", "GPU Total" };
+    for (const PerformanceProfiler::ScopeNode& scope : scopes) seriesNames.push_back(scope.name);
+    m_HistogramSeries = std::clamp(m_HistogramSeries, 0, static_cast<int>(seriesNames.size()) - 1);
+    if (ImGui::BeginCombo("Histogram", seriesNames[m_HistogramSeries].c_str())) {
+        for (int i = 0; i < static_cast<int>(seriesNames.size()); ++i) {
+            if (i >= 2 && (i - 2 >= static_cast<int>(m_ScopeStats.size()) || m_ScopeStats[i - 2].GetCount() == 0)) continue;
+            ImGui::PushID(i);
+            if (ImGui::Selectable(seriesNames[i].c_str(), i == m_HistogramSeries)) m_HistogramSeries = i;
+            ImGui::PopID();
+        }
+        ImGui::EndCombo();
+    }
+
+    const RollingStats* series = m_HistogramSeries == 0 ? &m_FrameStats : m_HistogramSeries == 1 ? &m_GPUStats
+        : m_HistogramSeries - 2 < static_cast<int>(m_ScopeStats.size()) ? &m_ScopeStats[m_HistogramSeries - 2] : nullptr;
+    if (series && series->GetCount() > 0) {
+        const int* histogram = series->GetHistogram();
+        int first = 0, last = RollingStats::BIN_COUNT - 1;
+        while (first < last && histogram[first] == 0) ++first;
+        while (last > first && histogram[last] == 0) --last;
+
+        float values[RollingStats::BIN_COUNT];
+        for (int i = first; i <= last; ++i) values[i - first] = static_cast<float>(histogram[i]) / series->GetCount();
+        char overlay[64];
+        snprintf(overlay, sizeof(overlay), "%.2f - %.2f ms (log)", RollingStats::BinLowerBound(first), RollingStats::BinLowerBound(last + 1));
+        ImGui::PlotHistogram("##FrameHistogram", values, last - first + 1, 0, overlay, 0.0f, 1.0f, ImVec2(0, 80));
+    }
+
+    // 卡顿
+    ImGui::Separator();
+    ImGui::SliderFloat("Hitch Threshold (ms)", &hitchThresholdMs, 1.0f, 200.0f);
+    ImGui::SliderFloat("Hitch x Median", &hitchFactor, 1.0f, 10.0f);
+    ImGui::Text("Hitches: %d (%.2f%% of frames)", m_TotalHitches,
+        m_TotalFrames > 0 ? 100.0 * m_TotalHitches / m_TotalFrames : 0.0);
+    for (int i = 0; i < m_HitchCount; ++i) {
+        const Hitch& hitch = m_Hitches[(m_HitchHead + MAX_HITCHES - 1 - i) % MAX_HITCHES];
+        if (!ImGui::TreeNode(&hitch, "Frame %lld: %.2f ms (GPU %.2f ms)", hitch.frameIndex, hitch.frameMs, hitch.gpuMs)) continue;
+        for (const HitchStage& stage : hitch.stages) {
+            if (stage.node < 0) break;
+            ImGui::Text("%-20s %7.2f ms", scopes[stage.node].name.c_str(), stage.ms);
+        }
+        ImGui::TreePop();
+    }
+}
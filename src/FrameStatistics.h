@@ -0,0 +1,91 @@
+// FrameStatistics.h
+#pragma once
+#include <string>
+#include <vector>
+
+class PerformanceProfiler;
+
+// 单个指标的滑动窗口统计：环形缓冲 + 对数刻度直方图（分位数）+ 单调队列（最大值）
+// Add为均摊O(1)，内存只取决于窗口大小
+class RollingStats {
+public:
+    static constexpr int BIN_COUNT = 96;
+    static constexpr float MIN_MS = 0.01f;      // 直方图范围，超出的样本计入两端的bin
+    static constexpr float MAX_MS = 1000.0f;
+
+    void Reset(int window);
+    void Add(float value);
+
+    int GetCount() const { return m_Count; }
+    float GetLatest() const { return m_Latest; }
+    // 由直方图估计，bin内按对数插值（bin宽约12%）
+    float Percentile(float p) const;
+    float Max() const;
+    const int* GetHistogram() const { return m_Histogram; }
+    static float BinLowerBound(int bin);
+
+private:
+    static int BinIndex(float value);
+
+    std::vector<float> m_Values;                // 环形缓冲，淘汰最旧样本时从直方图中减去
+    int m_Head = 0, m_Count = 0;
+    long long m_Sequence = 0;
+    float m_Latest = 0.0f;
+    int m_Histogram[BIN_COUNT] = {};
+
+    // 单调递减队列（环形），队首为窗口内最大值
+    struct MaxEntry {
+        long long sequence = 0;
+        float value = 0.0f;
+    };
+    std::vector<MaxEntry> m_MaxQueue;
+    int m_MaxFront = 0, m_MaxSize = 0;
+};
+
+// 帧统计：帧时间、GPU总时间和每个profiler作用域的滚动p50/p95/p99/max与直方图，
+// 以及卡顿帧（超过阈值的帧）及其开销最大的几个阶段
+class FrameStatistics {
+public:
+    static constexpr int MAX_HITCHES = 32;      // 保留最近的卡顿数
+    static constexpr int HITCH_STAGES = 4;      // 每次卡顿记录的阶段数（按独占时间排序）
+
+    struct HitchStage {
+        int node = -1;
+        float ms = 0.0f;                        // 独占时间
+    };
+
+    struct Hitch {
+        long long frameIndex = -1;
+        float frameMs = 0.0f, gpuMs = 0.0f;
+        HitchStage stages[HITCH_STAGES];
+    };
+
+    // 参数
+    int window = 600;                   // 统计窗口（帧）
+    float hitchThresholdMs = 16.7f;     // 帧时间同时超过该值
+    float hitchFactor = 2.0f;           // 和p50的该倍数时记为卡顿
+
+    FrameStatistics() = default;
+
+    // 由PerformanceProfiler在回读一帧后调用：先AddFrame，再对该帧执行过的每个作用域调用AddScope
+    // （GPU作用域传GPU时间，仅CPU的作用域传CPU时间）
+    void AddFrame(long long frameIndex, float frameMs, float gpuMs, int scopeCount);
+    void AddScope(int node, float inclusiveMs, float exclusiveMs);
+
+    void DrawUI(const PerformanceProfiler& profiler);
+
+private:
+    void ResetAll();
+    void DrawScopeRow(const PerformanceProfiler& profiler, int node, int depth) const;
+
+    RollingStats m_FrameStats, m_GPUStats;
+    std::vector<RollingStats> m_ScopeStats;     // 按作用域节点id
+    int m_AppliedWindow = 0;
+
+    Hitch m_Hitches[MAX_HITCHES];
+    int m_HitchHead = 0, m_HitchCount = 0;
+    int m_TotalHitches = 0;
+    long long m_TotalFrames = 0;
+    bool m_CurrentIsHitch = false;
+    int m_HistogramSeries = 0;                  // 0 = 帧时间，1 = GPU总时间，2+ = 作用域节点
+};
@@ -0,0 +1,134 @@
+// GPUCounters.cpp
+#include "GPUCounters.h"
+#include "PerformanceProfiler.h"
+#include <imgui.h>
+#include "GPUMemoryTracker.h"
+
+static const char* kCounterNames[GPUCounters::COUNTER_COUNT] = {
+    "Primary", "Bounce", "Shadow", "SSS", "Probe", "AO", "Primitive Tests", "AABB Visits"
+};
+
+GPUCounters::~GPUCounters() {
+    for (int i = 0; i < READBACK_FRAMES; ++i) {
+        if (m_Fences[i]) glDeleteSync(m_Fences[i]);
+    }
+    gpuMemory.DeleteBuffers(READBACK_FRAMES, m_Buffers);
+    if (m_HasPipelineStats) glDeleteQueries(READBACK_FRAMES * 2, &m_StatQueries[0][0]);
+}
+
+void GPUCounters::Init() {
+    glGenBuffers(READBACK_FRAMES, m_Buffers);
+    for (int i = 0; i < READBACK_FRAMES; ++i) {
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_Buffers[i]);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(RawCounters), nullptr, GL_DYNAMIC_READ);
+        gpuMemory.TrackBuffer(m_Buffers[i], "GPUCounters", "Readback " + std::to_string(i), sizeof(RawCounters));
+    }
+
+    // 管线统计查询是GL 4.6 / ARB扩展，不支持时只显示着色器计数
+    m_HasPipelineStats = GLEW_ARB_pipeline_statistics_query;
+    if (m_HasPipelineStats) glGenQueries(READBACK_FRAMES * 2, &m_StatQueries[0][0]);
+}
+
+void GPUCounters::BeginFrame(long long frameIndex) {
+    m_Collecting = enabled;
+    if (!m_Collecting) return;
+
+    GLuint buffer = m_Buffers[m_WriteIndex];
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffer);
+    glClearBufferData(GL_SHADER_STORAGE_BUFFER, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 5, buffer); // 绑定到索引5
+    m_FrameIndices[m_WriteIndex] = frameIndex;
+
+    if (m_HasPipelineStats) {
+        glBeginQuery(GL_COMPUTE_SHADER_INVOCATIONS_ARB, m_StatQueries[m_WriteIndex][0]);
+        glBeginQuery(GL_FRAGMENT_SHADER_INVOCATIONS_ARB, m_StatQueries[m_WriteIndex][1]);
+    }
+}
+
+void GPUCounters::EndFrame() {
+    if (!m_Collecting) return;
+
+    if (m_HasPipelineStats) {
+        glEndQuery(GL_COMPUTE_SHADER_INVOCATIONS_ARB);
+        glEndQuery(GL_FRAGMENT_SHADER_INVOCATIONS_ARB);
+    }
+    // 保证着色器写入对glGetBufferSubData可见
+    glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+    if (m_Fences[m_WriteIndex]) glDeleteSync(m_Fences[m_WriteIndex]);
+    m_Fences[m_WriteIndex] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    m_WriteIndex = (m_WriteIndex + 1) % READBACK_FRAMES;
+
+    // 只读取GPU已经完成的最旧一帧，不阻塞CPU
+    GLsync& fence = m_Fences[m_WriteIndex];
+    if (!fence) return;
+    GLenum status = glClientWaitSync(fence, 0, 0);
+    if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) return;
+
+    RawCounters raw;
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_Buffers[m_WriteIndex]);
+    glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(RawCounters), &raw);
+    for (int i = 0; i < COUNTER_COUNT; ++i) {
+        m_Result.counts[i] = static_cast<uint64_t>(raw.value[2 * i]) | (static_cast<uint64_t>(raw.value[2 * i + 1]) << 32);
+    }
+
+    // fence之前的查询此时已经完成
+    m_Result.pipelineStats = m_HasPipelineStats;
+    if (m_HasPipelineStats) {
+        GLuint64 invocations = 0;
+        glGetQueryObjectui64v(m_StatQueries[m_WriteIndex][0], GL_QUERY_RESULT, &invocations);
+        m_Result.computeInvocations = invocations;
+        glGetQueryObjectui64v(m_StatQueries[m_WriteIndex][1], GL_QUERY_RESULT, &invocations);
+        m_Result.fragmentInvocations = invocations;
+    }
+    m_Result.frameIndex = m_FrameIndices[m_WriteIndex];
+    m_Result.valid = true;
+    glDeleteSync(fence);
+    fence = nullptr;
+}
+
+// 光线数 / 毫秒 -> 百万光线每秒
+static double MraysPerSecond(uint64_t rays, double ms) {
+    return ms > 0.0 ? static_cast<double>(rays) / (ms * 1000.0) : 0.0;
+}
+
+void GPUCounters::DrawStats(const PerformanceProfiler& profiler) {
+    ImGui::Checkbox("Collect Ray Counters", &enabled);
+    if (!m_Result.valid) {
+        ImGui::Text("No data available");
+        return;
+    }
+
+    // 优先使用同一帧的阶段耗时，该帧已滑出历史时退回最新一帧
+    const PerformanceProfiler::FrameStats* stats = profiler.FindStats(m_Result.frameIndex);
+    if (!stats) stats = &profiler.GetLatestStats();
+
+    for (int i = 0; i < COUNTER_COUNT; ++i) {
+        ImGui::Text("%-16s %12llu", kCounterNames[i], static_cast<unsigned long long>(m_Result.counts[i]));
+    }
+
+    const uint64_t cameraRays = m_Result.counts[Primary] + m_Result.counts[Bounce] + m_Result.counts[Shadow] + m_Result.counts[SSS];
+    const uint64_t totalRays = cameraRays + m_Result.counts[Probe] + m_Result.counts[AO];
+    const double rtMs = profiler.GetGPUTime(*stats, "RayTracing");
+    const double probeMs = profiler.GetGPUTime(*stats, "ProbeUpdate");
+    const double aoMs = profiler.GetGPUTime(*stats, "AO");
+
+    ImGui::Separator();
+    ImGui::Text("RayTracing:  %8.1f Mrays/s (%.2f ms)", MraysPerSecond(cameraRays, rtMs), rtMs);
+    if (m_Result.counts[Probe] > 0) ImGui::Text("ProbeUpdate: %8.1f Mrays/s (%.2f ms)", MraysPerSecond(m_Result.counts[Probe], probeMs), probeMs);
+    if (m_Result.counts[AO] > 0) ImGui::Text("RTAO:        %8.1f Mrays/s (%.2f ms)", MraysPerSecond(m_Result.counts[AO], aoMs), aoMs);
+    ImGui::Text("Total:       %8.1f Mrays/s", MraysPerSecond(totalRays, rtMs + probeMs + aoMs));
+    if (totalRays > 0) {
+        ImGui::Text("Per ray: %.1f AABB visits, %.1f primitive tests",
+            static_cast<double>(m_Result.counts[AABBVisits]) / totalRays,
+            static_cast<double>(m_Result.counts[PrimitiveTests]) / totalRays);
+    }
+
+    if (m_Result.pipelineStats) {
+        ImGui::Separator();
+        ImGui::Text("CS invocations: %llu", static_cast<unsigned long long>(m_Result.computeInvocations));
+        ImGui::Text("FS invocations: %llu", static_cast<unsigned long long>(m_Result.fragmentInvocations));
+    }
+    else {
+        ImGui::TextDisabled("Pipeline statistics queries not supported");
+    }
+}
@@ -0,0 +1,67 @@
+// GPUCounters.h
+#pragma once
+#include <GL/glew.h>
+#include <cstdint>
+
+class PerformanceProfiler;
+
+// 光追工作量计数（SSBO binding = 5，异步回读）：各类光线数、图元相交测试和包围盒访问次数
+// 驱动支持ARB_pipeline_statistics_query时同时统计compute/片元着色器调用次数
+class GPUCounters {
+public:
+    // 需与raytracingCs.glsl中的RAY_COUNTER_*一致
+    enum Counter {
+        Primary,
+        Bounce,
+        Shadow,
+        SSS,
+        Probe,
+        AO,
+        PrimitiveTests,
+        AABBVisits,
+        COUNTER_COUNT
+    };
+
+    static constexpr int READBACK_FRAMES = 3;   // 回读环形缓冲深度
+
+    struct Result {
+        uint64_t counts[COUNTER_COUNT] = {};
+        uint64_t computeInvocations = 0;
+        uint64_t fragmentInvocations = 0;
+        bool pipelineStats = false;
+        long long frameIndex = -1;
+        bool valid = false;
+    };
+
+    // 参数
+    bool enabled = false;
+
+    GPUCounters() = default;
+    ~GPUCounters();
+    void Init();
+
+    // 帧开始时调用：绑定并清空本帧的计数缓冲，开始管线统计查询
+    void BeginFrame(long long frameIndex);
+    // 本帧所有光追dispatch之后调用：插入fence，并回读已完成的旧帧数据
+    void EndFrame();
+    bool IsCollecting() const { return m_Collecting; }
+    const Result& GetResult() const { return m_Result; }
+
+    // 在Profiler面板中显示，按同一帧的阶段耗时换算Mrays/s
+    void DrawStats(const PerformanceProfiler& profiler);
+
+private:
+    struct RawCounters {
+        uint32_t value[COUNTER_COUNT * 2];   // 低32位、高32位
+    };
+
+    GLuint m_Buffers[READBACK_FRAMES] = {};
+    GLsync m_Fences[READBACK_FRAMES] = {};
+    long long m_FrameIndices[READBACK_FRAMES] = {};
+    GLuint m_StatQueries[READBACK_FRAMES][2] = {};  // compute、片元着色器调用次数
+    bool m_HasPipelineStats = false;
+    int m_WriteIndex = 0;
+    bool m_Collecting = false;
+
+    Result m_Result;
+};
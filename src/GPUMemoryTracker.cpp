@@ -0,0 +1,251 @@
+// GPUMemoryTracker.cpp
+#include "GPUMemoryTracker.h"
+#include <imgui.h>
+#include <algorithm>
+#include <iostream>
+
+GPUMemoryTracker gpuMemory;
+
+static double ToMB(size_t bytes) {
+    return static_cast<double>(bytes) / (1024.0 * 1024.0);
+}
+
+static const char* KindName(GPUMemoryTracker::Kind kind) {
+    switch (kind) {
+    case GPUMemoryTracker::Kind::Buffer: return "buffer";
+    case GPUMemoryTracker::Kind::Renderbuffer: return "renderbuffer";
+    default: return "texture";
+    }
+}
+
+GPUMemoryTracker::~GPUMemoryTracker() {
+    // 所有模块析构之后才到这里，剩下的就是泄漏
+    ReportLeaks();
+}
+
+size_t GPUMemoryTracker::BytesPerPixel(GLenum internalFormat) {
+    switch (internalFormat) {
+    case GL_R8: return 1;
+    case GL_RG8: case GL_R16F: return 2;
+    case GL_RGBA8: case GL_RG16F: case GL_RG16_SNORM: case GL_R32F: case GL_R32UI:
+    case GL_R11F_G11F_B10F: case GL_RGB10_A2:
+    case GL_DEPTH_COMPONENT24: case GL_DEPTH_COMPONENT32F: case GL_DEPTH24_STENCIL8: return 4;
+    case GL_RGB16F: case GL_RGBA16F: case GL_RG32F: case GL_RGBA16: return 8;
+    case GL_RGB32F: case GL_RGBA32F: return 16;
+    default: return 4;
+    }
+}
+
+const char* GPUMemoryTracker::FormatName(GLenum internalFormat) {
+    switch (internalFormat) {
+    case GL_R8: return "R8";
+    case GL_RG8: return "RG8";
+    case GL_R16F: return "R16F";
+    case GL_RGBA8: return "RGBA8";
+    case GL_RG16F: return "RG16F";
+    case GL_RG16_SNORM: return "RG16_SNORM";
+    case GL_R32F: return "R32F";
+    case GL_R32UI: return "R32UI";
+    case GL_R11F_G11F_B10F: return "R11G11B10F";
+    case GL_RGB10_A2: return "RGB10_A2";
+    case GL_DEPTH_COMPONENT24: return "D24";
+    case GL_DEPTH_COMPONENT32F: return "D32F";
+    case GL_DEPTH24_STENCIL8: return "D24S8";
+    case GL_RGB16F: return "RGB16F";
+    case GL_RGBA16F: return "RGBA16F";
+    case GL_RG32F: return "RG32F";
+    case GL_RGBA16: return "RGBA16";
+    case GL_RGB32F: return "RGB32F";
+    case GL_RGBA32F: return "RGBA32F";
+    default: return "?";
+    }
+}
+
+void GPUMemoryTracker::Warn(const std::string& message) {
+    std::cerr << "GPUMemory: " << message << std::endl;
+    m_Warnings.push_back(message);
+    if (m_Warnings.size() > MAX_WARNINGS) m_Warnings.pop_front();
+    m_WarningCount++;
+}
+
+void GPUMemoryTracker::Add(Resource resource) {
+    const uint64_t key = Key(resource.kind, resource.id);
+    auto it = m_Resources.find(key);
+    if (it != m_Resources.end()) {
+        // 同一对象重新指定存储
+        m_TotalBytes -= it->second.bytes;
+        resource.allocations = it->second.allocations + 1;
+    }
+    else {
+        resource.allocations = 1;
+        for (const auto& entry : m_Resources) {
+            const Resource& other = entry.second;
+            if (other.kind == resource.kind && other.owner == resource.owner && other.name == resource.name) {
+                Warn(resource.owner + "/" + resource.name + ": created again while " + KindName(other.kind) + " "
+                    + std::to_string(other.id) + " is still alive (leak?)");
+                break;
+            }
+        }
+    }
+
+    m_TotalBytes += resource.bytes;
+    m_PeakBytes = std::max(m_PeakBytes, m_TotalBytes);
+    m_FrameAllocations++;
+    m_FrameAllocatedBytes += resource.bytes;
+    m_Resources[key] = std::move(resource);
+}
+
+void GPUMemoryTracker::Remove(Kind kind, GLuint id) {
+    auto it = m_Resources.find(Key(kind, id));
+    if (it == m_Resources.end()) return;
+    m_TotalBytes -= it->second.bytes;
+    m_Resources.erase(it);
+}
+
+void GPUMemoryTracker::TrackTexture(GLuint texture, const std::string& owner, const std::string& name, GLenum internalFormat,
+    int width, int height, int layers, int levels) {
+    Resource resource;
+    resource.kind = Kind::Texture;
+    resource.id = texture;
+    resource.owner = owner;
+    resource.name = name;
+    resource.format = internalFormat;
+    resource.width = width;
+    resource.height = height;
+    resource.layers = layers;
+    resource.levels = levels;
+    for (int level = 0; level < levels; ++level) {
+        const size_t w = std::max(width >> level, 1), h = std::max(height >> level, 1);
+        resource.bytes += w * h * layers * BytesPerPixel(internalFormat);
+    }
+    Add(std::move(resource));
+}
+
+void GPUMemoryTracker::TrackBuffer(GLuint buffer, const std::string& owner, const std::string& name, size_t bytes, bool persistent) {
+    Resource resource;
+    resource.kind = Kind::Buffer;
+    resource.id = buffer;
+    resource.owner = owner;
+    resource.name = name;
+    resource.width = static_cast<int>(bytes);
+    resource.height = 1;
+    resource.bytes = bytes;
+    resource.persistent = persistent;
+    Add(std::move(resource));
+}
+
+void GPUMemoryTracker::TrackRenderbuffer(GLuint renderbuffer, const std::string& owner, const std::string& name, GLenum internalFormat, int width, int height) {
+    Resource resource;
+    resource.kind = Kind::Renderbuffer;
+    resource.id = renderbuffer;
+    resource.owner = owner;
+    resource.name = name;
+    resource.format = internalFormat;
+    resource.width = width;
+    resource.height = height;
+    resource.bytes = static_cast<size_t>(width) * height * BytesPerPixel(internalFormat);
+    Add(std::move(resource));
+}
+
+void GPUMemoryTracker::DeleteTextures(GLsizei count, const GLuint* textures) {
+    for (GLsizei i = 0; i < count; ++i) Remove(Kind::Texture, textures[i]);
+    glDeleteTextures(count, textures);
+}
+
+void GPUMemoryTracker::DeleteBuffers(GLsizei count, const GLuint* buffers) {
+    for (GLsizei i = 0; i < count; ++i) Remove(Kind::Buffer, buffers[i]);
+    glDeleteBuffers(count, buffers);
+}
+
+void GPUMemoryTracker::DeleteRenderbuffers(GLsizei count, const GLuint* renderbuffers) {
+    for (GLsizei i = 0; i < count; ++i) Remove(Kind::Renderbuffer, renderbuffers[i]);
+    glDeleteRenderbuffers(count, renderbuffers);
+}
+
+void GPUMemoryTracker::BeginFrame() {
+    m_LastFrameAllocations = m_FrameAllocations;
+    m_LastFrameAllocatedBytes = m_FrameAllocatedBytes;
+    m_FrameAllocations = 0;
+    m_FrameAllocatedBytes = 0;
+}
+
+std::vector<GPUMemoryTracker::OwnerTotal> GPUMemoryTracker::GetOwnerTotals() const {
+    std::vector<OwnerTotal> totals;
+    for (const auto& entry : m_Resources) {
+        const Resource& resource = entry.second;
+        auto it = std::find_if(totals.begin(), totals.end(), [&](const OwnerTotal& t) { return t.owner == resource.owner; });
+        if (it == totals.end()) {
+            totals.push_back({ resource.owner, 0, 0 });
+            it = totals.end() - 1;
+        }
+        it->bytes += resource.bytes;
+        it->count++;
+    }
+    std::sort(totals.begin(), totals.end(), [](const OwnerTotal& a, const OwnerTotal& b) { return a.bytes > b.bytes; });
+    return totals;
+}
+
+int GPUMemoryTracker::ReportLeaks() const {
+    int leaks = 0;
+    for (const auto& entry : m_Resources) {
+        const Resource& resource = entry.second;
+        if (resource.persistent) continue;
+        std::cerr << "GPUMemory: leaked " << KindName(resource.kind) << " " << resource.id << " "
+            << resource.owner << "/" << resource.name << " (" << resource.bytes << " bytes)" << std::endl;
+        leaks++;
+    }
+    return leaks;
+}
+
+void GPUMemoryTracker::Validate() {
+    std::vector<std::pair<Kind, GLuint>> stale;
+    for (const auto& entry : m_Resources) {
+        const Resource& resource = entry.second;
+        const GLboolean alive = resource.kind == Kind::Texture ? glIsTexture(resource.id)
+            : resource.kind == Kind::Buffer ? glIsBuffer(resource.id) : glIsRenderbuffer(resource.id);
+        if (!alive) stale.emplace_back(resource.kind, resource.id);
+    }
+    for (const auto& [kind, id] : stale) {
+        const Resource& resource = m_Resources[Key(kind, id)];
+        Warn(resource.owner + "/" + resource.name + ": deleted without going through the tracker");
+        Remove(kind, id);
+    }
+}
+
+void GPUMemoryTracker::DrawUI() {
+    ImGui::SetNextWindowPos(ImVec2(10, 460), ImGuiCond_FirstUseEver);
+    ImGui::SetNextWindowCollapsed(true, ImGuiCond_FirstUseEver);
+    ImGui::Begin("GPU Memory", &showSettings);
+
+    ImGui::Text("Total: %.2f MB (peak %.2f MB), %d resources", ToMB(m_TotalBytes), ToMB(m_PeakBytes), GetResourceCount());
+    ImGui::Text("Allocated last frame: %d (%.2f MB)", m_LastFrameAllocations, ToMB(m_LastFrameAllocatedBytes));
+    if (ImGui::Button("Validate")) Validate();
+
+    ImGui::Separator();
+    for (const OwnerTotal& total : GetOwnerTotals()) {
+        ImGui::Text("%-16s %8.2f MB  (%d)", total.owner.c_str(), ToMB(total.bytes), total.count);
+    }
+
+    if (ImGui::CollapsingHeader("Resources")) {
+        std::vector<const Resource*> sorted;
+        for (const auto& entry : m_Resources) sorted.push_back(&entry.second);
+        std::sort(sorted.begin(), sorted.end(), [](const Resource* a, const Resource* b) { return a->bytes > b->bytes; });
+        for (const Resource* r : sorted) {
+            if (r->kind == Kind::Buffer) {
+                ImGui::Text("%-12s %-24s %-10s %13s %8.2f MB x%d", r->owner.c_str(), r->name.c_str(), "buffer", "",
+                    ToMB(r->bytes), r->allocations);
+            }
+            else {
+                ImGui::Text("%-12s %-24s %-10s %5dx%-5d%s %8.2f MB x%d", r->owner.c_str(), r->name.c_str(), FormatName(r->format),
+                    r->width, r->height, r->layers == 6 ? "c" : " ", ToMB(r->bytes), r->allocations);
+            }
+        }
+    }
+
+    if (!m_Warnings.empty() && ImGui::CollapsingHeader("Warnings", ImGuiTreeNodeFlags_DefaultOpen)) {
+        ImGui::Text("%d warning(s)", m_WarningCount);
+        for (const std::string& warning : m_Warnings) ImGui::TextColored(ImVec4(1, 1, 0, 1), "%s", warning.c_str());
+    }
+
+    ImGui::End();
+}
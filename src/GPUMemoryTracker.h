@@ -0,0 +1,89 @@
+// GPUMemoryTracker.h
+#pragma once
+#include <GL/glew.h>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// 显存记账：各模块在分配纹理/缓冲存储后登记格式、尺寸、字节数和所属模块，删除时通过这里注销。
+// 统计总量和峰值、每帧的（重新）分配，并检查泄漏：退出时仍未释放的资源，
+// 以及同一模块的同名资源在旧对象未删除时被再次创建
+class GPUMemoryTracker {
+public:
+    enum class Kind { Texture, Buffer, Renderbuffer };
+
+    struct Resource {
+        Kind kind = Kind::Texture;
+        GLuint id = 0;
+        std::string owner, name;
+        GLenum format = 0;              // 纹理/渲染缓冲的内部格式
+        int width = 0, height = 0;
+        int layers = 1, levels = 1;     // 立方体贴图layers = 6
+        size_t bytes = 0;
+        int allocations = 0;            // 存储被指定的次数（大于1即为重新分配）
+        bool persistent = false;        // 进程生命周期的静态资源，退出时不算泄漏
+    };
+
+    struct OwnerTotal {
+        std::string owner;
+        size_t bytes = 0;
+        int count = 0;
+    };
+
+    static constexpr int MAX_WARNINGS = 32;
+
+    bool showSettings = true;
+
+    GPUMemoryTracker() = default;
+    ~GPUMemoryTracker();
+
+    // 在glTexImage2D/glTexStorage2D之后调用，对同一纹理再次调用视为重新分配
+    void TrackTexture(GLuint texture, const std::string& owner, const std::string& name, GLenum internalFormat,
+        int width, int height, int layers = 1, int levels = 1);
+    // 在glBufferData之后调用
+    void TrackBuffer(GLuint buffer, const std::string& owner, const std::string& name, size_t bytes, bool persistent = false);
+    void TrackRenderbuffer(GLuint renderbuffer, const std::string& owner, const std::string& name, GLenum internalFormat, int width, int height);
+
+    // 代替glDelete*：删除对象并注销（未登记的对象同样删除）
+    void DeleteTextures(GLsizei count, const GLuint* textures);
+    void DeleteBuffers(GLsizei count, const GLuint* buffers);
+    void DeleteRenderbuffers(GLsizei count, const GLuint* renderbuffers);
+
+    // 每帧开始时调用，保存上一帧的分配统计
+    void BeginFrame();
+
+    size_t GetTotalBytes() const { return m_TotalBytes; }
+    size_t GetPeakBytes() const { return m_PeakBytes; }
+    int GetResourceCount() const { return static_cast<int>(m_Resources.size()); }
+    int GetWarningCount() const { return m_WarningCount; }
+    // 按字节数降序
+    std::vector<OwnerTotal> GetOwnerTotals() const;
+
+    // 打印仍未释放的非静态资源，返回个数
+    int ReportLeaks() const;
+    void DrawUI();
+
+    // 未压缩格式的每像素字节数；RGB16F/RGB32F按驱动实际的RGBA存储计算
+    static size_t BytesPerPixel(GLenum internalFormat);
+    static const char* FormatName(GLenum internalFormat);
+
+private:
+    static uint64_t Key(Kind kind, GLuint id) { return (static_cast<uint64_t>(kind) << 32) | id; }
+    void Add(Resource resource);
+    void Remove(Kind kind, GLuint id);
+    void Warn(const std::string& message);
+    // 用glIs*检查记录的对象是否仍然存在（被直接glDelete*而未注销）
+    void Validate();
+
+    std::unordered_map<uint64_t, Resource> m_Resources;
+    size_t m_TotalBytes = 0, m_PeakBytes = 0;
+    int m_FrameAllocations = 0, m_LastFrameAllocations = 0;
+    size_t m_FrameAllocatedBytes = 0, m_LastFrameAllocatedBytes = 0;
+
+    std::deque<std::string> m_Warnings;         // 最近的警告
+    int m_WarningCount = 0;
+};
+
+extern GPUMemoryTracker gpuMemory;
@@ -0,0 +1,132 @@
+// HDRPrecision.cpp
+#include "HDRPrecision.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    struct MiniFloat {
+        int mantissaBits;
+        int minExponent;    // 最小规格化指数
+        float maxValue;
+        bool hasSign;
+    };
+
+    // 依次为R11G11B10F的R/G通道和B通道
+    const MiniFloat kHalf = { 10, -14, 65504.0f, true };
+    const MiniFloat kFloat11 = { 6, -14, 65024.0f, false };
+    const MiniFloat kFloat10 = { 5, -14, 64512.0f, false };
+
+    float QuantizeMiniFloat(float value, const MiniFloat& format) {
+        if (!format.hasSign && value <= 0.0f) return 0.0f;
+        float magnitude = std::min(std::fabs(value), format.maxValue);
+        if (magnitude == 0.0f) return 0.0f;
+
+        int exponent;
+        std::frexp(magnitude, &exponent);   // magnitude = m * 2^exponent, m∈[0.5, 1)
+        // 规格化数的步长随指数变化，非规格化数使用最小指数的固定步长
+        int stepExponent = std::max(exponent - 1, format.minExponent) - format.mantissaBits;
+        float step = std::ldexp(1.0f, stepExponent);
+        float quantized = std::min(std::nearbyint(magnitude / step) * step, format.maxValue);
+        return value < 0.0f ? -quantized : quantized;
+    }
+
+    double Tonemap(double x) {
+        return x / (1.0 + x);
+    }
+
+    double Luminance(const float* c) {
+        return 0.2126 * c[0] + 0.7152 * c[1] + 0.0722 * c[2];
+    }
+
+    double Psnr(double mse) {
+        return mse > 0.0 ? 10.0 * std::log10(1.0 / mse) : 99.0;
+    }
+}
+
+namespace HDRPrecision {
+    GLenum GetGLFormat(HDRFormat format) {
+        switch (format) {
+        case HDRFormat::RGBA16F:    return GL_RGBA16F;
+        case HDRFormat::R11G11B10F: return GL_R11F_G11F_B10F;
+        default:                    return GL_RGBA32F;
+        }
+    }
+
+    int BytesPerPixel(HDRFormat format) {
+        switch (format) {
+        case HDRFormat::RGBA16F:    return 8;
+        case HDRFormat::R11G11B10F: return 4;
+        default:                    return 16;
+        }
+    }
+
+    const char* GetName(HDRFormat format) {
+        switch (format) {
+        case HDRFormat::RGBA16F:    return "RGBA16F";
+        case HDRFormat::R11G11B10F: return "R11G11B10F";
+        default:                    return "RGBA32F";
+        }
+    }
+
+    float Quantize(float value, HDRFormat format, int channel) {
+        switch (format) {
+        case HDRFormat::RGBA16F:    return QuantizeMiniFloat(value, kHalf);
+        case HDRFormat::R11G11B10F: return QuantizeMiniFloat(value, channel < 2 ? kFloat11 : kFloat10);
+        default:                    return value;
+        }
+    }
+
+    Report Run(const std::vector<float>& rgba, int width, int height, float blendFactor, int historyFrames) {
+        Report report;
+        report.width = width;
+        report.height = height;
+        report.historyFrames = historyFrames;
+        const size_t pixelCount = static_cast<size_t>(width) * height;
+        if (rgba.size() < pixelCount * 4) return report;
+
+        // 历史累积的模拟较慢，按4x4间隔取样
+        const int HISTORY_STRIDE = 4;
+
+        for (int f = 0; f < static_cast<int>(HDRFormat::Count); ++f) {
+            const HDRFormat format = static_cast<HDRFormat>(f);
+            FormatResult& result = report.results[f];
+            result.passMB = static_cast<double>(BytesPerPixel(format)) * pixelCount / (1024.0 * 1024.0);
+
+            double squaredError = 0.0, historyError = 0.0;
+            size_t historySamples = 0;
+            for (int y = 0; y < height; ++y) {
+                for (int x = 0; x < width; ++x) {
+                    const float* reference = &rgba[(static_cast<size_t>(y) * width + x) * 4];
+                    float quantized[3];
+                    for (int c = 0; c < 3; ++c) {
+                        quantized[c] = Quantize(reference[c], format, c);
+                        double diff = Tonemap(std::max(reference[c], 0.0f)) - Tonemap(std::max(quantized[c], 0.0f));
+                        squaredError += diff * diff;
+                    }
+                    double referenceLum = Luminance(reference);
+                    if (referenceLum > 1e-4) {
+                        result.maxRelError = std::max(result.maxRelError, std::fabs(Luminance(quantized) - referenceLum) / referenceLum);
+                    }
+
+                    if (x % HISTORY_STRIDE || y % HISTORY_STRIDE) continue;
+                    // 每帧 history = mix(history, current, blendFactor) 后写回该格式
+                    for (int c = 0; c < 3; ++c) {
+                        double exact = 0.0;
+                        float history = 0.0f;
+                        for (int i = 0; i < historyFrames; ++i) {
+                            exact += (reference[c] - exact) * blendFactor;
+                            history = Quantize(history + (reference[c] - history) * blendFactor, format, c);
+                        }
+                        double diff = Tonemap(std::max(exact, 0.0)) - Tonemap(std::max(history, 0.0f));
+                        historyError += diff * diff;
+                    }
+                    historySamples++;
+                }
+            }
+            result.psnr = Psnr(squaredError / (pixelCount * 3.0));
+            result.historyPsnr = Psnr(historySamples ? historyError / (historySamples * 3.0) : 0.0);
+        }
+        report.valid = true;
+        return report;
+    }
+}
@@ -0,0 +1,39 @@
+// HDRPrecision.h
+#pragma once
+#include <GL/glew.h>
+#include <vector>
+
+// HDR中间纹理的存储格式。光追输出和TAA历史的alpha恒为1，
+// 显示路径上的纹理用16位或11/11/10位浮点即可，32位只在累积误差不可接受时保留
+enum class HDRFormat {
+    RGBA32F,
+    RGBA16F,
+    R11G11B10F,
+    Count
+};
+
+namespace HDRPrecision {
+    GLenum GetGLFormat(HDRFormat format);
+    int BytesPerPixel(HDRFormat format);
+    const char* GetName(HDRFormat format);
+
+    // CPU端模拟写入该格式时的舍入（就近舍入、超出范围钳制，11/10位格式无符号）
+    float Quantize(float value, HDRFormat format, int channel);
+
+    struct FormatResult {
+        double passMB = 0.0;        // 完整读或写一次的流量
+        double psnr = 0.0;          // 单帧量化误差（色调映射后，dB）
+        double maxRelError = 0.0;   // 最大相对亮度误差
+        double historyPsnr = 0.0;   // 模拟TAA多帧累积后的误差（dB）
+    };
+
+    struct Report {
+        bool valid = false;
+        int width = 0, height = 0;
+        int historyFrames = 0;
+        FormatResult results[static_cast<int>(HDRFormat::Count)];
+    };
+
+    // rgba为RGBA32F参考帧；历史累积按blendFactor从黑色收敛historyFrames帧，与双精度的结果比较
+    Report Run(const std::vector<float>& rgba, int width, int height, float blendFactor, int historyFrames = 64);
+}
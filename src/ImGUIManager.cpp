@@ -7,6 +7,7 @@
 #include "TextureLoader.h"
 #include "SceneIO.h"
 #include "AO.h"
+#include "GPUMemoryTracker.h"
 
 namespace fs = std::filesystem;
 
@@ -18,16 +19,17 @@ void ImGuiManager::Init() {
     ImGuiIO& io = ImGui::GetIO();
     io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;
 
-    // ״̬棬´лϴнʱ״̬
+    // 禁用状态保存，否则下次运行会是上次运行结束时的状态
     io.IniFilename = nullptr;
 
     SetupStyle();
     ImGui_ImplGlfw_InitForOpenGL(m_Window, true);
     ImGui_ImplOpenGL3_Init("#version 430");
 
-    // Ĭպ
+    // 加载默认天空盒
+    m_EnvSampler.Init();
     std::string defaultPath = std::string("res/skybox/") + m_SkyboxPaths[0];
-    m_CurrentSkyboxTexture = ConvertHDRToCubemap(defaultPath.c_str());
+    m_CurrentSkyboxTexture = ConvertHDRToCubemap(defaultPath.c_str(), 512, &m_EnvSampler);
 
     fs::create_directories("res/Scene");
 }
@@ -38,7 +40,7 @@ ImGuiManager::~ImGuiManager() {
     ImGui::DestroyContext();
 
     if (m_CurrentSkyboxTexture != 0) {
-        glDeleteTextures(1, &m_CurrentSkyboxTexture);
+        gpuMemory.DeleteTextures(1, &m_CurrentSkyboxTexture);
     }
 }
 
@@ -60,17 +62,17 @@ void ImGuiManager::DrawObjectsList(SSBO& ssbo) {
 
     static UIObject uiObj{ "New Object" };
 
-    // 
+    // 名称输入
     ImGui::InputText("Name", uiObj.name, IM_ARRAYSIZE(uiObj.name));
 
-    // ѡ
+    // 物体类型选择
 	static int objType = 0;
     ImGui::RadioButton("Sphere", &objType, 0);
     ImGui::SameLine();
     ImGui::RadioButton("Plane", &objType, 1);
     uiObj.obj.type = static_cast<ObjectType>(objType);
 
-    // 
+    // 基础属性
     ImGui::InputFloat3("Position", &uiObj.obj.position.x);
     if (objType == 0) {
         ImGui::InputFloat("Radius", &uiObj.obj.radius);
@@ -80,11 +82,11 @@ void ImGuiManager::DrawObjectsList(SSBO& ssbo) {
         ImGui::InputFloat2("Size (W/H)", &uiObj.obj.size.x);
     }
 
-    // 
+    // 材质属性面板
     ImGui::Separator();
     ImGui::Text("Material Settings");
 
-    // ѡ
+    // 材质类型选择
 	static int matType = 0;
     ImGui::RadioButton("Metallic", &matType, MATERIAL_METALLIC);
     ImGui::SameLine();
@@ -93,35 +95,35 @@ void ImGuiManager::DrawObjectsList(SSBO& ssbo) {
     ImGui::RadioButton("Plastic", &matType, MATERIAL_PLASTIC);
 	uiObj.obj.material.type = static_cast<MaterialType>(matType);
 
-    // ͨò
+    // 通用参数
     ImGui::ColorEdit3("Albedo", &uiObj.obj.material.albedo.r);
     ImGui::SliderFloat("Roughness", &uiObj.obj.material.roughness, 0.0f, 1.0f);
 
-    // ض
+    // 类型特定参数
     switch (uiObj.obj.material.type) {
     case MATERIAL_METALLIC:
         ImGui::SliderFloat("Metallic ", &uiObj.obj.material.metallic, 0.0f, 1.0f);
-        uiObj.obj.material.transparency = 0.0f; // ͸
+        uiObj.obj.material.transparency = 0.0f; // 金属不透明
         break;
     case MATERIAL_DIELECTRIC:
         ImGui::SliderFloat("IOR", &uiObj.obj.material.ior, 1.0f, 2.5f);
         ImGui::SliderFloat("Transparency", &uiObj.obj.material.transparency, 0.0f, 1.0f);
-        uiObj.obj.material.metallic = 0.0f; // ʷǽ
+        uiObj.obj.material.metallic = 0.0f; // 电介质非金属
         break;
     case MATERIAL_PLASTIC:
         ImGui::SliderFloat("Specular", &uiObj.obj.material.specular, 0.0f, 1.0f);
-        uiObj.obj.material.transparency = 0.0f; // ϲ͸
+        uiObj.obj.material.transparency = 0.0f; // 塑料不透明
         break;
     }
 
-    // 
+    // 添加物体
     if (ImGui::Button("Add Object")) {
         GenerateAABBForObject(uiObj.obj);
         ssbo.objects.push_back(uiObj.obj);
         m_UIObjects.push_back(uiObj);
     }
 
-    // б
+    // 物体列表
     ImGui::Separator();
     ImGui::Text("Total Objects: %d", ssbo.objects.size());
 
@@ -135,13 +137,13 @@ void ImGuiManager::DrawObjectsList(SSBO& ssbo) {
             ImGuiTreeNodeFlags_DefaultOpen,
             "%s##%d", uiObj.name, i)) 
         {
-            // ༭
+            // 编辑名称
             ImGui::InputText("Name##obj", uiObj.name, IM_ARRAYSIZE(uiObj.name));
 
-            // ͬλ
+            // 同步位置
             ImGui::InputFloat3("Position", &uiObj.obj.position.x);
 
-            // ͬ
+            // 类型相关属性同步
             if (uiObj.obj.type == ObjectType::SPHERE) {
                 ImGui::DragFloat("Radius##obj", &uiObj.obj.radius, 0.1f, 0.0f, 100.0f);
             }
@@ -150,11 +152,11 @@ void ImGuiManager::DrawObjectsList(SSBO& ssbo) {
                 ImGui::InputFloat2("Size##obj", &uiObj.obj.size.x);
             }
 
-            // ͬ
+            // 同步材质属性
             ImGui::Separator();
             ImGui::Text("Material Settings");
 
-            // 
+            // 材质类型
             int matType = uiObj.obj.material.type;
             if (ImGui::RadioButton("Metallic##obj", &matType, MATERIAL_METALLIC) ||
                 ImGui::RadioButton("Dielectric##obj", &matType, MATERIAL_DIELECTRIC) ||
@@ -166,20 +168,20 @@ void ImGuiManager::DrawObjectsList(SSBO& ssbo) {
             ImGui::ColorEdit3("Albedo##obj", &uiObj.obj.material.albedo.r);
             ImGui::SliderFloat("Roughness##obj", &uiObj.obj.material.roughness, 0.0f, 1.0f);
 
-            // ض
+            // 类型特定参数
             switch (uiObj.obj.material.type) {
             case MATERIAL_METALLIC:
-                uiObj.obj.material.transparency = 0.0f; // ͸
+                uiObj.obj.material.transparency = 0.0f; // 金属不透明
                 ImGui::SliderFloat("Metallic ##obj", &uiObj.obj.material.metallic, 0.0f, 1.0f);
                 break;
             case MATERIAL_DIELECTRIC:
-                uiObj.obj.material.metallic = 0.0f; // ʷǽ
-				uiObj.obj.material.specular = 0.0f; // ޾淴
+                uiObj.obj.material.metallic = 0.0f; // 电介质非金属
+				uiObj.obj.material.specular = 0.0f; // 电介质无镜面反射
                 ImGui::SliderFloat("IOR##obj", &uiObj.obj.material.ior, 1.0f, 2.5f);
                 ImGui::SliderFloat("Transparency##obj", &uiObj.obj.material.transparency, 0.0f, 1.0f);
                 break;
             case MATERIAL_PLASTIC:
-                uiObj.obj.material.transparency = 0.0f; // ϲ͸
+                uiObj.obj.material.transparency = 0.0f; // 塑料不透明
                 ImGui::SliderFloat("Specular##obj", &uiObj.obj.material.specular, 0.0f, 1.0f);
                 break;
             }
@@ -187,7 +189,7 @@ void ImGuiManager::DrawObjectsList(SSBO& ssbo) {
             ImGui::TreePop();
         }
 
-        // ɾťҪͬʱɾбԪ
+        // 删除按钮需要同时删除两个列表的元素
         if (ImGui::SmallButton("Delete")) {
             m_UIObjects.erase(m_UIObjects.begin() + i);
             ssbo.objects.erase(ssbo.objects.begin() + i);
@@ -199,7 +201,10 @@ void ImGuiManager::DrawObjectsList(SSBO& ssbo) {
         ImGui::PopID();
     }
 
-    ssbo.update();
+    {
+        PerformanceProfiler::Scope scope(*profiler, "ObjectUpload");
+        ssbo.update();
+    }
     ImGui::End();
 }
 
@@ -211,10 +216,10 @@ void ImGuiManager::DrawLightController(LightSSBO& lightSSBO) {
 
 	static UILight uiLight{ "New Light" };
 
-	// 
+	// 名称输入
     ImGui::InputText("Name", uiLight.name, IM_ARRAYSIZE(uiLight.name));
 
-    // Դѡ
+    // 光源类型选择
     static int lightType = 0;
     ImGui::RadioButton("Point", &lightType, 0);
     ImGui::SameLine();
@@ -223,11 +228,11 @@ void ImGuiManager::DrawLightController(LightSSBO& lightSSBO) {
     ImGui::RadioButton("Area", &lightType, 2);
 	uiLight.light.type = static_cast<LightType>(lightType);
 
-    // ͨ
+    // 通用属性
     ImGui::ColorEdit3("Color", &uiLight.light.color.x);
     ImGui::SliderFloat("Intensity", &uiLight.light.intensity, 0.1f, 10.0f);
 
-    // ض
+    // 类型特定属性
     if (lightType == 0) {
         ImGui::InputFloat3("Position", &uiLight.light.position.x);
         ImGui::SliderFloat("Radius", &uiLight.light.radius, 1.0f, 20.0f);
@@ -242,7 +247,7 @@ void ImGuiManager::DrawLightController(LightSSBO& lightSSBO) {
 		ImGui::InputInt("Samples", &uiLight.light.samples);
     }
 
-    // ڹԴ
+    // 在光源属性面板中添加
     ImGui::Separator();
     ImGui::Text("Shadow Settings");
     ImGui::Combo("Shadow Type", &uiLight.light.shadowType, "None\0PCF\0PCSS\0");
@@ -253,21 +258,21 @@ void ImGuiManager::DrawLightController(LightSSBO& lightSSBO) {
     }
 
     if (uiLight.light.shadowType == 2) { // PCSS
-        if (lightType == 0 || lightType == 1) { // Դ
+        if (lightType == 0 || lightType == 1) { // 点光源或定向光
             ImGui::SliderFloat("Light Size", &uiLight.light.lightSize, 0.1f, 5.0f);
         }
-        if (lightType == 1) { // 
+        if (lightType == 1) { // 定向光
             ImGui::SliderAngle("Angular Radius", &uiLight.light.angularRadius, 0.1f, 5.0f);
         }
     }
 
-    // ӹԴť
+    // 添加光源按钮
     if (ImGui::Button("Add Light")) {
         lightSSBO.lights.push_back(uiLight.light);
 		m_UILights.push_back(uiLight);
     }
 
-    // Դб
+    // 光源列表
     ImGui::Separator();
     ImGui::Text("Lights (%d)", lightSSBO.lights.size());
 
@@ -280,10 +285,10 @@ void ImGuiManager::DrawLightController(LightSSBO& lightSSBO) {
             ImGuiTreeNodeFlags_DefaultOpen,
 			"%s##%d", uiLight.name, i))
         {
-			// ༭
+			// 编辑名称
 			ImGui::InputText("Name##light", uiLight.name, IM_ARRAYSIZE(uiLight.name));
 
-            // ༭
+            // 编辑属性
             ImGui::ColorEdit3("Color", &uiLight.light.color.r);
             ImGui::SliderFloat("Intensity", &uiLight.light.intensity, 0.1f, 10.0f);
 
@@ -301,7 +306,7 @@ void ImGuiManager::DrawLightController(LightSSBO& lightSSBO) {
 				ImGui::InputInt("Samples", &uiLight.light.samples);
 			}
 
-            // ڹԴ
+            // 在光源属性面板中添加
             ImGui::Separator();
             ImGui::Text("Shadow Settings");
             ImGui::Combo("Shadow Type", &uiLight.light.shadowType, "None\0PCF\0PCSS\0");
@@ -312,15 +317,15 @@ void ImGuiManager::DrawLightController(LightSSBO& lightSSBO) {
             }
 
             if (uiLight.light.shadowType == 2) { // PCSS
-                if (lightType == 0 || lightType == 1) { // Դ
+                if (lightType == 0 || lightType == 1) { // 点光源或定向光
                     ImGui::SliderFloat("Light Size", &uiLight.light.lightSize, 0.1f, 5.0f);
                 }
-                if (lightType == 1) { // 
+                if (lightType == 1) { // 定向光
                     ImGui::SliderAngle("Angular Radius", &uiLight.light.angularRadius, 0.1f, 5.0f);
                 }
             }
 
-            // ɾť
+            // 删除按钮
             if (ImGui::SmallButton("Delete")) {
                 lightSSBO.lights.erase(lightSSBO.lights.begin() + i);
 				m_UILights.erase(m_UILights.begin() + i);
@@ -335,7 +340,10 @@ void ImGuiManager::DrawLightController(LightSSBO& lightSSBO) {
         ImGui::PopID();
     }
 
-    lightSSBO.update();
+    {
+        PerformanceProfiler::Scope scope(*profiler, "LightUpload");
+        lightSSBO.update();
+    }
     ImGui::End();
 }
 
@@ -345,29 +353,29 @@ void ImGuiManager::DrawCameraControls(Camera& camera) {
     ImGui::SetNextWindowCollapsed(true, ImGuiCond_FirstUseEver);
     ImGui::Begin("Camera Controls");
 
-    // λÿ
+    // 位置控制
     ImGui::Text("Position");
     ImGui::SliderFloat3("##uiObj.obj.position", &camera.Position.x, -10.0f, 10.0f);
 
-    // ʾ
+    // 方向显示
     ImGui::Text("Direction: (%.2f, %.2f, %.2f)",
         camera.Front.x, camera.Front.y, camera.Front.z);
 
-    // FOV
+    // FOV控制
     ImGui::Text("FOV");
     ImGui::SliderFloat("##fov", &camera.FOV, 1.0f, 90.0f);
 
-    // ͷ
+    // 摄像头移速
     ImGui::SliderFloat("Move Speed", &camera.MoveSpeed, 1.0f, 20.0f);
 
-    // 
+    // 景深
     ImGui::InputFloat("Focal Length", &camera.FocalLength);
 
     ImGui::End();
 }
 
 void ImGuiManager::DrawFPS() {
-    // ôԣޱ͸̶λ
+    // 设置窗口属性：无标题栏、透明背景、固定位置
     ImGuiWindowFlags flags =
         ImGuiWindowFlags_NoDecoration |
         ImGuiWindowFlags_NoBackground |
@@ -376,7 +384,7 @@ void ImGuiManager::DrawFPS() {
         ImGuiWindowFlags_NoFocusOnAppearing |
         ImGuiWindowFlags_NoMove;
 
-    // ôλϽ
+    // 设置窗口位置在右上角
     const float PAD = 10.0f;
     const ImGuiViewport* viewport = ImGui::GetMainViewport();
     ImVec2 work_pos = viewport->WorkPos;
@@ -385,23 +393,23 @@ void ImGuiManager::DrawFPS() {
     ImVec2 window_pos_pivot = ImVec2(1.0f, 0.0f);
     ImGui::SetNextWindowPos(window_pos, ImGuiCond_Always, window_pos_pivot);
 
-    // ƴ
-    ImGui::SetNextWindowBgAlpha(0.0f); // ȫ͸
+    // 绘制窗口
+    ImGui::SetNextWindowBgAlpha(0.0f); // 完全透明背景
     if (ImGui::Begin("FPS Overlay", nullptr, flags)) {
-        float fps = ImGui::GetIO().Framerate; // ֱӻȡ֡
-        // ̬ɫ
+        float fps = ImGui::GetIO().Framerate; // 直接获取帧率
+        // 动态颜色设置
         ImVec4 color;
         if (fps < 30.0f) {
-            color = ImVec4(1.0f, 0.0f, 0.0f, 1.0f);  // ɫ
+            color = ImVec4(1.0f, 0.0f, 0.0f, 1.0f);  // 红色
         }
         else if (fps <= 60.0f) {
-            color = ImVec4(1.0f, 1.0f, 0.0f, 1.0f);  // ɫ
+            color = ImVec4(1.0f, 1.0f, 0.0f, 1.0f);  // 黄色
         }
         else {
-            color = ImVec4(0.0f, 1.0f, 0.0f, 1.0f);  // ɫ
+            color = ImVec4(0.0f, 1.0f, 0.0f, 1.0f);  // 绿色
         }
 
-        // ɫıʾ
+        // 带颜色文本显示
         ImGui::TextColored(color, "FPS: ");
         ImGui::SameLine();
         ImGui::TextColored(color, "%.1f", fps);
@@ -415,23 +423,38 @@ void ImGuiManager::ChooseSkybox() {
     ImGui::SetNextWindowCollapsed(true, ImGuiCond_FirstUseEver);
     ImGui::Begin("Skybox Settings");
 
-    // /պиѡ
+    // 启用/禁用天空盒复选框
     ImGui::Checkbox("Enable Skybox", &m_UseSkybox);
 
-    // պѡ˵
-    if (m_UseSkybox && ImGui::Combo("Select Skybox", &m_SelectedSkyboxIndex, m_SkyboxNames.data(), static_cast<int>(m_SkyboxNames.size()))) {
-        // ѡıʱ¼պ
-        if (m_CurrentSkyboxTexture != 0) {
-            glDeleteTextures(1, &m_CurrentSkyboxTexture);
-            m_CurrentSkyboxTexture = 0;
-        }
-        std::string fullPath = std::string("res/skybox/") + m_SkyboxPaths[m_SelectedSkyboxIndex];
-        m_CurrentSkyboxTexture = ConvertHDRToCubemap(fullPath.c_str());
+    // 天空盒选择下拉菜单
+    int skyboxIndex = m_SelectedSkyboxIndex;
+    if (m_UseSkybox && ImGui::Combo("Select Skybox", &skyboxIndex, m_SkyboxNames.data(), static_cast<int>(m_SkyboxNames.size()))) {
+        SelectSkybox(skyboxIndex);
+    }
+
+    // 显式采样天空盒光照（MIS）
+    if (m_UseSkybox) {
+        ImGui::Checkbox("Importance Sampling", &m_UseEnvSampling);
     }
 
     ImGui::End();
 }
 
+void ImGuiManager::SelectSkybox(int index) {
+    if (index < 0 || index >= static_cast<int>(m_SkyboxPaths.size())) return;
+    if (index == m_SelectedSkyboxIndex && m_CurrentSkyboxTexture != 0) return;
+
+    // 当选择改变时重新加载天空盒
+    m_SelectedSkyboxIndex = index;
+    if (m_CurrentSkyboxTexture != 0) {
+        gpuMemory.DeleteTextures(1, &m_CurrentSkyboxTexture);
+        m_CurrentSkyboxTexture = 0;
+    }
+    std::string fullPath = std::string("res/skybox/") + m_SkyboxPaths[m_SelectedSkyboxIndex];
+    PerformanceProfiler::Scope scope(*profiler, "SkyboxConvert");
+    m_CurrentSkyboxTexture = ConvertHDRToCubemap(fullPath.c_str(), 512, &m_EnvSampler);
+}
+
 void ImGuiManager::LoadSave(SSBO& ssbo, LightSSBO& lightSSBO) {
     ImGui::SetNextWindowPos(ImVec2(10, 130), ImGuiCond_FirstUseEver);
     ImGui::SetNextWindowCollapsed(true, ImGuiCond_FirstUseEver);
@@ -477,9 +500,9 @@ void ImGuiManager::DrawTAASettings()
 void ImGuiManager::DrawFileDialog(SSBO& ssbo, LightSSBO& lightSSBO) {
     ImGui::SetNextWindowSize(ImVec2(500, 400), ImGuiCond_FirstUseEver);
     if (ImGui::Begin(m_FileDialog.isOpenMode ? "Load Scene##FileDialog" : "Save Scene##FileDialog", &m_FileDialog.show)) {
-        // ǰ·ʾ
+        // 当前路径显示
         ImGui::Text("Current Path: %s", m_FileDialog.currentPath.c_str());
-        if (ImGui::Button(" Up")) {
+        if (ImGui::Button("↑ Up")) {
             auto parent_path = std::filesystem::path(m_FileDialog.currentPath).parent_path();
             if (!parent_path.empty()) {
                 m_FileDialog.currentPath = parent_path.string();
@@ -487,17 +510,17 @@ void ImGuiManager::DrawFileDialog(SSBO& ssbo, LightSSBO& lightSSBO) {
             }
         }
 
-        // ļб
+        // 文件列表
         if (ImGui::BeginChild("FileList##Unique", ImVec2(0, 300), true)) {
             for (size_t i = 0; i < m_FileDialog.entries.size(); ++i) {
                 const auto& entry = m_FileDialog.entries[i];
-                ImGui::PushID(static_cast<int>(i)); // ÿĿΨһID
+                ImGui::PushID(static_cast<int>(i)); // 每个条目唯一ID
 
                 const bool isDirectory = entry.is_directory();
                 const std::string displayName = entry.path().filename().string();
                 const bool isParentDir = (i == 0 && displayName == "..");
 
-                // ʾɵĿ¼/ļ
+                // 显示可点击的目录/文件项
                 ImGuiSelectableFlags flags = ImGuiSelectableFlags_AllowDoubleClick;
                 if (ImGui::Selectable(
                     isDirectory ? "[D] " : "[F] ",
@@ -505,15 +528,15 @@ void ImGuiManager::DrawFileDialog(SSBO& ssbo, LightSSBO& lightSSBO) {
                     flags))
                 {
                     if (isDirectory) {
-                        if (isParentDir) return; // Ŀ¼Ҫ˫
-                        m_FileDialog.selectedFile = ""; // Ŀ¼·
+                        if (isParentDir) return; // 父目录需要双击
+                        m_FileDialog.selectedFile = ""; // 单击目录不清空路径
                     }
                     else {
                         m_FileDialog.selectedFile = entry.path().string();
                     }
                 }
 
-                // ˫¼
+                // 处理双击事件
                 if (ImGui::IsItemHovered() && ImGui::IsMouseDoubleClicked(0)) {
                     if (isDirectory) {
                         if (isParentDir) {
@@ -527,7 +550,7 @@ void ImGuiManager::DrawFileDialog(SSBO& ssbo, LightSSBO& lightSSBO) {
                     }
                 }
 
-                // ʾļ
+                // 显示文件名
                 ImGui::SameLine();
                 ImGui::Text("%s", displayName.c_str());
 
@@ -536,7 +559,7 @@ void ImGuiManager::DrawFileDialog(SSBO& ssbo, LightSSBO& lightSSBO) {
         }
         ImGui::EndChild();
 
-        // ļ루ģʽ
+        // 文件名输入（保存模式）
         static char fileName[256] = "untitled";
         if (!m_FileDialog.isOpenMode) {
             ImGui::InputText("File Name##Save", fileName, sizeof(fileName));
@@ -547,36 +570,21 @@ void ImGuiManager::DrawFileDialog(SSBO& ssbo, LightSSBO& lightSSBO) {
             m_FileDialog.selectedFile = fullPath.string();
         }
 
-        // ʾǰѡ
+        // 显示当前选择
         ImGui::TextColored(ImVec4(1, 1, 0, 1), "Selected: %s",
             m_FileDialog.selectedFile.empty() ? "None" : m_FileDialog.selectedFile.c_str());
 
-        // ť
+        // 操作按钮
         ImGui::BeginDisabled(m_FileDialog.isOpenMode && m_FileDialog.selectedFile.empty());
         if (ImGui::Button(m_FileDialog.isOpenMode ? "Open##FDConfirm" : "Save##FDConfirm")) {
             if (m_FileDialog.isOpenMode) {
-                // س
+                // 加载场景
                 if (std::filesystem::exists(m_FileDialog.selectedFile)) {
-                    ssbo.objects.clear();
-                    m_UIObjects.clear();
-                    lightSSBO.lights.clear();
-                    m_UILights.clear();
-
-                    if (SceneIO::Load(m_FileDialog.selectedFile, m_UIObjects, m_UILights)) {
-                        // ͬUI
-                        for (const auto& uiObj : m_UIObjects) {
-                            ssbo.objects.push_back(uiObj.obj);
-                        }
-						for (const auto& uiLight : m_UILights) {
-							lightSSBO.lights.push_back(uiLight.light);
-						}
-                        ssbo.update();
-                        lightSSBO.update();
-                    }
+                    LoadScene(m_FileDialog.selectedFile, ssbo, lightSSBO);
                 }
             }
             else {
-                // 泡
+                // 保存场景
                 if (!m_FileDialog.selectedFile.empty()) {
                     SceneIO::Save(m_FileDialog.selectedFile, m_UIObjects, m_UILights);
                 }
@@ -594,16 +602,56 @@ void ImGuiManager::DrawFileDialog(SSBO& ssbo, LightSSBO& lightSSBO) {
     }
 }
 
+bool ImGuiManager::LoadScene(const std::string& path, SSBO& ssbo, LightSSBO& lightSSBO)
+{
+    ssbo.objects.clear();
+    m_UIObjects.clear();
+    lightSSBO.lights.clear();
+    m_UILights.clear();
+
+    if (!SceneIO::Load(path, m_UIObjects, m_UILights)) return false;
+
+    // 同步UI对象
+    for (const auto& uiObj : m_UIObjects) {
+        ssbo.objects.push_back(uiObj.obj);
+    }
+    for (const auto& uiLight : m_UILights) {
+        lightSSBO.lights.push_back(uiLight.light);
+    }
+    ssbo.update();
+    lightSSBO.update();
+    return true;
+}
+
+void ImGuiManager::SetScene(const std::vector<Object>& objects, const std::vector<Light>& lights, SSBO& ssbo, LightSSBO& lightSSBO)
+{
+    // UI列表每帧会写回SSBO，因此两边一起替换；名称不在捕获中，按序号生成
+    m_UIObjects.resize(objects.size());
+    for (size_t i = 0; i < objects.size(); ++i) {
+        snprintf(m_UIObjects[i].name, sizeof(m_UIObjects[i].name), "Object %d", static_cast<int>(i));
+        m_UIObjects[i].obj = objects[i];
+    }
+    m_UILights.resize(lights.size());
+    for (size_t i = 0; i < lights.size(); ++i) {
+        snprintf(m_UILights[i].name, sizeof(m_UILights[i].name), "Light %d", static_cast<int>(i));
+        m_UILights[i].light = lights[i];
+    }
+    ssbo.objects = objects;
+    lightSSBO.lights = lights;
+    ssbo.update();
+    lightSSBO.update();
+}
+
 void ImGuiManager::RefreshFileList()
 {
     m_FileDialog.entries.clear();
 
-    // ӷϼĿ¼
+    // 添加返回上级目录
     if (m_FileDialog.currentPath != std::filesystem::path(m_FileDialog.currentPath).root_path()) {
         m_FileDialog.entries.emplace_back(std::filesystem::path(m_FileDialog.currentPath).parent_path());
     }
 
-    // ǰĿ¼
+    // 遍历当前目录
     for (const auto& entry : std::filesystem::directory_iterator(m_FileDialog.currentPath)) {
         if (entry.is_directory() ||
             (entry.is_regular_file() && entry.path().extension() == ".scene")) {
@@ -611,7 +659,7 @@ void ImGuiManager::RefreshFileList()
         }
     }
 
-    // Ŀ¼ǰļں
+    // 排序：目录在前，文件在后
     std::sort(m_FileDialog.entries.begin(), m_FileDialog.entries.end(),
         [](const auto& a, const auto& b) {
         if (a.is_directory() != b.is_directory())
@@ -622,11 +670,11 @@ void ImGuiManager::RefreshFileList()
 
 void ImGuiManager::HandleCameraMovement(Camera& camera, float deltaTime)
 {
-    // ֻδImGuiʱ
+    // 只在未激活ImGui时处理输入
     if (!ImGui::GetIO().WantCaptureKeyboard && !ImGui::GetIO().WantCaptureMouse) {
-        // סҼƶ
+        // 按住右键才能移动鼠标
         if (glfwGetMouseButton(m_Window, GLFW_MOUSE_BUTTON_RIGHT) == GLFW_PRESS) {
-            // ǰƶ
+            // 前后移动
             glm::vec3 moveDir(0.0f);
             if (glfwGetKey(m_Window, GLFW_KEY_W) == GLFW_PRESS)
                 moveDir += camera.Front;
@@ -636,7 +684,7 @@ void ImGuiManager::HandleCameraMovement(Camera& camera, float deltaTime)
                 moveDir -= camera.Right;
             if (glfwGetKey(m_Window, GLFW_KEY_D) == GLFW_PRESS)
                 moveDir += camera.Right;
-            // ƶ
+            // 上下移动
             if (glfwGetKey(m_Window, GLFW_KEY_Q) == GLFW_PRESS)
                 moveDir += camera.Up;
             if (glfwGetKey(m_Window, GLFW_KEY_E) == GLFW_PRESS)
@@ -8,6 +8,8 @@
 #include "LightSSBO.h"
 #include "AO.h"
 #include "Object.h"
+#include "EnvironmentSampler.h"
+#include "PerformanceProfiler.h"
 
 class SSBO;
 
@@ -33,7 +35,14 @@ public:
 	// Skybox
     GLuint GetCurrentSkyboxTexture() const { return m_CurrentSkyboxTexture; }
     bool IsSkyboxEnabled() const { return m_UseSkybox; }
+    bool IsEnvSamplingEnabled() const { return m_UseEnvSampling && m_EnvSampler.valid; }
+    const EnvironmentSampler& GetEnvironmentSampler() const { return m_EnvSampler; }
+    int GetSkyboxIndex() const { return m_SelectedSkyboxIndex; }
+    int GetSkyboxCount() const { return static_cast<int>(m_SkyboxPaths.size()); }
     void ChooseSkybox();
+    // 切换天空盒并重建重要性采样分布，索引未变时不做任何事
+    void SelectSkybox(int index);
+    void SetSkyboxEnabled(bool useSkybox, bool envSampling) { m_UseSkybox = useSkybox; m_UseEnvSampling = envSampling; }
 
     // Load / Save Scene
     void LoadSave(SSBO& ssbo, LightSSBO& lightSSBO);
@@ -45,14 +54,21 @@ public:
         std::vector<std::filesystem::directory_entry> entries;
     } m_FileDialog;
     void DrawFileDialog(SSBO& ssbo, LightSSBO& lightSSBO);
+    // 替换当前场景并上传SSBO（文件对话框和基准测试共用）
+    bool LoadScene(const std::string& path, SSBO& ssbo, LightSSBO& lightSSBO);
+    // 用给定的物体和光源替换当前场景（帧捕获回放）
+    void SetScene(const std::vector<Object>& objects, const std::vector<Light>& lights, SSBO& ssbo, LightSSBO& lightSSBO);
     void RefreshFileList();
 
     // TAA
 	bool IsTAAEnabled() const { return m_EnableTAA; }
 	float GetTAABlendFactor() const { return m_TAABlendFactor; }
+	void SetTAA(bool enabled, float blendFactor) { m_EnableTAA = enabled; m_TAABlendFactor = blendFactor; }
 
     // AO
     AOManager* aoManager;
+    // SSBO上传、天空盒转换计时
+    PerformanceProfiler* profiler;
 
 	void HandleCameraMovement(Camera& camera, float deltaTime);
     
@@ -64,6 +80,8 @@ private:
     bool m_UseSkybox = true;
     int m_SelectedSkyboxIndex = 0;
     GLuint m_CurrentSkyboxTexture = 0;
+    bool m_UseEnvSampling = true;   // 天空盒重要性采样
+    EnvironmentSampler m_EnvSampler;
     const std::vector<std::string> m_SkyboxPaths = {
         "belfast_sunset_puresky_2k.hdr",
         "christmas_photo_studio_01_2k.hdr",
@@ -85,7 +103,7 @@ private:
 
     // TAA
     bool m_EnableTAA = true;
-    float m_TAABlendFactor = 0.1f; // ʷ֡ϵ
+    float m_TAABlendFactor = 0.1f; // 历史帧混合系数
 
     void SetupStyle();
 };
\ No newline at end of file
@@ -0,0 +1,122 @@
+// Json.cpp
+#include "Json.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+bool JsonParser::Parse(JsonValue& value) {
+    if (!ParseValue(value)) return false;
+    SkipSpace();
+    return m_Pos == m_Text.size();
+}
+
+void JsonParser::SkipSpace() {
+    while (m_Pos < m_Text.size() && std::isspace(static_cast<unsigned char>(m_Text[m_Pos]))) ++m_Pos;
+}
+
+bool JsonParser::Consume(char c) {
+    SkipSpace();
+    if (m_Pos >= m_Text.size() || m_Text[m_Pos] != c) return false;
+    ++m_Pos;
+    return true;
+}
+
+bool JsonParser::ParseString(std::string& out) {
+    if (!Consume('"')) return false;
+    out.clear();
+    while (m_Pos < m_Text.size()) {
+        char c = m_Text[m_Pos++];
+        if (c == '"') return true;
+        if (c == '\\' && m_Pos < m_Text.size()) {
+            c = m_Text[m_Pos++];
+            if (c == 'n') c = '\n';
+            else if (c == 't') c = '\t';
+            else if (c == 'u') {
+                // 报告中不会出现，跳过码点
+                m_Pos = std::min(m_Pos + 4, m_Text.size());
+                c = '?';
+            }
+        }
+        out += c;
+    }
+    return false;
+}
+
+bool JsonParser::ParseValue(JsonValue& value) {
+    SkipSpace();
+    if (m_Pos >= m_Text.size()) return false;
+
+    const char c = m_Text[m_Pos];
+    if (c == '{') {
+        ++m_Pos;
+        value.type = JsonValue::Type::Object;
+        if (Consume('}')) return true;
+        do {
+            std::string key;
+            JsonValue item;
+            if (!ParseString(key) || !Consume(':') || !ParseValue(item)) return false;
+            value.keys.push_back(key);
+            value.items.push_back(std::move(item));
+        } while (Consume(','));
+        return Consume('}');
+    }
+    if (c == '[') {
+        ++m_Pos;
+        value.type = JsonValue::Type::Array;
+        if (Consume(']')) return true;
+        do {
+            JsonValue item;
+            if (!ParseValue(item)) return false;
+            value.items.push_back(std::move(item));
+        } while (Consume(','));
+        return Consume(']');
+    }
+    if (c == '"') {
+        value.type = JsonValue::Type::String;
+        return ParseString(value.string);
+    }
+    for (const char* literal : { "true", "false", "null" }) {
+        const size_t length = std::char_traits<char>::length(literal);
+        if (m_Text.compare(m_Pos, length, literal) == 0) {
+            m_Pos += length;
+            value.type = literal[0] == 'n' ? JsonValue::Type::Null : JsonValue::Type::Bool;
+            value.number = literal[0] == 't' ? 1.0 : 0.0;
+            return true;
+        }
+    }
+
+    char* end = nullptr;
+    value.number = std::strtod(m_Text.c_str() + m_Pos, &end);
+    if (end == m_Text.c_str() + m_Pos) return false;
+    value.type = JsonValue::Type::Number;
+    m_Pos = end - m_Text.c_str();
+    return true;
+}
+
+bool LoadJsonFile(const std::string& path, JsonValue& value) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open " << path << std::endl;
+        return false;
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    const std::string text = buffer.str();
+    if (!JsonParser(text).Parse(value)) {
+        std::cerr << path << " is not valid JSON" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+std::string JsonEscape(const std::string& text) {
+    std::string out;
+    for (char c : text) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    return out;
+}
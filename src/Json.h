@@ -0,0 +1,42 @@
+// Json.h
+#pragma once
+#include <string>
+#include <vector>
+
+// 最小的JSON读取：只用于读回本项目自己写出的报告（基准测试结果、基线）
+struct JsonValue {
+    enum class Type { Null, Bool, Number, String, Array, Object };
+    Type type = Type::Null;
+    double number = 0.0;
+    std::string string;
+    std::vector<std::string> keys;      // Object的键，与items一一对应
+    std::vector<JsonValue> items;       // Array元素或Object的值
+
+    const JsonValue* Find(const std::string& key) const {
+        for (size_t i = 0; i < keys.size(); ++i) {
+            if (keys[i] == key) return &items[i];
+        }
+        return nullptr;
+    }
+};
+
+class JsonParser {
+public:
+    explicit JsonParser(const std::string& text) : m_Text(text) {}
+
+    bool Parse(JsonValue& value);
+
+private:
+    void SkipSpace();
+    bool Consume(char c);
+    bool ParseString(std::string& out);
+    bool ParseValue(JsonValue& value);
+
+    const std::string& m_Text;
+    size_t m_Pos = 0;
+};
+
+// 读取并解析整个文件，失败时打印原因
+bool LoadJsonFile(const std::string& path, JsonValue& value);
+
+std::string JsonEscape(const std::string& text);
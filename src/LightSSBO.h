@@ -3,24 +3,35 @@
 #include "Light.h"
 #include <vector>
 #include <GL/glew.h>
+#include "GPUMemoryTracker.h"
 
 class LightSSBO {
 public:
-    GLuint id;
+    GLuint id = 0;
     std::vector<Light> lights;
 
     LightSSBO() = default;
+    ~LightSSBO() {
+        gpuMemory.DeleteBuffers(1, &id);
+    }
     void Init() {
         glGenBuffers(1, &id);
     }
     void update() {
+        // 同SSBO：容量不足时才重新分配
+        const size_t bytes = lights.size() * sizeof(Light);
         glBindBuffer(GL_SHADER_STORAGE_BUFFER, id);
-        glBufferData(
-            GL_SHADER_STORAGE_BUFFER,
-            lights.size() * sizeof(Light),
-            lights.data(),
-            GL_DYNAMIC_DRAW
-        );
-        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, id); // 󶨵1
+        if (bytes > capacity) {
+            glBufferData(GL_SHADER_STORAGE_BUFFER, bytes, lights.data(), GL_DYNAMIC_DRAW);
+            capacity = bytes;
+            gpuMemory.TrackBuffer(id, "Scene", "Lights", capacity);
+        }
+        else if (bytes > 0) {
+            glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, bytes, lights.data());
+        }
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, id); // 绑定到索引1
     }
-};
\ No newline at end of file
+
+private:
+    size_t capacity = 0;
+};
@@ -11,17 +11,17 @@ struct AABB {
 };
 
 struct Object {
-    alignas(4) ObjectType type;         // 4ֽڶ룬ռ4ֽ
-    alignas(16) glm::vec3 position;     // 16ֽڶ룬ռ12ֽ
-    alignas(4) float radius = 1.0f;            // 4ֽڶ룬ռ4ֽ
-    alignas(16) glm::vec3 normal = glm::vec3(0.0f, 1.0f, 0.0f);       // 16ֽڶ룬ռ12ֽ
-    alignas(16) glm::vec2 size = glm::vec2(1.0f, 1.0f);       // ƽߴ磨width, height
-    alignas(16) Material material;      // 16ֽڶ룬ռ48ֽ
-    alignas(16) AABB bounds; // AABB
+    alignas(4) ObjectType type;         // 4字节对齐，占4字节
+    alignas(16) glm::vec3 position;     // 16字节对齐，占12字节
+    alignas(4) float radius = 1.0f;            // 4字节对齐，占4字节
+    alignas(16) glm::vec3 normal = glm::vec3(0.0f, 1.0f, 0.0f);       // 16字节对齐，占12字节
+    alignas(16) glm::vec2 size = glm::vec2(1.0f, 1.0f);       // 新增：平面尺寸（width, height）
+    alignas(16) Material material;      // 16字节对齐，占48字节
+    alignas(16) AABB bounds; // 新增AABB
 };
 
 
-// UIö󣨰ƣ
+// UI用对象（包含名称）
 struct UIObject {
     char name[128] = "New Object";
     Object obj;
@@ -0,0 +1,122 @@
+// PathLengthController.cpp
+#include "PathLengthController.h"
+#include <imgui.h>
+#include "GPUMemoryTracker.h"
+#include <algorithm>
+
+PathLengthController::~PathLengthController() {
+    for (int i = 0; i < READBACK_FRAMES; ++i) {
+        if (m_Fences[i]) glDeleteSync(m_Fences[i]);
+    }
+    gpuMemory.DeleteBuffers(READBACK_FRAMES, m_Buffers);
+}
+
+void PathLengthController::Init() {
+    glGenBuffers(READBACK_FRAMES, m_Buffers);
+    for (int i = 0; i < READBACK_FRAMES; ++i) {
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_Buffers[i]);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(PathStats), nullptr, GL_DYNAMIC_READ);
+        gpuMemory.TrackBuffer(m_Buffers[i], "PathLength", "Readback " + std::to_string(i), sizeof(PathStats));
+    }
+}
+
+void PathLengthController::BeginFrame() {
+    if (!collectStats) return;
+
+    GLuint buffer = m_Buffers[m_WriteIndex];
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffer);
+    glClearBufferData(GL_SHADER_STORAGE_BUFFER, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, buffer); // 绑定到索引4
+}
+
+void PathLengthController::EndFrame() {
+    if (!collectStats) return;
+
+    // 保证着色器写入对glGetBufferSubData可见
+    glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+    if (m_Fences[m_WriteIndex]) glDeleteSync(m_Fences[m_WriteIndex]);
+    m_Fences[m_WriteIndex] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    m_WriteIndex = (m_WriteIndex + 1) % READBACK_FRAMES;
+
+    // 只读取GPU已经完成的最旧一帧，不阻塞CPU
+    GLsync& fence = m_Fences[m_WriteIndex];
+    if (!fence) return;
+    GLenum status = glClientWaitSync(fence, 0, 0);
+    if (status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED) {
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_Buffers[m_WriteIndex]);
+        glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(PathStats), &m_Stats);
+        m_StatsValid = true;
+        glDeleteSync(fence);
+        fence = nullptr;
+    }
+}
+
+void PathLengthController::Update(double rayTracingMs, float budgetMs, bool allowReduce, bool allowGrow) {
+    if (rayTracingMs <= 0.0) return;
+    m_SmoothedMs = m_SmoothedMs == 0.0 ? rayTracingMs : m_SmoothedMs * 0.9 + rayTracingMs * 0.1;
+    m_BudgetMs = budgetMs;
+
+    if (!autoAdjust) return;
+    if (m_Cooldown > 0) {
+        --m_Cooldown;
+        return;
+    }
+
+    if (m_SmoothedMs > budgetMs) {
+        if (!allowReduce) return;
+        // 超出预算：先让轮盘赌更早介入，再减小最大深度
+        if (rouletteStart > 1) rouletteStart--;
+        else if (maxDepth > 1) maxDepth--;
+        else return;
+    }
+    else if (m_SmoothedMs < budgetMs * 0.7) {
+        if (!allowGrow) return;
+        // 预算充足：先加深路径（由轮盘赌控制开销），再推迟轮盘赌
+        if (maxDepth < MAX_PATH_LENGTH) maxDepth++;
+        else if (rouletteStart < maxDepth) rouletteStart++;
+        else return;
+    }
+    else {
+        return;
+    }
+
+    rouletteStart = std::min(rouletteStart, maxDepth);
+    m_Cooldown = 30; // 等待平滑耗时反映新参数，避免振荡
+}
+
+void PathLengthController::DrawUI() {
+    ImGui::SetNextWindowPos(ImVec2(10, 250), ImGuiCond_FirstUseEver);
+    ImGui::SetNextWindowCollapsed(true, ImGuiCond_FirstUseEver);
+    ImGui::Begin("Path Budget", &showSettings);
+
+    ImGui::Checkbox("Auto Adjust", &autoAdjust);
+    ImGui::Text("Budget: %.1f ms (set in Dynamic Resolution)", m_BudgetMs);
+    ImGui::Text("RayTracing (smoothed): %.2f ms", m_SmoothedMs);
+    ImGui::TextWrapped("With Dynamic Resolution on, depth is only reduced at the min scale and only raised at the max scale.");
+
+    ImGui::BeginDisabled(autoAdjust);
+    ImGui::SliderInt("Max Depth", &maxDepth, 1, MAX_PATH_LENGTH);
+    ImGui::SliderInt("Roulette Start", &rouletteStart, 0, maxDepth);
+    ImGui::EndDisabled();
+
+    ImGui::Separator();
+    ImGui::Checkbox("Path Length Histogram", &collectStats);
+    if (collectStats && m_StatsValid) {
+        float histogram[MAX_PATH_LENGTH + 1] = {};
+        double total = 0.0, segments = 0.0;
+        for (int i = 0; i <= MAX_PATH_LENGTH; ++i) {
+            total += m_Stats.pathLength[i];
+            segments += static_cast<double>(m_Stats.pathLength[i]) * i;
+        }
+        for (int i = 0; i <= MAX_PATH_LENGTH; ++i) {
+            histogram[i] = total > 0.0 ? static_cast<float>(m_Stats.pathLength[i] / total) : 0.0f;
+        }
+        const int bins = std::min(maxDepth, MAX_PATH_LENGTH) + 1;
+        ImGui::PlotHistogram("##PathLength", histogram, bins, 0, "segments per path", 0.0f, 1.0f, ImVec2(0, 80));
+        ImGui::Text("Avg segments: %.2f", total > 0.0 ? segments / total : 0.0);
+        ImGui::Text("Total segments: %.0f", segments);
+        ImGui::Text("Roulette terminations: %u", m_Stats.rouletteTerminations);
+    }
+
+    ImGui::End();
+}
@@ -0,0 +1,52 @@
+// PathLengthController.h
+#pragma once
+#include <GL/glew.h>
+#include <cstdint>
+
+// 运行时路径长度预算：根据光追阶段的GPU耗时调整最大深度和俄罗斯轮盘赌起始深度
+// 同时统计每帧的路径长度直方图（SSBO binding = 4，异步回读）
+class PathLengthController {
+public:
+    static constexpr int MAX_PATH_LENGTH = 16;  // 需与raytracingCs.glsl一致
+    static constexpr int READBACK_FRAMES = 3;   // 回读环形缓冲深度
+
+    // 与着色器中PathStats布局一致
+    struct PathStats {
+        uint32_t pathLength[MAX_PATH_LENGTH + 1];
+        uint32_t rouletteTerminations;
+    };
+
+    // 参数
+    int maxDepth = 3;
+    int rouletteStart = 1;
+    bool autoAdjust = true;
+    bool collectStats = true;
+    bool showSettings = true;
+
+    PathLengthController() = default;
+    ~PathLengthController();
+    void Init();
+
+    // 光追dispatch前调用：绑定并清空本帧的统计缓冲
+    void BeginFrame();
+    // 光追dispatch后调用：插入fence，并回读已完成的旧帧数据
+    void EndFrame();
+    // 根据测得的光追耗时调整深度参数；预算由动态分辨率提供，
+    // allowReduce/allowGrow为false时不向该方向调整（动态分辨率优先）
+    void Update(double rayTracingMs, float budgetMs, bool allowReduce, bool allowGrow);
+    void DrawUI();
+
+    const PathStats& GetStats() const { return m_Stats; }
+
+private:
+    GLuint m_Buffers[READBACK_FRAMES] = {};
+    GLsync m_Fences[READBACK_FRAMES] = {};
+    int m_WriteIndex = 0;
+
+    PathStats m_Stats = {};
+    bool m_StatsValid = false;
+
+    double m_SmoothedMs = 0.0;
+    float m_BudgetMs = 0.0f;        // 最近一次使用的预算（用于UI）
+    int m_Cooldown = 0;
+};
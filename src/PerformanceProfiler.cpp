@@ -1,72 +1,217 @@
 #include "PerformanceProfiler.h"
+#include "GPUCounters.h"
 #include <imgui.h>
 #include <algorithm>
 #include <iostream>
 
+static constexpr int INITIAL_QUERIES = 32;  // 每帧预分配的时间戳查询数，不够时再增长
+
+PerformanceProfiler::Scope::Scope(PerformanceProfiler& profiler, const char* name, bool gpu)
+    : m_profiler(profiler), m_record(profiler.BeginScope(name, gpu)) {
+}
+
+PerformanceProfiler::Scope::~Scope() {
+    m_profiler.EndScope(m_record);
+}
+
 PerformanceProfiler::PerformanceProfiler(size_t historySize)
     : m_frameHistory(historySize),
     m_gpuTimeHistory(historySize, 0.0f) {
 }
 
 PerformanceProfiler::~PerformanceProfiler() {
-    glDeleteQueries(QUERY_FRAME_COUNT * STAGES_PER_FRAME, &m_queryPool[0][0]);
+    for (QuerySlot& slot : m_slots) {
+        if (!slot.queries.empty()) glDeleteQueries(static_cast<GLsizei>(slot.queries.size()), slot.queries.data());
+    }
 }
 
 void PerformanceProfiler::Init(){
-    glGenQueries(QUERY_FRAME_COUNT * STAGES_PER_FRAME, &m_queryPool[0][0]);
+    for (QuerySlot& slot : m_slots) {
+        slot.queries.resize(INITIAL_QUERIES);
+        glGenQueries(INITIAL_QUERIES, slot.queries.data());
+    }
 }
 
 void PerformanceProfiler::BeginFrame() {
-    m_activeQueryIndex = m_currentFrameIndex % QUERY_FRAME_COUNT;
+    queryFrames = std::clamp(queryFrames, 2, MAX_QUERY_FRAMES);
+    m_activeSlot = static_cast<int>(m_currentFrameIndex % queryFrames);
+
+    // GPU落后太多，环形缓冲已满：丢弃最旧一帧的结果，不阻塞CPU
+    QuerySlot& slot = m_slots[m_activeSlot];
+    if (slot.pending) {
+        m_droppedFrames++;
+        m_trace.OnFrameResolved(slot.frameIndex);
+    }
+    slot.pending = false;
+    slot.frameIndex = m_currentFrameIndex;
+    slot.usedQueries = 0;
+    slot.records.clear();
+    m_stack.clear();
+    m_inFrame = true;
+
+    m_trace.BeginFrame(m_currentFrameIndex);
+    m_frameBeginUs = m_trace.NowUs();
 }
 
-void PerformanceProfiler::BeginGPUSection(Stage stage) {
-    const int baseIdx = static_cast<int>(stage) * 2;
-    glQueryCounter(m_queryPool[m_activeQueryIndex][baseIdx], GL_TIMESTAMP);
+int PerformanceProfiler::FindOrRegister(const char* name, int parent, bool gpu) {
+    const std::vector<int>& siblings = parent < 0 ? m_roots : m_nodes[parent].children;
+    for (int node : siblings) {
+        if (m_nodes[node].name == name) return node;
+    }
+
+    ScopeNode node;
+    node.name = name;
+    node.parent = parent;
+    node.gpu = gpu;
+    m_nodes.push_back(node);
+    const int id = static_cast<int>(m_nodes.size() - 1);
+    if (parent < 0) m_roots.push_back(id);
+    else m_nodes[parent].children.push_back(id);
+    return id;
 }
 
-void PerformanceProfiler::EndGPUSection(Stage stage) {
-    const int baseIdx = static_cast<int>(stage) * 2 + 1;
-    glQueryCounter(m_queryPool[m_activeQueryIndex][baseIdx], GL_TIMESTAMP);
+int PerformanceProfiler::BeginScope(const char* name, bool gpu) {
+    if (!m_inFrame) return -1;
+
+    QuerySlot& slot = m_slots[m_activeSlot];
+    const int parent = m_stack.empty() ? -1 : slot.records[m_stack.back()].node;
+
+    ScopeRecord record;
+    record.node = FindOrRegister(name, parent, gpu);
+    if (gpu) {
+        if (slot.usedQueries + 2 > static_cast<int>(slot.queries.size())) {
+            const size_t oldSize = slot.queries.size();
+            slot.queries.resize(oldSize * 2);
+            glGenQueries(static_cast<GLsizei>(oldSize), slot.queries.data() + oldSize);
+        }
+        record.query = slot.usedQueries;
+        slot.usedQueries += 2;
+        glQueryCounter(slot.queries[record.query], GL_TIMESTAMP);
+    }
+    record.cpuBeginUs = m_trace.NowUs();
+
+    slot.records.push_back(record);
+    m_stack.push_back(static_cast<int>(slot.records.size() - 1));
+    return m_stack.back();
+}
+
+void PerformanceProfiler::EndScope(int record) {
+    if (record < 0 || !m_inFrame) return;
+
+    QuerySlot& slot = m_slots[m_activeSlot];
+    ScopeRecord& r = slot.records[record];
+    if (r.query >= 0) glQueryCounter(slot.queries[r.query + 1], GL_TIMESTAMP);
+    r.cpuEndUs = m_trace.NowUs();
+    m_stack.pop_back();
+
+    m_trace.AddCPUEvent(m_nodes[r.node].name.c_str(), m_currentFrameIndex, r.cpuBeginUs, r.cpuEndUs);
 }
 
 void PerformanceProfiler::EndFrame(float cpuTimeMs) {
-    FrameStats stats;
-    stats.cpuTime = cpuTimeMs;
+    QuerySlot& slot = m_slots[m_activeSlot];
+    slot.pending = true;
+    slot.cpuTime = cpuTimeMs;
+    m_inFrame = false;
+    m_trace.AddCPUEvent("Frame", m_currentFrameIndex, m_frameBeginUs, m_trace.NowUs());
 
     m_currentFrameIndex++;
-    // ǰһ֡Ĳѯ
+    // 回读所有已经完成的旧帧
     ProcessQueries();
+}
+
+bool PerformanceProfiler::IsSlotAvailable(const QuerySlot& slot) const {
+    for (const ScopeRecord& r : slot.records) {
+        if (r.query < 0) continue;
+        // 时间戳按提交顺序完成，但每个结束查询都检查一遍代价也很小
+        GLint available = GL_FALSE;
+        glGetQueryObjectiv(slot.queries[r.query + 1], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) return false;
+    }
+    return true;
+}
+
+void PerformanceProfiler::ReadSlot(QuerySlot& slot) {
+    // 原地覆盖最旧的历史项，scopes保留容量，稳定后不再分配内存
+    FrameStats& stats = m_frameHistory[m_historyHead];
+    stats.cpuTime = slot.cpuTime;
+    stats.frameIndex = slot.frameIndex;
+    stats.scopes.assign(m_nodes.size(), ScopeTiming());
+    for (const ScopeRecord& r : slot.records) {
+        ScopeTiming& timing = stats.scopes[r.node];
+        timing.cpuMs += (r.cpuEndUs - r.cpuBeginUs) / 1000.0;
+        timing.calls++;
+        if (r.query < 0) continue;
+
+        GLuint64 startTime = 0, endTime = 0;
+        glGetQueryObjectui64v(slot.queries[r.query], GL_QUERY_RESULT, &startTime);
+        glGetQueryObjectui64v(slot.queries[r.query + 1], GL_QUERY_RESULT, &endTime);
+        // 计算时间间隔
+        timing.gpuMs += static_cast<double>(endTime - startTime) / 1000000.0;
+        m_trace.AddGPUEvent(m_nodes[r.node].name.c_str(), slot.frameIndex, startTime, endTime);
+    }
+    stats.gpuDataValid = true;
+    slot.pending = false;
+
+    double gpuTotal = 0.0;
+    for (int root : m_roots) gpuTotal += stats.scopes[root].gpuMs;
+    m_gpuTimeHistory[m_historyHead] = static_cast<float>(gpuTotal);
+    m_historyHead = (m_historyHead + 1) % static_cast<int>(m_frameHistory.size());
 
-    // ʷ¼
-    if (m_frameHistory.size() >= m_frameHistory.capacity()) {
-        m_frameHistory.erase(m_frameHistory.begin());
+    // 滚动统计：GPU作用域按GPU时间，仅CPU的作用域按CPU时间
+    m_statistics.AddFrame(slot.frameIndex, slot.cpuTime, static_cast<float>(gpuTotal), static_cast<int>(m_nodes.size()));
+    for (size_t i = 0; i < stats.scopes.size(); ++i) {
+        const ScopeTiming& timing = stats.scopes[i];
+        if (timing.calls == 0) continue;
+        const bool gpu = m_nodes[i].gpu;
+        double exclusive = gpu ? timing.gpuMs : timing.cpuMs;
+        for (int child : m_nodes[i].children) {
+            if (child < static_cast<int>(stats.scopes.size())) exclusive -= gpu ? stats.scopes[child].gpuMs : stats.scopes[child].cpuMs;
+        }
+        m_statistics.AddScope(static_cast<int>(i), static_cast<float>(gpu ? timing.gpuMs : timing.cpuMs),
+            static_cast<float>(std::max(exclusive, 0.0)));
     }
-    m_frameHistory.push_back(stats);
 
+    m_trace.OnFrameResolved(slot.frameIndex);
 }
 
 void PerformanceProfiler::ProcessQueries() {
-    // ѯҪȴGPU
-    glFinish();
-    // һ֡Ĳѯлȡ
-    const int prevQueryIndex = (m_currentFrameIndex - 1) % QUERY_FRAME_COUNT;
-    for (int i = 0; i < STAGES_PER_FRAME; i += 2) {
-        GLuint64 startTime, endTime;
-        glGetQueryObjectui64v(m_queryPool[prevQueryIndex][i], GL_QUERY_RESULT, &startTime);
-        glGetQueryObjectui64v(m_queryPool[prevQueryIndex][i + 1], GL_QUERY_RESULT, &endTime);
-        // ʱ
-        const double timeMs = static_cast<double>(endTime - startTime) / 1000000.0;
-        const int stageIdx = i / 2;
-        m_frameHistory.back().gpuTimes[stageIdx] = timeMs;
-        m_gpuTimeHistory.push_back(timeMs);
-    }
-    m_frameHistory.back().gpuDataValid = true;
+    // 按帧序读取，遇到第一帧未完成就停止（之后的帧更不可能完成）
+    m_newResults = false;
+    while (true) {
+        QuerySlot* oldest = nullptr;
+        for (QuerySlot& slot : m_slots) {
+            if (slot.pending && (!oldest || slot.frameIndex < oldest->frameIndex)) oldest = &slot;
+        }
+        if (!oldest || !IsSlotAvailable(*oldest)) break;
+        ReadSlot(*oldest);
+        m_newResults = true;
+    }
 }
 
 const PerformanceProfiler::FrameStats&
 PerformanceProfiler::GetLatestStats() const {
-    return m_frameHistory.back();
+    const int size = static_cast<int>(m_frameHistory.size());
+    return m_frameHistory[(m_historyHead + size - 1) % size];
+}
+
+const PerformanceProfiler::FrameStats*
+PerformanceProfiler::FindStats(long long frameIndex) const {
+    for (const FrameStats& stats : m_frameHistory) {
+        if (stats.gpuDataValid && stats.frameIndex == frameIndex) return &stats;
+    }
+    return nullptr;
+}
+
+double PerformanceProfiler::GetGPUTime(const char* name) const {
+    return GetGPUTime(GetLatestStats(), name);
+}
+
+double PerformanceProfiler::GetGPUTime(const FrameStats& stats, const char* name) const {
+    double total = 0.0;
+    for (size_t i = 0; i < stats.scopes.size(); ++i) {
+        if (m_nodes[i].name == name) total += stats.scopes[i].gpuMs;
+    }
+    return total;
 }
 
 const std::vector<float>&
@@ -74,38 +219,77 @@ PerformanceProfiler::GetGPUTimeHistory() const {
     return m_gpuTimeHistory;
 }
 
-void PerformanceProfiler::DrawImGuiPanel() const {
+void PerformanceProfiler::DrawScopeNode(int node, const FrameStats& stats) const {
+    if (node >= static_cast<int>(stats.scopes.size()) || stats.scopes[node].calls == 0) return;
+
+    const ScopeNode& scope = m_nodes[node];
+    const ScopeTiming& timing = stats.scopes[node];
+    // 独占时间 = 包含时间 - 子作用域的包含时间
+    double childCpu = 0.0, childGpu = 0.0;
+    bool hasChildren = false;
+    for (int child : scope.children) {
+        if (child >= static_cast<int>(stats.scopes.size()) || stats.scopes[child].calls == 0) continue;
+        childCpu += stats.scopes[child].cpuMs;
+        childGpu += stats.scopes[child].gpuMs;
+        hasChildren = true;
+    }
+
+    ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_DefaultOpen | ImGuiTreeNodeFlags_SpanFullWidth;
+    if (!hasChildren) flags |= ImGuiTreeNodeFlags_Leaf;
+    const bool open = ImGui::TreeNodeEx(&scope, flags, "%s", scope.name.c_str());
+    ImGui::SameLine(200);
+    if (scope.gpu) {
+        ImGui::Text("%6.2f %6.2f | %6.2f %6.2f", timing.gpuMs, std::max(timing.gpuMs - childGpu, 0.0),
+            timing.cpuMs, std::max(timing.cpuMs - childCpu, 0.0));
+    }
+    else {
+        ImGui::Text("     -      - | %6.2f %6.2f", timing.cpuMs, std::max(timing.cpuMs - childCpu, 0.0));
+    }
+    if (open) {
+        for (int child : scope.children) DrawScopeNode(child, stats);
+        ImGui::TreePop();
+    }
+}
+
+void PerformanceProfiler::DrawImGuiPanel() {
     ImGui::SetNextWindowPos(ImVec2(10, 220), ImGuiCond_FirstUseEver);
     ImGui::SetNextWindowCollapsed(true, ImGuiCond_FirstUseEver);
     ImGui::Begin("Performance Profiler");
 
-    if (m_frameHistory.empty()) {
+    // 最近的有效数据
+    const FrameStats* validStats = &GetLatestStats();
+    if (!validStats->gpuDataValid) {
         ImGui::Text("No data available");
         ImGui::End();
         return;
     }
 
-    // Ч
-    const FrameStats* validStats = nullptr;
-    for (auto it = m_frameHistory.rbegin(); it != m_frameHistory.rend(); ++it) {
-        if (it->gpuDataValid) {
-            validStats = &(*it);
-            break;
-        }
-    }
-
     ImGui::TextColored(ImVec4(1, 0.5, 0, 1), "CPU Frame: %.2f ms", validStats->cpuTime);
+    ImGui::Text("GPU latency: %lld frames, dropped: %d",
+        m_currentFrameIndex - 1 - validStats->frameIndex, m_droppedFrames);
+    ImGui::SliderInt("Query Frames", &queryFrames, 2, MAX_QUERY_FRAMES);
     ImGui::Separator();
-    ImGui::TextColored(ImVec4(0, 1, 1, 1), "GPU Breakdown:");
-    ImGui::Text("RayTracing: %6.2f ms", validStats->gpuTimes[0]);
-    ImGui::Text("BloomExtract: %6.2f ms", validStats->gpuTimes[1]);
-    ImGui::Text("BloomBlur: %6.2f ms", validStats->gpuTimes[2]);
-    ImGui::Text("TAA: %6.2f ms", validStats->gpuTimes[3]);
+    ImGui::TextColored(ImVec4(0, 1, 1, 1), "Scopes (ms):");
+    ImGui::SameLine(200);
+    ImGui::TextColored(ImVec4(0, 1, 1, 1), "GPU incl   excl |  CPU incl  excl");
+    for (int root : m_roots) DrawScopeNode(root, *validStats);
 
-    // ʷͼ
+    // 绘制历史图表
     ImGui::Separator();
     ImGui::TextColored(ImVec4(0, 1, 0, 1), "GPU Time History:");
-    ImGui::PlotLines("##GPU Time", &m_gpuTimeHistory[0], m_gpuTimeHistory.size(), 0, nullptr, 0.0f, 50.0f, ImVec2(0, 80));
+    ImGui::PlotLines("##GPU Time", m_gpuTimeHistory.data(), static_cast<int>(m_gpuTimeHistory.size()), m_historyHead, nullptr, 0.0f, 50.0f, ImVec2(0, 80));
+
+    if (ImGui::CollapsingHeader("Frame Statistics")) {
+        m_statistics.DrawUI(*this);
+    }
+
+    if (counters && ImGui::CollapsingHeader("GPU Counters")) {
+        counters->DrawStats(*this);
+    }
+
+    if (ImGui::CollapsingHeader("Trace Capture")) {
+        m_trace.DrawUI(m_currentFrameIndex);
+    }
 
     ImGui::End();
-}
\ No newline at end of file
+}
@@ -1,47 +1,127 @@
 #pragma once
+#include <string>
 #include <vector>
 #include <GL/glew.h>
+#include "TraceRecorder.h"
+#include "FrameStatistics.h"
 
+class GPUCounters;
+
+// 分层计时：作用域在第一次使用时按（父作用域, 名称）注册，同时记录CPU耗时和GPU时间戳区间
+// 新的pass用一行即可计时：
+//     PerformanceProfiler::Scope scope(profiler, "MyPass");
 class PerformanceProfiler {
 public:
-    enum class Stage {
-        RayTracing,
-        BloomExtract,
-        BloomBlur,
-        TAA,
-        Count // 
+    // 一个作用域节点在一帧中的耗时（包含子作用域，同一帧多次进入时累加）
+    struct ScopeTiming {
+        double cpuMs = 0.0;
+        double gpuMs = 0.0;
+        int calls = 0;
+    };
+
+    struct ScopeNode {
+        std::string name;
+        int parent = -1;
+        bool gpu = true;
+        std::vector<int> children;
     };
 
     struct FrameStats {
         double cpuTime = 0.0;
-        double gpuTimes[static_cast<int>(Stage::Count)] = { 0 };
+        std::vector<ScopeTiming> scopes;    // 按节点id索引
         bool gpuDataValid = false;
+        long long frameIndex = -1;  // GPU数据所属的帧（异步回读，落后于当前帧）
+    };
+
+    // RAII作用域；不在BeginFrame/EndFrame之间时不计时
+    class Scope {
+    public:
+        Scope(PerformanceProfiler& profiler, const char* name, bool gpu = true);
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    private:
+        PerformanceProfiler& m_profiler;
+        int m_record;
     };
 
+    static constexpr int MAX_QUERY_FRAMES = 8;
+
     PerformanceProfiler(size_t historySize = 60);
     ~PerformanceProfiler();
     void Init();
 
     void BeginFrame();
-    void BeginGPUSection(Stage stage);
-    void EndGPUSection(Stage stage);
     void EndFrame(float cpuTimeMs);
 
+    // 最近一帧已回读的GPU数据
     const FrameStats& GetLatestStats() const;
+    // 历史中指定帧的数据，不存在时返回nullptr
+    const FrameStats* FindStats(long long frameIndex) const;
+    // 最近一帧（或指定帧）中名为name的作用域的GPU耗时（包含子作用域，未执行时为0）
+    double GetGPUTime(const char* name) const;
+    double GetGPUTime(const FrameStats& stats, const char* name) const;
+    long long GetFrameIndex() const { return m_currentFrameIndex; }
+    // 本帧EndFrame是否回读到了新的GPU数据（控制器只在有新数据时更新）
+    bool HasNewResults() const { return m_newResults; }
+    // 环形缓冲，最旧的样本位于GetHistoryOffset()
     const std::vector<float>& GetGPUTimeHistory() const;
+    int GetHistoryOffset() const { return m_historyHead; }
+    const std::vector<ScopeNode>& GetScopes() const { return m_nodes; }
+    TraceRecorder& GetTrace() { return m_trace; }
+    FrameStatistics& GetStatistics() { return m_statistics; }
 
-    void DrawImGuiPanel() const;
+    void DrawImGuiPanel();
+
+    // 查询环形缓冲深度：GPU落后CPU超过该帧数时丢弃最旧的结果而不是等待
+    int queryFrames = 4;
+    // 光线计数（由管线设置），与阶段耗时一起显示
+    GPUCounters* counters = nullptr;
 
 private:
-	static constexpr int QUERY_FRAME_COUNT = 2; // ˫
-    static constexpr int STAGES_PER_FRAME = static_cast<int>(Stage::Count) * 2;
+    // 一次作用域执行
+    struct ScopeRecord {
+        int node;
+        int query = -1;             // 起始时间戳在QuerySlot::queries中的下标，结束为query + 1；-1表示仅CPU
+        double cpuBeginUs = 0.0, cpuEndUs = 0.0;
+    };
 
-    GLuint m_queryPool[QUERY_FRAME_COUNT][STAGES_PER_FRAME];
-    int m_currentFrameIndex = 0;
-    int m_activeQueryIndex = 0;
+    // 一帧的时间戳查询，查询对象按需增长
+    struct QuerySlot {
+        std::vector<GLuint> queries;
+        int usedQueries = 0;
+        std::vector<ScopeRecord> records;
+        bool pending = false;
+        long long frameIndex = -1;
+        float cpuTime = 0.0f;
+    };
+
+    int BeginScope(const char* name, bool gpu);
+    void EndScope(int record);
+    int FindOrRegister(const char* name, int parent, bool gpu);
+
+    void ProcessQueries();
+    bool IsSlotAvailable(const QuerySlot& slot) const;
+    void ReadSlot(QuerySlot& slot);
+    void DrawScopeNode(int node, const FrameStats& stats) const;
 
+    std::vector<ScopeNode> m_nodes;
+    std::vector<int> m_roots;
+    std::vector<int> m_stack;       // 当前打开的作用域（records下标）
+    bool m_inFrame = false;
+
+    QuerySlot m_slots[MAX_QUERY_FRAMES];
+    int m_activeSlot = 0;
+    long long m_currentFrameIndex = 0;
+    int m_droppedFrames = 0;
+    bool m_newResults = false;
+    double m_frameBeginUs = 0.0;
+
+    // 固定大小的环形缓冲，m_historyHead为下一次写入的位置
     std::vector<FrameStats> m_frameHistory;
     std::vector<float> m_gpuTimeHistory;
+    int m_historyHead = 0;
 
-    void ProcessQueries();
-};
\ No newline at end of file
+    TraceRecorder m_trace;
+    FrameStatistics m_statistics;
+};
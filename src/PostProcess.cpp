@@ -0,0 +1,257 @@
+// PostProcess.cpp
+#include "PostProcess.h"
+#include <imgui.h>
+#include "global.h"
+#include "GPUMemoryTracker.h"
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+PostProcessor::PostProcessor(int width, int height)
+    : screenWidth(width), screenHeight(height) {
+}
+
+PostProcessor::~PostProcessor() {
+    gpuMemory.DeleteTextures(2, m_HistoryTex);
+}
+
+void PostProcessor::Init() {
+    m_ResolveShader.Init("shader/post_resolveCs.glsl");
+    m_TAAUShader.Init("shader/post_taauCs.glsl");
+    m_CompositeShader.Init("shader/outputVs.glsl", "shader/post_compositeFs.glsl");
+    CreateTextures();
+}
+
+void PostProcessor::Resize(int width, int height) {
+    screenWidth = width;
+    screenHeight = height;
+    CreateTextures();
+}
+
+void PostProcessor::CreateTextures() {
+    gpuMemory.DeleteTextures(2, m_HistoryTex);
+    glGenTextures(2, m_HistoryTex);
+    for (int i = 0; i < 2; i++) {
+        glBindTexture(GL_TEXTURE_2D, m_HistoryTex[i]);
+        glTexImage2D(GL_TEXTURE_2D, 0, HDRPrecision::GetGLFormat(GetHistoryFormat()), screenWidth, screenHeight, 0, GL_RGBA, GL_FLOAT, nullptr);
+        gpuMemory.TrackTexture(m_HistoryTex[i], "PostProcess", "TAAU history " + std::to_string(i),
+            HDRPrecision::GetGLFormat(GetHistoryFormat()), screenWidth, screenHeight);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    }
+    m_AllocatedHistoryFormat = GetHistoryFormat();
+    m_HistoryValid = false;
+}
+
+void PostProcessor::SetHistorySettings(bool enableUpscale, HDRFormat format) {
+    if (enableUpscale != upscale) m_HistoryValid = false;
+    upscale = enableUpscale;
+    historyFormat = format;
+    if (GetHistoryFormat() != m_AllocatedHistoryFormat) CreateTextures();
+}
+
+HDRFormat PostProcessor::GetHistoryFormat() const {
+    return upscale && historyFormat == HDRFormat::R11G11B10F ? HDRFormat::RGBA16F : historyFormat;
+}
+
+glm::vec2 PostProcessor::NextJitter(int renderWidth, int renderHeight) {
+    // 相位数随上采样倍数增加，保证每个输出像素附近都能落入足够的采样
+    const double ratio = static_cast<double>(screenWidth) * screenHeight / (static_cast<double>(renderWidth) * renderHeight);
+    const int phases = std::min(std::max(static_cast<int>(std::ceil(8.0 * ratio)), 8), 32);
+    m_JitterIndex = m_JitterIndex % phases + 1;
+    m_Jitter = glm::vec2(haltonSequence(m_JitterIndex, 2), haltonSequence(m_JitterIndex, 3)) - 0.5f;
+    return m_Jitter;
+}
+
+GLenum PostProcessor::GetSceneGLFormat() const {
+    return m_BenchmarkRequested ? GL_RGBA32F : HDRPrecision::GetGLFormat(sceneFormat);
+}
+
+void PostProcessor::RunPrecisionBenchmark(GLuint referenceTex, int renderWidth, int renderHeight, float blendFactor) {
+    m_BenchmarkRequested = false;
+    // 光追输出由imageStore写入，读回前需要同步
+    glMemoryBarrier(GL_TEXTURE_UPDATE_BARRIER_BIT);
+    // 参考纹理是渲染分辨率，TAAU时与screenWidth/screenHeight（输出分辨率）不同
+    std::vector<float> pixels(static_cast<size_t>(renderWidth) * renderHeight * 4);
+    glBindTexture(GL_TEXTURE_2D, referenceTex);
+    glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_FLOAT, pixels.data());
+    m_PrecisionReport = HDRPrecision::Run(pixels, renderWidth, renderHeight, blendFactor);
+}
+
+void PostProcessor::Resolve(GLuint currentTex, GLuint depthTex, GLuint normalTex, GLuint motionTex,
+    GLuint prevDepthTex, GLuint prevNormalTex,
+    const glm::mat4& view, const glm::mat4& projection, const glm::mat4& prevViewProj,
+    bool taaEnabled, float blendFactor, GLuint brightTex, float brightThreshold) {
+    m_LastTAA = taaEnabled;
+    m_LastExtract = brightTex != 0;
+    m_Resolved = true;
+    if (!taaEnabled) m_HistoryValid = false;
+    // 既不做TAA也不需要亮度提取时，场景直接使用当前帧
+    if (!taaEnabled && !brightTex) return;
+
+    if (taaEnabled) m_CurrentHistory = 1 - m_CurrentHistory;
+
+    // TAAU在输出分辨率上重建，普通TAA与渲染分辨率一一对应
+    const bool taau = taaEnabled && upscale;
+    Shader& shader = taau ? m_TAAUShader : m_ResolveShader;
+    shader.use();
+    shader.setBool("uTAAEnabled", taaEnabled);
+    shader.setBool("uHistoryValid", m_HistoryValid);
+    shader.setBool("uPrevGeometryValid", m_PrevGeometryValid);
+    shader.setFloat("uBlendFactor", blendFactor);
+    shader.setVec2("uJitter", m_Jitter);
+    shader.setMat4("uInvProjection", glm::inverse(projection));
+    shader.setMat4("uInvView", glm::inverse(view));
+    shader.setMat4("uPrevViewProj", prevViewProj);
+    shader.setFloat("uDepthTolerance", 0.05f);
+    shader.setFloat("uNormalThreshold", 0.9f);
+    shader.setBool("uExtractBright", brightTex != 0);
+    shader.setFloat("uThreshold", brightThreshold);
+
+    shader.setInt("uCurrentFrame", 0);
+    shader.setInt("uHistory", 1);
+    shader.setInt("gNormal", 2);
+    shader.setInt("gDepth", 3);
+    shader.setInt("uMotion", 4);
+    shader.setInt("uPrevDepth", 5);
+    shader.setInt("uPrevNormal", 6);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, currentTex); // 当前帧
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, m_HistoryTex[1 - m_CurrentHistory]); // 上一帧
+    glActiveTexture(GL_TEXTURE2);
+    glBindTexture(GL_TEXTURE_2D, normalTex);
+    glActiveTexture(GL_TEXTURE3);
+    glBindTexture(GL_TEXTURE_2D, depthTex);
+    glActiveTexture(GL_TEXTURE4);
+    glBindTexture(GL_TEXTURE_2D, motionTex);
+    glActiveTexture(GL_TEXTURE5);
+    glBindTexture(GL_TEXTURE_2D, prevDepthTex);
+    glActiveTexture(GL_TEXTURE6);
+    glBindTexture(GL_TEXTURE_2D, prevNormalTex);
+    glActiveTexture(GL_TEXTURE0);
+
+    // 图像单元5/6在探针更新时也会被使用，这里每帧重新绑定
+    glBindImageTexture(5, m_HistoryTex[m_CurrentHistory], 0, GL_FALSE, 0, GL_WRITE_ONLY, HDRPrecision::GetGLFormat(GetHistoryFormat()));
+    if (brightTex) glBindImageTexture(6, brightTex, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_RGBA16F);
+
+    // 后续读取所需的屏障由渲染图插入
+    glDispatchCompute((screenWidth + TILE_SIZE - 1) / TILE_SIZE, (screenHeight + TILE_SIZE - 1) / TILE_SIZE, 1);
+
+    if (taaEnabled) m_HistoryValid = true;
+    m_PrevGeometryValid = true;
+}
+
+void PostProcessor::Composite(GLuint sceneTex, GLuint bloomTex, float bloomStrength, GLuint aoTex, float aoStrength) {
+    // Resolve被剔除说明本帧既没有TAA也没有亮度提取，历史随之失效
+    if (!m_Resolved) {
+        m_LastTAA = m_LastExtract = false;
+        m_HistoryValid = false;
+    }
+    m_Resolved = false;
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    m_CompositeShader.use();
+    m_CompositeShader.setInt("scene", 0);
+    m_CompositeShader.setInt("bloomBlur", 1);
+    m_CompositeShader.setFloat("bloomStrength", bloomStrength);
+    m_CompositeShader.setFloat("exposure", exposure);
+    m_CompositeShader.setInt("tonemapMode", static_cast<int>(tonemap));
+    m_CompositeShader.setBool("gammaCorrect", gammaCorrect);
+    m_CompositeShader.setInt("aoTexture", 2);
+    m_CompositeShader.setBool("useAO", aoTex != 0);
+    m_CompositeShader.setFloat("aoStrength", aoStrength);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, sceneTex); // 原始场景（TAA累积后）
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, bloomTex); // 模糊后的高光
+    glActiveTexture(GL_TEXTURE2);
+    glBindTexture(GL_TEXTURE_2D, aoTex);
+    glActiveTexture(GL_TEXTURE0);
+    RenderQuad();
+}
+
+PostProcessor::Traffic PostProcessor::EstimateTraffic() const {
+    // 格式：当前帧/历史见sceneFormat/historyFormat，深度 R32F = 4，法线 RG16_SNORM = 4，运动向量 RG16F = 4，
+    // 亮度提取 RGBA16F = 8，默认帧缓冲 RGBA8 = 4；邻域重复读取由缓存命中，不计入
+    const double current = HDRPrecision::BytesPerPixel(sceneFormat);
+    const double history = HDRPrecision::BytesPerPixel(historyFormat);
+    const double taaReads = current + history + 4 + 4 + 4 + 4 + 4;
+    const double bloomRead = m_LastExtract ? 8.0 : 2.0; // mip链第0级为半分辨率
+    const double composite = (m_LastTAA ? history : current) + bloomRead + 4;
+
+    Traffic traffic;
+    traffic.separateBytes = composite;
+    traffic.fusedBytes = composite;
+    if (m_LastTAA) {
+        // 独立TAA pass + 为遮挡检测拷贝深度和法线
+        traffic.separateBytes += taaReads + history + 2.0 * (4 + 4);
+        traffic.fusedBytes += taaReads + history;
+    }
+    if (m_LastExtract) {
+        // 独立提取pass需要再读一遍场景；融合后只多一次写
+        const double scene = m_LastTAA ? history : current;
+        traffic.separateBytes += scene + 8;
+        traffic.fusedBytes += m_LastTAA ? 8 : current + 8;
+    }
+    return traffic;
+}
+
+void PostProcessor::DrawUI() {
+    ImGui::SetNextWindowPos(ImVec2(10, 340), ImGuiCond_FirstUseEver);
+    ImGui::SetNextWindowCollapsed(true, ImGuiCond_FirstUseEver);
+    ImGui::Begin("Post Processing", &showSettings);
+
+    int tonemapIndex = static_cast<int>(tonemap);
+    const char* tonemaps[] = { "None", "Reinhard", "ACES" };
+    if (ImGui::Combo("Tonemap", &tonemapIndex, tonemaps, IM_ARRAYSIZE(tonemaps))) {
+        tonemap = static_cast<Tonemap>(tonemapIndex);
+    }
+    ImGui::SliderFloat("Exposure", &exposure, 0.1f, 8.0f);
+    ImGui::Checkbox("Gamma Correct", &gammaCorrect);
+
+    // 中间纹理精度
+    const char* formats[] = { "RGBA32F", "RGBA16F", "R11G11B10F" };
+    int sceneIndex = static_cast<int>(sceneFormat);
+    if (ImGui::Combo("Scene Format", &sceneIndex, formats, IM_ARRAYSIZE(formats))) {
+        sceneFormat = static_cast<HDRFormat>(sceneIndex);
+    }
+    int historyIndex = static_cast<int>(historyFormat);
+    if (ImGui::Combo("History Format", &historyIndex, formats, IM_ARRAYSIZE(formats))) {
+        historyFormat = static_cast<HDRFormat>(historyIndex);
+    }
+    if (ImGui::Checkbox("Temporal Upscaling (TAAU)", &upscale)) m_HistoryValid = false;
+    if (GetHistoryFormat() != m_AllocatedHistoryFormat) CreateTextures();
+
+    ImGui::Separator();
+    const Traffic traffic = EstimateTraffic();
+    const double pixelsMB = static_cast<double>(screenWidth) * screenHeight / (1024.0 * 1024.0);
+    ImGui::Text("Traffic (excl. blur), bytes/pixel:");
+    ImGui::Text("  Separate passes: %.0f (%.1f MB)", traffic.separateBytes, traffic.separateBytes * pixelsMB);
+    ImGui::Text("  Fused:           %.0f (%.1f MB)", traffic.fusedBytes, traffic.fusedBytes * pixelsMB);
+    if (traffic.separateBytes > 0.0) {
+        ImGui::Text("  Saved: %.0f%%", 100.0 * (1.0 - traffic.fusedBytes / traffic.separateBytes));
+    }
+
+    ImGui::Separator();
+    if (ImGui::Button("Run Precision Benchmark")) m_BenchmarkRequested = true;
+    if (m_PrecisionReport.valid) {
+        // 每帧完整访问次数：光追输出写1读1，历史写1、下一帧读1、合成读1
+        const int SCENE_ACCESSES = 2, HISTORY_ACCESSES = 3;
+        const HDRPrecision::FormatResult& baseline = m_PrecisionReport.results[static_cast<int>(HDRFormat::RGBA32F)];
+        ImGui::Text("%dx%d, history over %d frames", m_PrecisionReport.width, m_PrecisionReport.height, m_PrecisionReport.historyFrames);
+        ImGui::Text("%-11s %9s %9s %8s %8s %9s", "Format", "Scene MB", "Hist MB", "PSNR", "MaxErr", "HistPSNR");
+        for (int f = 0; f < static_cast<int>(HDRFormat::Count); ++f) {
+            const HDRPrecision::FormatResult& result = m_PrecisionReport.results[f];
+            ImGui::Text("%-11s %9.1f %9.1f %8.1f %7.2f%% %9.1f", HDRPrecision::GetName(static_cast<HDRFormat>(f)),
+                (baseline.passMB - result.passMB) * SCENE_ACCESSES, (baseline.passMB - result.passMB) * HISTORY_ACCESSES,
+                result.psnr, result.maxRelError * 100.0, result.historyPsnr);
+        }
+        ImGui::TextDisabled("MB = saved per frame vs RGBA32F, PSNR in dB after x/(1+x)");
+    }
+
+    ImGui::End();
+}
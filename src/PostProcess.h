@@ -0,0 +1,92 @@
+// PostProcess.h
+#pragma once
+#include <glm/glm.hpp>
+#include "Shader.h"
+#include "HDRPrecision.h"
+
+// 融合后处理：
+//   Resolve   —— compute，一次读取当前帧/历史完成TAA解析，同时输出Bloom亮度提取（post_resolveCs.glsl）
+//                开启TAAU时在输出分辨率上重建低分辨率的抖动采样（post_taauCs.glsl）
+//   Composite —— 全屏pass，AO + Bloom合成 + 曝光 + 色调映射，直接写默认帧缓冲（post_compositeFs.glsl）
+// 模糊依赖邻域，仍由BloomManager单独执行
+class PostProcessor {
+public:
+    enum class Tonemap {
+        None,
+        Reinhard,
+        ACES
+    };
+
+    static constexpr int TILE_SIZE = 16;    // 需与post_resolveCs.glsl一致
+
+    // 每帧显存流量估算（字节/像素，全分辨率）
+    struct Traffic {
+        double separateBytes = 0.0;   // 独立pass：TAA + G-Buffer拷贝 + 亮度提取 + 合成
+        double fusedBytes = 0.0;      // 融合后：Resolve + Composite
+    };
+
+    PostProcessor(int width, int height);
+    ~PostProcessor();
+
+    void Init();
+    void Resize(int width, int height);
+
+    // G-Buffer为线性深度 + 八面体法线，prev*为上一帧的G-Buffer；brightTex非0时同时写出亮度提取结果（RGBA16F）
+    // 历史和亮度提取为screenWidth x screenHeight：普通TAA时等于渲染分辨率，TAAU时为输出分辨率
+    void Resolve(GLuint currentTex, GLuint depthTex, GLuint normalTex, GLuint motionTex,
+        GLuint prevDepthTex, GLuint prevNormalTex,
+        const glm::mat4& view, const glm::mat4& projection, const glm::mat4& prevViewProj,
+        bool taaEnabled, float blendFactor, GLuint brightTex, float brightThreshold);
+    // sceneTex为TAA解析后的HDR场景（TAA关闭时为当前帧）；aoTex为0时不应用AO
+    void Composite(GLuint sceneTex, GLuint bloomTex, float bloomStrength, GLuint aoTex, float aoStrength);
+    void DrawUI();
+
+    // 设置TAAU和历史格式（帧回放时使用）：TAAU切换时历史失效，存储格式变化时立即重建历史纹理
+    void SetHistorySettings(bool upscale, HDRFormat historyFormat);
+    // 渲染分辨率变化、G-Buffer重建后调用：TAAU的历史在输出分辨率上仍然可用，
+    // 但上一帧的深度/法线内容未定义，下一次解析跳过遮挡检测（只靠邻域裁剪）
+    void InvalidatePrevGeometry() { m_PrevGeometryValid = false; }
+    // TAA开启时Resolve将写入的历史纹理（渲染图在执行前声明依赖）
+    GLuint GetResolveTarget() const { return m_HistoryTex[1 - m_CurrentHistory]; }
+    Traffic EstimateTraffic() const;
+
+    // 光追输出（渲染图瞬态纹理）的格式；精度测试的那一帧强制RGBA32F作为参考
+    GLenum GetSceneGLFormat() const;
+    bool IsBenchmarkRequested() const { return m_BenchmarkRequested; }
+    // TAAU：推进本帧的Halton抖动，返回采样相对渲染像素中心的偏移（渲染像素单位）
+    glm::vec2 NextJitter(int renderWidth, int renderHeight);
+    // 抖动相位（帧捕获记录/回放）
+    int GetJitterIndex() const { return m_JitterIndex; }
+    void SetJitterIndex(int index) { m_JitterIndex = index; }
+    // 读回RGBA32F的光追输出（渲染分辨率），评估各格式的量化误差和流量（会阻塞等待GPU）
+    void RunPrecisionBenchmark(GLuint referenceTex, int renderWidth, int renderHeight, float blendFactor);
+
+    // 参数
+    int screenWidth, screenHeight;
+    Tonemap tonemap = Tonemap::ACES;
+    float exposure = 1.0f;
+    bool gammaCorrect = false;    // 默认帧缓冲非sRGB，保持与原输出一致时关闭
+    HDRFormat sceneFormat = HDRFormat::RGBA16F;     // 光追输出
+    HDRFormat historyFormat = HDRFormat::RGBA16F;   // TAA历史（多帧累积）
+    bool upscale = false;           // TAAU（需开启TAA），渲染分辨率由ResolutionController限制在67%以下
+    bool showSettings = true;
+
+private:
+    void CreateTextures();
+    // TAAU在历史alpha中保存累积权重，R11G11B10F没有alpha时改用RGBA16F
+    HDRFormat GetHistoryFormat() const;
+
+    GLuint m_HistoryTex[2] = {};  // 双缓冲
+    HDRFormat m_AllocatedHistoryFormat = HDRFormat::Count;
+    int m_CurrentHistory = 0;
+    bool m_HistoryValid = false;
+    bool m_PrevGeometryValid = true;  // 上一帧G-Buffer可用于遮挡检测
+    bool m_Resolved = false;      // 本帧Resolve是否执行（可能被渲染图剔除）
+    bool m_LastTAA = false, m_LastExtract = false;
+    Shader m_ResolveShader, m_TAAUShader, m_CompositeShader;
+    glm::vec2 m_Jitter = glm::vec2(0.0f);
+    int m_JitterIndex = 0;
+
+    bool m_BenchmarkRequested = false;
+    HDRPrecision::Report m_PrecisionReport;
+};
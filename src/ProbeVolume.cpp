@@ -0,0 +1,176 @@
+// ProbeVolume.cpp
+#include "ProbeVolume.h"
+#include <imgui.h>
+#include "GPUMemoryTracker.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <vector>
+
+ProbeVolume::~ProbeVolume() {
+    gpuMemory.DeleteTextures(1, &m_IrradianceTex);
+    gpuMemory.DeleteTextures(1, &m_DistanceTex);
+    gpuMemory.DeleteTextures(1, &m_RayDataTex);
+}
+
+void ProbeVolume::Init() {
+    m_UpdateShader.Init("shader/probeUpdateCs.glsl");
+    CreateTextures();
+}
+
+int ProbeVolume::GetProbesPerFrame() const {
+    return std::max(1, std::min(GetProbeCount(), rayBudget / raysPerProbe));
+}
+
+glm::vec3 ProbeVolume::GetSpacing() const {
+    return (gridMax - gridMin) / glm::vec3(glm::max(probeCounts - 1, glm::ivec3(1)));
+}
+
+void ProbeVolume::CreateTextures() {
+    gpuMemory.DeleteTextures(1, &m_IrradianceTex);
+    gpuMemory.DeleteTextures(1, &m_DistanceTex);
+    gpuMemory.DeleteTextures(1, &m_RayDataTex);
+
+    // 图集布局：每行放 x*y 个探针，共 z 行，每个探针四周带1像素边界
+    const int columns = probeCounts.x * probeCounts.y;
+    const int rows = probeCounts.z;
+
+    // 清零：alpha = 0 表示探针尚未更新
+    const int irrWidth = columns * (IRRADIANCE_TEXELS + 2), irrHeight = rows * (IRRADIANCE_TEXELS + 2);
+    std::vector<float> zeros(static_cast<size_t>(irrWidth) * irrHeight * 4, 0.0f);
+    glGenTextures(1, &m_IrradianceTex);
+    glBindTexture(GL_TEXTURE_2D, m_IrradianceTex);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, irrWidth, irrHeight, 0, GL_RGBA, GL_FLOAT, zeros.data());
+    gpuMemory.TrackTexture(m_IrradianceTex, "ProbeVolume", "Irradiance atlas", GL_RGBA16F, irrWidth, irrHeight);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    const int distWidth = columns * (DISTANCE_TEXELS + 2), distHeight = rows * (DISTANCE_TEXELS + 2);
+    zeros.assign(static_cast<size_t>(distWidth) * distHeight * 2, 0.0f);
+    glGenTextures(1, &m_DistanceTex);
+    glBindTexture(GL_TEXTURE_2D, m_DistanceTex);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RG16F, distWidth, distHeight, 0, GL_RG, GL_FLOAT, zeros.data());
+    gpuMemory.TrackTexture(m_DistanceTex, "ProbeVolume", "Distance atlas", GL_RG16F, distWidth, distHeight);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    // 探针光线结果：每行一个探针，rgb = 辐射度，a = 命中距离（背面为负）
+    glGenTextures(1, &m_RayDataTex);
+    glBindTexture(GL_TEXTURE_2D, m_RayDataTex);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, MAX_RAYS_PER_PROBE, GetProbeCount(), 0, GL_RGBA, GL_FLOAT, nullptr);
+    gpuMemory.TrackTexture(m_RayDataTex, "ProbeVolume", "Ray data", GL_RGBA16F, MAX_RAYS_PER_PROBE, GetProbeCount());
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glBindImageTexture(4, m_RayDataTex, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_RGBA16F);
+
+    m_NextProbe = 0;
+}
+
+void ProbeVolume::SetVolumeUniforms(Shader& shader) const {
+    const glm::vec3 spacing = GetSpacing();
+    shader.setVec3("probeGridMin", gridMin);
+    shader.setVec3("probeSpacing", spacing);
+    shader.setIVec3("probeCounts", probeCounts);
+    shader.setFloat("probeNormalBias", normalBias);
+    shader.setFloat("probeMaxDistance", glm::length(spacing) * 1.5f);
+    shader.setFloat("probeRoughnessThreshold", roughnessThreshold);
+
+    shader.setInt("irradianceAtlas", 7);
+    shader.setInt("distanceAtlas", 8);
+    glActiveTexture(GL_TEXTURE7);
+    glBindTexture(GL_TEXTURE_2D, m_IrradianceTex);
+    glActiveTexture(GL_TEXTURE8);
+    glBindTexture(GL_TEXTURE_2D, m_DistanceTex);
+    glActiveTexture(GL_TEXTURE0);
+}
+
+void ProbeVolume::Update(Shader& raytracingShader) {
+    if (!enabled) return;
+    if (m_NeedsReset) {
+        CreateTextures();
+        m_NeedsReset = false;
+    }
+
+    const int probeCount = GetProbeCount();
+    const int probesThisFrame = GetProbesPerFrame();
+
+    // 每帧随机旋转球面Fibonacci方向，避免固定方向的走样
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+    glm::vec3 axis(dist(m_Rng) * 2.0f - 1.0f, dist(m_Rng) * 2.0f - 1.0f, dist(m_Rng) * 2.0f - 1.0f);
+    if (glm::length(axis) < 1e-3f) axis = glm::vec3(0.0f, 1.0f, 0.0f);
+    m_RayRotation = glm::rotate(glm::mat4(1.0f), dist(m_Rng) * 6.2831853f, glm::normalize(axis));
+
+    // 步骤1: 追踪探针光线（复用光追着色器的求交和直接光照）
+    raytracingShader.use();
+    SetVolumeUniforms(raytracingShader);
+    raytracingShader.setBool("probeUpdatePass", true);
+    raytracingShader.setInt("probeFirst", m_NextProbe);
+    raytracingShader.setInt("probeUpdateCount", probesThisFrame);
+    raytracingShader.setInt("probeRaysPerProbe", raysPerProbe);
+    raytracingShader.setMat4("probeRayRotation", m_RayRotation);
+    glDispatchCompute((raysPerProbe + 31) / 32, (probesThisFrame + 31) / 32, 1);
+    glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+
+    // 步骤2: 混合到八面体图集并更新边界，每个工作组处理一个探针
+    m_UpdateShader.use();
+    m_UpdateShader.setIVec3("probeCounts", probeCounts);
+    m_UpdateShader.setInt("probeFirst", m_NextProbe);
+    m_UpdateShader.setInt("probeRaysPerProbe", raysPerProbe);
+    m_UpdateShader.setMat4("probeRayRotation", m_RayRotation);
+    m_UpdateShader.setFloat("hysteresis", hysteresis);
+    m_UpdateShader.setFloat("probeMaxDistance", glm::length(GetSpacing()) * 1.5f);
+    m_UpdateShader.setInt("probeRayData", 9); // 避开光追着色器使用的纹理单元
+    glActiveTexture(GL_TEXTURE9);
+    glBindTexture(GL_TEXTURE_2D, m_RayDataTex);
+    glActiveTexture(GL_TEXTURE0);
+    glBindImageTexture(5, m_IrradianceTex, 0, GL_FALSE, 0, GL_READ_WRITE, GL_RGBA16F);
+    glBindImageTexture(6, m_DistanceTex, 0, GL_FALSE, 0, GL_READ_WRITE, GL_RG16F);
+    glDispatchCompute(probesThisFrame, 1, 1); // 图集读取所需的屏障由渲染图插入
+
+    m_NextProbe = (m_NextProbe + probesThisFrame) % probeCount;
+
+    raytracingShader.use();
+    raytracingShader.setBool("probeUpdatePass", false);
+}
+
+void ProbeVolume::Bind(Shader& raytracingShader) const {
+    raytracingShader.setBool("useProbes", enabled);
+    raytracingShader.setBool("probeUpdatePass", false);
+    SetVolumeUniforms(raytracingShader);
+}
+
+void ProbeVolume::DrawUI() {
+    ImGui::SetNextWindowPos(ImVec2(10, 280), ImGuiCond_FirstUseEver);
+    ImGui::SetNextWindowCollapsed(true, ImGuiCond_FirstUseEver);
+    ImGui::Begin("Probe Volume (DDGI)", &showSettings);
+
+    ImGui::Checkbox("Enable Probes", &enabled);
+
+    // 网格变化需要重建图集
+    if (ImGui::SliderInt3("Probe Counts", &probeCounts.x, 2, 16)) m_NeedsReset = true;
+    if (ImGui::DragFloat3("Grid Min", &gridMin.x, 0.1f)) m_NeedsReset = true;
+    if (ImGui::DragFloat3("Grid Max", &gridMax.x, 0.1f)) m_NeedsReset = true;
+    gridMax = glm::max(gridMax, gridMin + glm::vec3(0.1f));
+
+    ImGui::SliderInt("Rays Per Probe", &raysPerProbe, 32, MAX_RAYS_PER_PROBE);
+    ImGui::SliderInt("Ray Budget", &rayBudget, 1024, 65536);
+    ImGui::SliderFloat("Hysteresis", &hysteresis, 0.8f, 0.995f);
+    ImGui::SliderFloat("Normal Bias", &normalBias, 0.0f, 1.0f);
+    ImGui::SliderFloat("Roughness Threshold", &roughnessThreshold, 0.0f, 1.0f);
+
+    const int probesPerFrame = GetProbesPerFrame();
+    ImGui::Text("Probes: %d, updated per frame: %d", GetProbeCount(), probesPerFrame);
+    ImGui::Text("Full refresh every %d frames", (GetProbeCount() + probesPerFrame - 1) / probesPerFrame);
+    if (ImGui::Button("Reset Probes")) m_NeedsReset = true;
+
+    ImGui::End();
+
+    // 在渲染图导入图集之前重建，保证本帧声明的纹理就是实际使用的纹理
+    if (m_NeedsReset) {
+        CreateTextures();
+        m_NeedsReset = false;
+    }
+}
@@ -0,0 +1,53 @@
+// ProbeVolume.h
+#pragma once
+#include <glm/glm.hpp>
+#include "Shader.h"
+#include <random>
+
+// DDGI风格的辐照度探针体：探针光线复用光追着色器（probeUpdatePass），
+// 每帧按固定光线预算轮流更新一部分探针，辐照度和距离矩存放在八面体映射图集中
+// 主光追中粗糙的漫反射路径直接查询探针终止，不再追踪下一次弹射
+class ProbeVolume {
+public:
+    static constexpr int IRRADIANCE_TEXELS = 8;     // 每个探针的辐照度分辨率（不含1像素边界）
+    static constexpr int DISTANCE_TEXELS = 16;      // 距离矩分辨率（不含边界）
+    static constexpr int MAX_RAYS_PER_PROBE = 256;  // 需与probeUpdateCs.glsl一致
+
+    // 参数
+    bool enabled = false;
+    glm::ivec3 probeCounts = glm::ivec3(8, 4, 8);
+    glm::vec3 gridMin = glm::vec3(-8.0f, -1.0f, -8.0f);
+    glm::vec3 gridMax = glm::vec3(8.0f, 7.0f, 8.0f);
+    int raysPerProbe = 128;
+    int rayBudget = 16384;              // 每帧探针光线总数
+    float hysteresis = 0.97f;           // 历史权重
+    float normalBias = 0.1f;
+    float roughnessThreshold = 0.5f;    // 粗糙度不低于该值的漫反射表面由探针终止
+    bool showSettings = true;
+
+    ProbeVolume() = default;
+    ~ProbeVolume();
+    void Init();
+    // 在光追着色器设置好场景uniform之后、主光追dispatch之前调用
+    void Update(Shader& raytracingShader);
+    // 为主光追pass设置探针采样参数
+    void Bind(Shader& raytracingShader) const;
+    void DrawUI();
+
+    int GetProbeCount() const { return probeCounts.x * probeCounts.y * probeCounts.z; }
+    int GetProbesPerFrame() const;
+    glm::vec3 GetSpacing() const;
+    GLuint GetIrradianceTexture() const { return m_IrradianceTex; }
+    GLuint GetDistanceTexture() const { return m_DistanceTex; }
+
+private:
+    void CreateTextures();
+    void SetVolumeUniforms(Shader& shader) const;
+
+    GLuint m_IrradianceTex = 0, m_DistanceTex = 0, m_RayDataTex = 0;
+    Shader m_UpdateShader;
+    int m_NextProbe = 0;
+    bool m_NeedsReset = false;
+    glm::mat4 m_RayRotation = glm::mat4(1.0f);
+    std::mt19937 m_Rng;
+};
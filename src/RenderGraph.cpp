@@ -0,0 +1,236 @@
+// RenderGraph.cpp
+#include "RenderGraph.h"
+#include <imgui.h>
+#include "GPUMemoryTracker.h"
+#include <algorithm>
+
+RenderGraph::~RenderGraph() {
+    for (PooledTexture& pooled : m_Pool) gpuMemory.DeleteTextures(1, &pooled.texture);
+}
+
+void RenderGraph::PassBuilder::Read(ResourceHandle handle, Access access) {
+    m_Graph.m_Passes[m_Pass].reads.push_back({ handle, access });
+}
+
+void RenderGraph::PassBuilder::Write(ResourceHandle handle, Access access) {
+    m_Graph.m_Passes[m_Pass].writes.push_back({ handle, access });
+}
+
+void RenderGraph::PassBuilder::SideEffect() {
+    m_Graph.m_Passes[m_Pass].sideEffect = true;
+}
+
+RenderGraph::ResourceHandle RenderGraph::Import(const char* name, GLuint texture) {
+    Resource resource;
+    resource.name = name;
+    resource.imported = true;
+    resource.texture = texture;
+    m_Resources.push_back(resource);
+    return static_cast<ResourceHandle>(m_Resources.size() - 1);
+}
+
+RenderGraph::ResourceHandle RenderGraph::Create(const char* name, const TextureDesc& desc) {
+    Resource resource;
+    resource.name = name;
+    resource.desc = desc;
+    m_Resources.push_back(resource);
+    return static_cast<ResourceHandle>(m_Resources.size() - 1);
+}
+
+void RenderGraph::AddPass(const char* name, const std::function<void(PassBuilder&)>& setup,
+    const std::function<void(RenderGraph&)>& execute) {
+    Pass pass;
+    pass.name = name;
+    pass.execute = execute;
+    m_Passes.push_back(pass);
+
+    PassBuilder builder(*this, static_cast<int>(m_Passes.size() - 1));
+    setup(builder);
+}
+
+void RenderGraph::Compile() {
+    CullPasses();
+    AllocateTransients();
+    ComputeBarriers();
+}
+
+void RenderGraph::CullPasses() {
+    // 反向遍历：有副作用或输出被后续存活pass读取的pass才存活
+    std::vector<bool> needed(m_Resources.size(), false);
+    for (int i = static_cast<int>(m_Passes.size()) - 1; i >= 0; --i) {
+        Pass& pass = m_Passes[i];
+        bool alive = pass.sideEffect;
+        for (const Usage& write : pass.writes) alive = alive || needed[write.handle];
+        pass.culled = !alive;
+        if (!alive) continue;
+        for (const Usage& read : pass.reads) needed[read.handle] = true;
+    }
+}
+
+int RenderGraph::AcquireTexture(const TextureDesc& desc) {
+    for (size_t i = 0; i < m_Pool.size(); ++i) {
+        if (!m_Pool[i].inUse && m_Pool[i].desc == desc) {
+            m_Pool[i].inUse = true;
+            return static_cast<int>(i);
+        }
+    }
+
+    PooledTexture pooled;
+    pooled.desc = desc;
+    pooled.inUse = true;
+    glGenTextures(1, &pooled.texture);
+    glBindTexture(GL_TEXTURE_2D, pooled.texture);
+    glTexStorage2D(GL_TEXTURE_2D, 1, desc.format, desc.width, desc.height);
+    gpuMemory.TrackTexture(pooled.texture, "RenderGraph", "Transient " + std::to_string(pooled.texture), desc.format, desc.width, desc.height);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, desc.filter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, desc.filter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    m_Pool.push_back(pooled);
+    return static_cast<int>(m_Pool.size() - 1);
+}
+
+void RenderGraph::AllocateTransients() {
+    // 生命周期：第一次到最后一次被存活pass使用
+    for (int i = 0; i < static_cast<int>(m_Passes.size()); ++i) {
+        if (m_Passes[i].culled) continue;
+        auto touch = [&](const Usage& usage) {
+            Resource& resource = m_Resources[usage.handle];
+            if (resource.firstPass < 0) resource.firstPass = i;
+            resource.lastPass = i;
+        };
+        for (const Usage& read : m_Passes[i].reads) touch(read);
+        for (const Usage& write : m_Passes[i].writes) touch(write);
+    }
+
+    // 按pass顺序分配，生命周期结束后立即归还，后面的资源可以复用同一张纹理
+    m_TransientCount = 0;
+    for (int i = 0; i < static_cast<int>(m_Passes.size()); ++i) {
+        for (Resource& resource : m_Resources) {
+            if (resource.imported || resource.firstPass != i) continue;
+            resource.physical = AcquireTexture(resource.desc);
+            resource.texture = m_Pool[resource.physical].texture;
+            m_Pool[resource.physical].lastUsedFrame = m_FrameIndex;
+            m_TransientCount++;
+        }
+        for (Resource& resource : m_Resources) {
+            if (!resource.imported && resource.lastPass == i) m_Pool[resource.physical].inUse = false;
+        }
+    }
+}
+
+GLbitfield RenderGraph::BarrierFor(Access access) {
+    switch (access) {
+    case Access::Sampled:    return GL_TEXTURE_FETCH_BARRIER_BIT;
+    case Access::Attachment: return GL_FRAMEBUFFER_BARRIER_BIT;
+    default:                 return GL_SHADER_IMAGE_ACCESS_BARRIER_BIT;
+    }
+}
+
+void RenderGraph::ComputeBarriers() {
+    // 只有imageStore的写入需要glMemoryBarrier；绘制到附件后再采样由驱动保证顺序
+    // 屏障是全局的，发出后对所有未同步的写入都生效
+    m_BarrierCount = 0;
+
+    for (Pass& pass : m_Passes) {
+        pass.barrierBits = 0;
+        if (pass.culled) continue;
+        if (m_FlushPending) {
+            pass.barrierBits = GL_ALL_BARRIER_BITS;
+            m_FlushPending = false;
+        }
+
+        auto require = [&](const Usage& usage) {
+            GLuint texture = m_Resources[usage.handle].texture;
+            auto it = m_PendingImageWrites.find(texture);
+            if (it == m_PendingImageWrites.end()) return;
+            GLbitfield bit = BarrierFor(usage.access);
+            if (!(it->second & bit)) pass.barrierBits |= bit;
+        };
+        for (const Usage& read : pass.reads) require(read);
+        for (const Usage& write : pass.writes) require(write);
+
+        if (pass.barrierBits) {
+            for (auto& pending : m_PendingImageWrites) pending.second |= pass.barrierBits;
+            m_BarrierCount++;
+        }
+        for (const Usage& write : pass.writes) {
+            if (write.access == Access::ImageWrite) m_PendingImageWrites[m_Resources[write.handle].texture] = 0;
+        }
+    }
+}
+
+void RenderGraph::Execute(PerformanceProfiler& profiler) {
+    for (Pass& pass : m_Passes) {
+        if (pass.culled) continue;
+        if (pass.barrierBits) glMemoryBarrier(pass.barrierBits);
+        PerformanceProfiler::Scope scope(profiler, pass.name.c_str());
+        pass.execute(*this);
+    }
+}
+
+void RenderGraph::Reset() {
+    m_Passes.clear();
+    m_Resources.clear();
+    m_FrameIndex++;
+
+    // 释放长期闲置的物理纹理
+    for (size_t i = 0; i < m_Pool.size();) {
+        if (m_FrameIndex - m_Pool[i].lastUsedFrame > POOL_KEEP_FRAMES) {
+            m_PendingImageWrites.erase(m_Pool[i].texture);
+            gpuMemory.DeleteTextures(1, &m_Pool[i].texture);
+            m_Pool.erase(m_Pool.begin() + i);
+        }
+        else {
+            m_Pool[i].inUse = false;
+            ++i;
+        }
+    }
+}
+
+void RenderGraph::InvalidateImports() {
+    // 池中的瞬态纹理由图自己管理，状态仍然有效
+    // 导入纹理的名字可能被重新分配：丢弃其状态，尚未对所有用途同步的写入由完整屏障补上
+    const GLbitfield allConsumers = GL_TEXTURE_FETCH_BARRIER_BIT | GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_FRAMEBUFFER_BARRIER_BIT;
+    for (auto it = m_PendingImageWrites.begin(); it != m_PendingImageWrites.end();) {
+        const bool pooled = std::any_of(m_Pool.begin(), m_Pool.end(), [&](const PooledTexture& p) { return p.texture == it->first; });
+        if (pooled) {
+            ++it;
+            continue;
+        }
+        if ((it->second & allConsumers) != allConsumers) m_FlushPending = true;
+        it = m_PendingImageWrites.erase(it);
+    }
+}
+
+void RenderGraph::DrawUI() {
+    ImGui::SetNextWindowPos(ImVec2(10, 370), ImGuiCond_FirstUseEver);
+    ImGui::SetNextWindowCollapsed(true, ImGuiCond_FirstUseEver);
+    ImGui::Begin("Render Graph", &showSettings);
+
+    for (const Pass& pass : m_Passes) {
+        if (pass.culled) {
+            ImGui::TextDisabled("%-12s (culled)", pass.name.c_str());
+            continue;
+        }
+        ImGui::Text("%-12s", pass.name.c_str());
+        if (pass.barrierBits) {
+            ImGui::SameLine();
+            ImGui::Text("barrier:%s%s%s",
+                pass.barrierBits & GL_TEXTURE_FETCH_BARRIER_BIT ? " fetch" : "",
+                pass.barrierBits & GL_SHADER_IMAGE_ACCESS_BARRIER_BIT ? " image" : "",
+                pass.barrierBits & GL_FRAMEBUFFER_BARRIER_BIT ? " fbo" : "");
+        }
+    }
+
+    ImGui::Separator();
+    // 与显存面板中RenderGraph一栏使用相同的每像素字节数
+    double poolMB = 0.0;
+    for (const PooledTexture& pooled : m_Pool) {
+        poolMB += static_cast<double>(pooled.desc.width) * pooled.desc.height * GPUMemoryTracker::BytesPerPixel(pooled.desc.format) / (1024.0 * 1024.0);
+    }
+    ImGui::Text("Transient textures: %d -> %d physical (%.1f MB)", m_TransientCount, static_cast<int>(m_Pool.size()), poolMB);
+    ImGui::Text("Barriers this frame: %d", m_BarrierCount);
+
+    ImGui::End();
+}
@@ -0,0 +1,121 @@
+// RenderGraph.h
+#pragma once
+#include <GL/glew.h>
+#include <functional>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "PerformanceProfiler.h"
+
+// 轻量渲染图：每帧重新声明pass及其读写的纹理，Compile时
+//   1. 从有外部副作用的pass反向追溯，剔除输出无人读取的pass
+//   2. 按生命周期为瞬态纹理分配物理纹理，生命周期不重叠且描述相同的纹理共用一张
+//   3. 只在image store之后按后续的访问方式插入所需的屏障位
+// pass内部多次dispatch之间的依赖仍由pass自己负责
+class RenderGraph {
+public:
+    using ResourceHandle = int;
+
+    enum class Access {
+        Sampled,     // 纹理采样（texture/texelFetch）
+        ImageRead,   // imageLoad
+        ImageWrite,  // imageStore
+        Attachment   // 帧缓冲附件（绘制写入）
+    };
+
+    struct TextureDesc {
+        int width = 0, height = 0;
+        GLenum format = GL_RGBA16F;
+        GLenum filter = GL_NEAREST;
+        bool operator==(const TextureDesc& o) const {
+            return width == o.width && height == o.height && format == o.format && filter == o.filter;
+        }
+    };
+
+    class PassBuilder {
+    public:
+        void Read(ResourceHandle handle, Access access = Access::Sampled);
+        void Write(ResourceHandle handle, Access access = Access::ImageWrite);
+        // 输出对图外可见（默认帧缓冲、跨帧历史），不参与剔除
+        void SideEffect();
+    private:
+        friend class RenderGraph;
+        PassBuilder(RenderGraph& graph, int pass) : m_Graph(graph), m_Pass(pass) {}
+        RenderGraph& m_Graph;
+        int m_Pass;
+    };
+
+    static constexpr int POOL_KEEP_FRAMES = 60;     // 物理纹理闲置超过该帧数后释放
+
+    ~RenderGraph();
+
+    // 外部持有的纹理（持久历史、G-Buffer等），每帧重新导入
+    ResourceHandle Import(const char* name, GLuint texture);
+    // 瞬态纹理，由图在Compile时分配
+    ResourceHandle Create(const char* name, const TextureDesc& desc);
+    // 每个存活的pass以自己的名称作为profiler作用域计时
+    void AddPass(const char* name, const std::function<void(PassBuilder&)>& setup,
+        const std::function<void(RenderGraph&)>& execute);
+
+    GLuint GetTexture(ResourceHandle handle) const { return m_Resources[handle].texture; }
+
+    void Compile();
+    void Execute(PerformanceProfiler& profiler);
+    // 清除本帧声明的pass和资源，保留物理纹理池
+    void Reset();
+    // 导入的外部纹理被删除重建（调整渲染目标大小等）时调用：丢弃它们的屏障跟踪状态，
+    // 避免GL复用纹理名称后把旧状态算到新纹理上；有未完全同步的写入时下一帧第一个pass发出完整屏障
+    void InvalidateImports();
+    void DrawUI();
+
+    bool showSettings = true;
+
+private:
+    struct Resource {
+        std::string name;
+        TextureDesc desc;
+        bool imported = false;
+        GLuint texture = 0;
+        int physical = -1;          // 纹理池索引（仅瞬态）
+        int firstPass = -1, lastPass = -1;
+    };
+
+    struct Usage {
+        ResourceHandle handle;
+        Access access;
+    };
+
+    struct Pass {
+        std::string name;
+        std::vector<Usage> reads, writes;
+        std::function<void(RenderGraph&)> execute;
+        bool sideEffect = false;
+        bool culled = false;
+        GLbitfield barrierBits = 0;
+    };
+
+    struct PooledTexture {
+        TextureDesc desc;
+        GLuint texture = 0;
+        bool inUse = false;
+        int lastUsedFrame = 0;
+    };
+
+    void CullPasses();
+    void AllocateTransients();
+    void ComputeBarriers();
+    int AcquireTexture(const TextureDesc& desc);
+    static GLbitfield BarrierFor(Access access);
+
+    std::vector<Resource> m_Resources;
+    std::vector<Pass> m_Passes;
+    std::vector<PooledTexture> m_Pool;
+    // 跨帧跟踪：上一次以imageStore写入、尚未被屏障同步的纹理
+    std::unordered_map<GLuint, GLbitfield> m_PendingImageWrites;  // 值为写入后已发出的屏障位
+    bool m_FlushPending = false;    // 丢弃过未完全同步的跟踪状态，第一个存活pass需要完整屏障
+    int m_FrameIndex = 0;
+
+    // 统计（用于UI）
+    int m_TransientCount = 0;
+    int m_BarrierCount = 0;
+};
@@ -0,0 +1,71 @@
+// ResolutionController.cpp
+#include "ResolutionController.h"
+#include <imgui.h>
+#include <algorithm>
+#include <cmath>
+
+void ResolutionController::Update(double rayTracingMs) {
+    if (rayTracingMs <= 0.0) return;
+    m_SmoothedMs = m_SmoothedMs == 0.0 ? rayTracingMs : m_SmoothedMs * 0.9 + rayTracingMs * 0.1;
+
+    if (!autoAdjust) return;
+    if (m_Cooldown > 0) {
+        --m_Cooldown;
+        return;
+    }
+
+    // 光追耗时近似与像素数成正比：目标缩放 = 当前缩放 * sqrt(目标 / 实测)
+    const float ideal = scale * static_cast<float>(std::sqrt(targetMs / m_SmoothedMs));
+    float next = scale;
+    if (m_SmoothedMs > targetMs) {
+        // 超出预算：直接降到估计值（向下取整到步长）
+        next = std::floor(ideal / SCALE_STEP) * SCALE_STEP;
+    }
+    else if (m_SmoothedMs < targetMs * 0.8f) {
+        // 预算充足：每次只升一级，避免估计偏差引起振荡
+        next = std::min(scale + SCALE_STEP, std::floor(ideal / SCALE_STEP) * SCALE_STEP);
+    }
+    next = std::clamp(next, MIN_SCALE, maxScale);
+    if (std::fabs(next - scale) < SCALE_STEP * 0.5f) return;
+
+    // 按像素数比例预估新分辨率下的耗时，不必等平滑值慢慢收敛
+    m_SmoothedMs *= (next * next) / (scale * scale);
+    scale = next;
+    m_Cooldown = COOLDOWN_FRAMES;
+}
+
+void ResolutionController::SetUpscaling(bool enabled) {
+    maxScale = enabled ? TAAU_MAX_SCALE : MAX_SCALE;
+    scale = std::min(scale, maxScale);
+}
+
+glm::ivec2 ResolutionController::GetRenderSize(int outputWidth, int outputHeight) const {
+    auto scaled = [this](int size) {
+        int result = static_cast<int>(std::lround(size * scale / 2.0f)) * 2;
+        return std::clamp(result, 1, size);
+    };
+    return glm::ivec2(scaled(outputWidth), scaled(outputHeight));
+}
+
+void ResolutionController::DrawUI(int outputWidth, int outputHeight) {
+    ImGui::SetNextWindowPos(ImVec2(10, 400), ImGuiCond_FirstUseEver);
+    ImGui::SetNextWindowCollapsed(true, ImGuiCond_FirstUseEver);
+    ImGui::Begin("Dynamic Resolution", &showSettings);
+
+    ImGui::Checkbox("Auto Adjust", &autoAdjust);
+    ImGui::SliderFloat("Budget (ms)", &targetMs, 1.0f, 50.0f);
+    ImGui::TextWrapped("Shared with Path Budget: resolution adjusts first, path length only changes at the min/max scale.");
+    ImGui::Text("RayTracing (smoothed): %.2f ms", m_SmoothedMs);
+
+    ImGui::BeginDisabled(autoAdjust);
+    if (ImGui::SliderFloat("Scale", &scale, MIN_SCALE, maxScale, "%.2f")) {
+        scale = std::min(std::round(scale / SCALE_STEP) * SCALE_STEP, maxScale);
+    }
+    ImGui::EndDisabled();
+
+    const glm::ivec2 size = GetRenderSize(outputWidth, outputHeight);
+    ImGui::Text("Render: %dx%d -> Output: %dx%d (%.0f%% pixels)", size.x, size.y, outputWidth, outputHeight,
+        100.0 * size.x * size.y / (static_cast<double>(outputWidth) * outputHeight));
+
+    ImGui::End();
+}
@@ -0,0 +1,36 @@
+// ResolutionController.h
+#pragma once
+#include <glm/glm.hpp>
+
+// 动态分辨率：根据光追阶段的GPU耗时调整渲染分辨率（光追 + G-Buffer + AO + TAA），
+// 最终合成时双线性放大到输出分辨率
+class ResolutionController {
+public:
+    static constexpr float MIN_SCALE = 0.5f;
+    static constexpr float MAX_SCALE = 1.0f;
+    static constexpr float TAAU_MAX_SCALE = 0.67f;  // TAAU时渲染分辨率上限
+    static constexpr float SCALE_STEP = 0.05f;  // 缩放量化步长，避免每帧重建渲染目标
+    static constexpr int COOLDOWN_FRAMES = 30;
+
+    // 参数
+    bool autoAdjust = true;
+    float targetMs = 12.0f;         // 光追阶段的目标耗时（与路径长度预算共用）
+    float scale = 1.0f;             // 渲染分辨率 / 输出分辨率（每个轴）
+    float maxScale = MAX_SCALE;
+    bool showSettings = true;
+
+    // 根据测得的光追耗时调整缩放
+    void Update(double rayTracingMs);
+    // 自动调整时还能否再降/升一级：到达边界后由路径长度控制器接手
+    bool CanScaleDown() const { return autoAdjust && scale - SCALE_STEP >= MIN_SCALE - 1e-4f; }
+    bool CanScaleUp() const { return autoAdjust && scale + SCALE_STEP <= maxScale + 1e-4f; }
+    // TAAU开启时限制在TAAU_MAX_SCALE以下
+    void SetUpscaling(bool enabled);
+    // 宽高取偶数，至少为1
+    glm::ivec2 GetRenderSize(int outputWidth, int outputHeight) const;
+    void DrawUI(int outputWidth, int outputHeight);
+
+private:
+    double m_SmoothedMs = 0.0;
+    int m_Cooldown = 0;
+};
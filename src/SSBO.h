@@ -3,22 +3,35 @@
 #include "Object.h"
 #include <GL/glew.h>
 #include <iostream>
+#include "GPUMemoryTracker.h"
 
 class SSBO {
 public:
-    GLuint id;
+    GLuint id = 0;
     std::vector<Object> objects;
 
     SSBO() = default;
+    ~SSBO() {
+        gpuMemory.DeleteBuffers(1, &id);
+    }
     void Init() {
         glGenBuffers(1, &id);
     }
     void update() {
+        // 每帧都会上传，只有物体数超过已分配容量时才重新分配存储
+        const size_t bytes = objects.size() * sizeof(Object);
         glBindBuffer(GL_SHADER_STORAGE_BUFFER, id);
-        glBufferData(GL_SHADER_STORAGE_BUFFER,
-            objects.size() * sizeof(Object),
-            objects.data(),
-            GL_DYNAMIC_DRAW);
+        if (bytes > capacity) {
+            glBufferData(GL_SHADER_STORAGE_BUFFER, bytes, objects.data(), GL_DYNAMIC_DRAW);
+            capacity = bytes;
+            gpuMemory.TrackBuffer(id, "Scene", "Objects", capacity);
+        }
+        else if (bytes > 0) {
+            glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, bytes, objects.data());
+        }
         glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, id);
     }
-};
\ No newline at end of file
+
+private:
+    size_t capacity = 0;
+};
@@ -0,0 +1,89 @@
+// Sampling.cpp
+#include "Sampling.h"
+#include <cmath>
+#include <iostream>
+#include <random>
+
+float haltonSequence(int index, int base) {
+    float result = 0.0f;
+    float f = 1.0f / base;
+    int i = index;
+    while (i > 0) {
+        result += f * (i % base);
+        i = (int)floor(i / base);
+        f /= base;
+    }
+    return result;
+}
+
+std::vector<glm::vec4> GenerateSSAOKernel(int kernelSize) {
+    std::uniform_real_distribution<float> randomFloats(0.0, 1.0);
+    std::default_random_engine generator;
+    std::vector<glm::vec4> kernel;
+    for (int i = 0; i < kernelSize; ++i) {
+        glm::vec3 sample(
+            randomFloats(generator) * 2.0 - 1.0,
+            randomFloats(generator) * 2.0 - 1.0,
+            randomFloats(generator)
+        );
+        sample = glm::normalize(sample);
+        sample *= randomFloats(generator);
+        // 按实际采样数分布，让靠近中心的样本更密集
+        float scale = (float)i / kernelSize;
+        scale = 0.1f + (scale * scale) * 0.9f;
+        sample *= scale;
+        kernel.push_back(glm::vec4(sample, 0.0f));
+    }
+    return kernel;
+}
+
+namespace {
+    // Joe-Kuo (new-joe-kuo-6.21201) 第2维开始的本原多项式参数
+    struct SobolPolynomial {
+        uint32_t s;         // 多项式次数
+        uint32_t a;         // 多项式系数
+        uint32_t m[5];      // 初始方向数
+    };
+
+    const SobolPolynomial kPolynomials[] = {
+        { 1, 0, { 1 } },
+        { 2, 1, { 1, 3 } },
+        { 3, 1, { 1, 3, 1 } },
+        { 3, 2, { 1, 1, 1 } },
+        { 4, 1, { 1, 1, 3, 3 } },
+        { 4, 4, { 1, 3, 5, 13 } },
+        { 5, 2, { 1, 1, 5, 5, 17 } },
+    };
+    constexpr int kMaxDimensions = 1 + sizeof(kPolynomials) / sizeof(kPolynomials[0]);
+}
+
+std::vector<uint32_t> GenerateSobolMatrices(int dimensions) {
+    if (dimensions > kMaxDimensions) {
+        std::cerr << "GenerateSobolMatrices: only " << kMaxDimensions << " dimensions available" << std::endl;
+        dimensions = kMaxDimensions;
+    }
+
+    std::vector<uint32_t> result(dimensions * SOBOL_BITS);
+
+    // 第1维：van der Corput序列（位反转）
+    for (int i = 0; i < SOBOL_BITS; ++i) {
+        result[i] = 1u << (31 - i);
+    }
+
+    for (int d = 1; d < dimensions; ++d) {
+        const SobolPolynomial& poly = kPolynomials[d - 1];
+        uint32_t* v = &result[d * SOBOL_BITS];
+
+        for (uint32_t i = 0; i < SOBOL_BITS; ++i) {
+            if (i < poly.s) {
+                v[i] = poly.m[i] << (31 - i);
+                continue;
+            }
+            v[i] = v[i - poly.s] ^ (v[i - poly.s] >> poly.s);
+            for (uint32_t k = 1; k < poly.s; ++k) {
+                v[i] ^= ((poly.a >> (poly.s - 1 - k)) & 1u) * v[i - k];
+            }
+        }
+    }
+    return result;
+}
@@ -0,0 +1,17 @@
+// Sampling.h
+#pragma once
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+// 不依赖GL的CPU端采样函数，渲染器和cpu_bench共用
+
+// TAA： Halton序列生成函数（低差异序列）
+float haltonSequence(int index, int base);
+
+// SSAO半球采样核：固定种子，同一采样数总是得到相同的核，靠近中心的样本更密集
+std::vector<glm::vec4> GenerateSSAOKernel(int kernelSize);
+
+// Sobol序列生成矩阵：按Joe-Kuo本原多项式生成前dimensions维的方向数，每维SOBOL_BITS个
+constexpr int SOBOL_BITS = 32;
+std::vector<uint32_t> GenerateSobolMatrices(int dimensions);
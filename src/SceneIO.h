@@ -1,8 +1,11 @@
 #pragma once
-#include "SSBO.h"
-#include "LightSSBO.h"
+#include "Object.h"
+#include "Light.h"
+#include <cstdio>
 #include <fstream>
 #include <sstream>
+#include <string>
+#include <vector>
 #include <glm/glm.hpp>
 
 static std::string ObjectTypeToString(ObjectType type) {
@@ -32,7 +35,7 @@ static std::string MaterialTypeToString(MaterialType type) {
 static ObjectType StringToObjectType(const std::string& str) {
     if (str == "SPHERE") return ObjectType::SPHERE;
     if (str == "PLANE") return ObjectType::PLANE;
-    return ObjectType::SPHERE; // Ĭֵ
+    return ObjectType::SPHERE; // 默认值
 }
 
 static LightType StringToLightType(const std::string& str) {
@@ -72,21 +75,21 @@ static void WriteLightParams(std::ofstream& file, const Light& light, const std:
 		<< " " << light.samples;
 }
 
-void GenerateAABBForObject(Object& obj) {
+inline void GenerateAABBForObject(Object& obj) {
     if (obj.type == ObjectType::SPHERE) {
-        // AABBġ뾶
+        // 球体AABB：中心±半径
         obj.bounds.min = obj.position - glm::vec3(obj.radius);
         obj.bounds.max = obj.position + glm::vec3(obj.radius);
     }
     else if (obj.type == ObjectType::PLANE) {
-        // ƽAABBݷ߷
+        // 平面AABB：根据法线方向生成
         glm::vec3 right, forward;
 
-        if (abs(obj.normal.y) > 0.9) { // Yᷨߣ/컨壩
+        if (abs(obj.normal.y) > 0.9) { // Y轴法线（地面/天花板）
             right = glm::vec3(1, 0, 0);
             forward = glm::vec3(0, 0, 1);
         }
-        else { // X/Zᷨߣǽ棩
+        else { // X/Z轴法线（墙面）
             right = glm::normalize(glm::cross(obj.normal, glm::vec3(0, 1, 0)));
             forward = glm::normalize(glm::cross(right, obj.normal));
         }
@@ -97,7 +100,7 @@ void GenerateAABBForObject(Object& obj) {
         obj.bounds.min = obj.position - halfSizeX - halfSizeY;
         obj.bounds.max = obj.position + halfSizeX + halfSizeY;
 
-        // ط߷չ1cmƽΪ0
+        // 沿法线方向扩展1cm避免平面厚度为0
         obj.bounds.min += obj.normal * 0.01f;
         obj.bounds.max += obj.normal * 0.01f;
     }
@@ -125,14 +128,14 @@ public:
         std::ofstream file(path);
         if (!file.is_open()) return false;
 
-        // д
+        // 写入物体数据
         for (const auto& uiObj : uiObjects) {
             file << "OBJECT " << ObjectTypeToString(uiObj.obj.type);
             WriteObjectParams(file, uiObj.obj, uiObj.name);
             file << "\n";
         }
 
-        // дԴ
+        // 写入光源数据
         for (const auto& uiLight : uiLights) {
             file << "LIGHT " << LightTypeToString(uiLight.light.type);
             WriteLightParams(file, uiLight.light, uiLight.name);
@@ -164,7 +167,7 @@ private:
 			>> uiObj.obj.material.specular;
         snprintf(uiObj.name, sizeof(uiObj.name), "%s", name.c_str());
 
-        GenerateAABBForObject(uiObj.obj); // 
+        GenerateAABBForObject(uiObj.obj); // 新增
 
         uiObjects.push_back(uiObj);
     }
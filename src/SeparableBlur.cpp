@@ -0,0 +1,105 @@
+// SeparableBlur.cpp
+#include "SeparableBlur.h"
+#include <vector>
+#include <random>
+#include "global.h"
+#include "GPUMemoryTracker.h"
+
+void SeparableBlur::Init() {
+    m_Shader.Init("shader/separable_blurCs.glsl");
+}
+
+void SeparableBlur::Blur(GLuint srcTex, GLuint dstTex, GLenum dstFormat, int width, int height) const {
+    m_Shader.use();
+    m_Shader.setInt("inputImage", 0);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, srcTex);
+    glBindImageTexture(7, dstTex, 0, GL_FALSE, 0, GL_WRITE_ONLY, dstFormat);
+
+    glDispatchCompute((width + TILE_SIZE - 1) / TILE_SIZE, (height + TILE_SIZE - 1) / TILE_SIZE, 1);
+    glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT | GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+}
+
+SeparableBlur::BenchmarkResult SeparableBlur::RunBenchmark(int width, int height, int iterations) const {
+    BenchmarkResult result;
+    result.width = width;
+    result.height = height;
+    result.iterations = iterations;
+
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+
+    // 随机噪声输入
+    std::vector<float> noise(static_cast<size_t>(width) * height * 4);
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> dist(0.0f, 4.0f);
+    for (float& v : noise) v = dist(rng);
+
+    GLuint textures[2], fbos[2];
+    glGenTextures(2, textures);
+    glGenFramebuffers(2, fbos);
+    for (int i = 0; i < 2; ++i) {
+        glBindTexture(GL_TEXTURE_2D, textures[i]);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, width, height, 0, GL_RGBA, GL_FLOAT, noise.data());
+        gpuMemory.TrackTexture(textures[i], "SeparableBlur", "Benchmark " + std::to_string(i), GL_RGBA16F, width, height);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glBindFramebuffer(GL_FRAMEBUFFER, fbos[i]);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, textures[i], 0);
+    }
+
+    Shader fragmentShader("shader/outputVs.glsl", "shader/gaussian_blurFs.glsl");
+    GLuint query;
+    glGenQueries(1, &query);
+    GLuint64 elapsed = 0;
+
+    // 片元着色器：水平、垂直各一趟，中间结果经过显存
+    glViewport(0, 0, width, height);
+    fragmentShader.use();
+    fragmentShader.setInt("image", 0);
+    glActiveTexture(GL_TEXTURE0);
+    glBeginQuery(GL_TIME_ELAPSED, query);
+    for (int i = 0; i < iterations; ++i) {
+        glBindFramebuffer(GL_FRAMEBUFFER, fbos[1]);
+        fragmentShader.setBool("horizontal", true);
+        glBindTexture(GL_TEXTURE_2D, textures[0]);
+        RenderQuad();
+        glBindFramebuffer(GL_FRAMEBUFFER, fbos[0]);
+        fragmentShader.setBool("horizontal", false);
+        glBindTexture(GL_TEXTURE_2D, textures[1]);
+        RenderQuad();
+    }
+    glEndQuery(GL_TIME_ELAPSED);
+    glGetQueryObjectui64v(query, GL_QUERY_RESULT, &elapsed);
+    result.fragmentMs = elapsed / 1e6 / iterations;
+
+    // compute：一次dispatch完成两个方向
+    glBeginQuery(GL_TIME_ELAPSED, query);
+    for (int i = 0; i < iterations; ++i) {
+        Blur(textures[i % 2], textures[(i + 1) % 2], GL_RGBA16F, width, height);
+    }
+    glEndQuery(GL_TIME_ELAPSED);
+    glGetQueryObjectui64v(query, GL_QUERY_RESULT, &elapsed);
+    result.computeMs = elapsed / 1e6 / iterations;
+
+    // 显存流量估算（RGBA16F = 8字节/像素，相邻tile重叠的apron由L2缓存命中）：
+    // 片元 = 2趟 * (读 + 写)，中间结果往返显存；compute = 读一次 + 写一次
+    const double pixels = static_cast<double>(width) * height;
+    const double bytesPerPixel = 8.0;
+    const double apronFactor = double(TILE_SIZE + 2 * RADIUS) * (TILE_SIZE + 2 * RADIUS) / (TILE_SIZE * TILE_SIZE);
+    result.fragmentMB = pixels * bytesPerPixel * 4.0 / (1024.0 * 1024.0);
+    result.computeMB = pixels * bytesPerPixel * 2.0 / (1024.0 * 1024.0);
+    result.fragmentFetches = 2.0 * 5.0;     // 线性采样折叠后每方向5次
+    result.computeFetches = apronFactor;
+    result.valid = true;
+
+    glDeleteQueries(1, &query);
+    glDeleteProgram(fragmentShader.ID);
+    glDeleteFramebuffers(2, fbos);
+    gpuMemory.DeleteTextures(2, textures);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+    return result;
+}
@@ -0,0 +1,29 @@
+// SeparableBlur.h
+#pragma once
+#include "Shader.h"
+
+// 共享内存compute可分离高斯模糊（separable_blurCs.glsl），供Bloom和AO使用
+// 输出写入图像单元7，输入按纹理读取，因此任意sized格式均可
+class SeparableBlur {
+public:
+    static constexpr int TILE_SIZE = 16;    // 需与separable_blurCs.glsl一致
+    static constexpr int RADIUS = 4;
+
+    struct BenchmarkResult {
+        int width = 0, height = 0, iterations = 0;
+        double fragmentMs = 0.0, computeMs = 0.0;       // 每次完整（水平+垂直）模糊的耗时
+        double fragmentMB = 0.0, computeMB = 0.0;       // 估算的显存流量
+        double fragmentFetches = 0.0, computeFetches = 0.0; // 每像素纹理读取次数
+        bool valid = false;
+    };
+
+    SeparableBlur() = default;
+    void Init();
+    // srcTex作为纹理读取，结果写入dstTex（dstFormat为其sized内部格式）
+    void Blur(GLuint srcTex, GLuint dstTex, GLenum dstFormat, int width, int height) const;
+    // 对比两趟片元着色器模糊与compute模糊（RGBA16F，同步等待查询结果，仅用于测试）
+    BenchmarkResult RunBenchmark(int width, int height, int iterations = 20) const;
+
+private:
+    Shader m_Shader;
+};
@@ -9,31 +9,31 @@
 
 class Shader {
 public:
-    // ID
+    // 程序ID
     GLuint ID;
 
 	Shader() {}
     void Init(const char* vertexPath, const char* fragmentPath) {
-        // 1. ļ·лȡ/Ƭɫ
+        // 1. 从文件路径中获取顶点/片段着色器
         std::string vertexCode;
         std::string fragmentCode;
         std::ifstream vShaderFile;
         std::ifstream fShaderFile;
-        // ֤ifstream׳쳣
+        // 保证ifstream对象可以抛出异常
         vShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
         fShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
         try {
-            // ļ
+            // 打开文件
             vShaderFile.open(vertexPath);
             fShaderFile.open(fragmentPath);
             std::stringstream vShaderStream, fShaderStream;
-            // ȡļĻݵ
+            // 读取文件的缓冲内容到数据流中
             vShaderStream << vShaderFile.rdbuf();
             fShaderStream << fShaderFile.rdbuf();
-            // رļ
+            // 关闭文件处理器
             vShaderFile.close();
             fShaderFile.close();
-            // תstring
+            // 转换数据流到string
             vertexCode = vShaderStream.str();
             fragmentCode = fShaderStream.str();
         }
@@ -43,25 +43,25 @@ public:
         const char* vShaderCode = vertexCode.c_str();
         const char* fShaderCode = fragmentCode.c_str();
 
-        // 2. ɫ
+        // 2. 编译着色器
         GLuint vertex, fragment;
-        // ɫ
+        // 顶点着色器
         vertex = glCreateShader(GL_VERTEX_SHADER);
         glShaderSource(vertex, 1, &vShaderCode, NULL);
         glCompileShader(vertex);
         checkCompileErrors(vertex, "VERTEX");
-        // Ƭɫ
+        // 片段着色器
         fragment = glCreateShader(GL_FRAGMENT_SHADER);
         glShaderSource(fragment, 1, &fShaderCode, NULL);
         glCompileShader(fragment);
         checkCompileErrors(fragment, "FRAGMENT");
-        // ɫ
+        // 着色器程序
         ID = glCreateProgram();
         glAttachShader(ID, vertex);
         glAttachShader(ID, fragment);
         glLinkProgram(ID);
         checkCompileErrors(ID, "PROGRAM");
-        // ɾɫѾӵǵĳˣѾҪ
+        // 删除着色器，它们已经链接到我们的程序中了，已经不再需要了
         glDeleteShader(vertex);
         glDeleteShader(fragment);
     }
@@ -97,17 +97,17 @@ public:
         glDeleteShader(compute);
     }
 
-    // 캯ȡɫ
+    // 构造函数读取并构建着色器
     Shader(const char* vertexPath, const char* fragmentPath) { Init(vertexPath, fragmentPath); }
 
     Shader(const char* computePath) { Init(computePath); }
 
-    // ʹ/
+    // 使用/激活程序
     void use() const {
         glUseProgram(ID);
     }
 
-    // uniformߺ
+    // uniform工具函数
     void setBool(const std::string& name, bool value) const {
         glUniform1i(glGetUniformLocation(ID, name.c_str()), (int)value);
     }
@@ -117,6 +117,12 @@ public:
     void setFloat(const std::string& name, float value) const {
         glUniform1f(glGetUniformLocation(ID, name.c_str()), value);
     }
+    void setIVec2(const std::string& name, const glm::ivec2& value) const {
+        glUniform2i(glGetUniformLocation(ID, name.c_str()), value.x, value.y);
+    }
+    void setIVec3(const std::string& name, const glm::ivec3& value) const {
+        glUniform3i(glGetUniformLocation(ID, name.c_str()), value.x, value.y, value.z);
+    }
     void setVec2(const std::string& name, const glm::vec2& value) const {
         glUniform2fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]);
     }
@@ -128,7 +134,7 @@ public:
     }
 
 private:
-    // ɫ/Ӵ
+    // 检查着色器编译/链接错误
     void checkCompileErrors(GLuint shader, std::string type) {
         GLint success;
         GLchar infoLog[1024];
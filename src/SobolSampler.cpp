@@ -0,0 +1,21 @@
+// SobolSampler.cpp
+#include "SobolSampler.h"
+#include "GPUMemoryTracker.h"
+#include "Sampling.h"
+
+SobolSampler::~SobolSampler() {
+    gpuMemory.DeleteBuffers(1, &id);
+}
+
+void SobolSampler::Init() {
+    matrices = GenerateSobolMatrices(DIMENSIONS);
+
+    glGenBuffers(1, &id);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, id);
+    glBufferData(GL_SHADER_STORAGE_BUFFER,
+        matrices.size() * sizeof(uint32_t),
+        matrices.data(),
+        GL_STATIC_DRAW);
+    gpuMemory.TrackBuffer(id, "Sampler", "Sobol matrices", matrices.size() * sizeof(uint32_t));
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, id);  // 绑定到索引2，之后不再改变
+}
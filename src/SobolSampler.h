@@ -0,0 +1,19 @@
+// SobolSampler.h
+#pragma once
+#include <GL/glew.h>
+#include <vector>
+#include <cstdint>
+
+// Sobol序列生成矩阵（方向数），CPU端生成后一次性上传到SSBO（binding = 2）
+// 着色器中配合PCG哈希做逐像素的索引打乱和Owen扰乱
+class SobolSampler {
+public:
+    static constexpr int DIMENSIONS = 4;    // 需与raytracingCs.glsl中的SOBOL_DIMENSIONS一致
+
+    GLuint id = 0;
+    std::vector<uint32_t> matrices;         // DIMENSIONS * SOBOL_BITS 个方向数（GenerateSobolMatrices）
+
+    SobolSampler() = default;
+    ~SobolSampler();
+    void Init();
+};
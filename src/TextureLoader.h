@@ -1,4 +1,5 @@
 // TextureLoader.h
 #pragma 
 GLuint LoadSkybox(const std::vector<std::string>& faces);
-GLuint ConvertHDRToCubemap(const char* hdrPath, int cubemapSize = 512);
\ No newline at end of file
+class EnvironmentSampler;
+GLuint ConvertHDRToCubemap(const char* hdrPath, int cubemapSize = 512, EnvironmentSampler* envSampler = nullptr);
\ No newline at end of file
@@ -0,0 +1,119 @@
+// TraceRecorder.cpp
+#include "TraceRecorder.h"
+#include <imgui.h>
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+TraceRecorder::TraceRecorder() : m_Origin(std::chrono::steady_clock::now()) {
+}
+
+double TraceRecorder::NowUs() const {
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - m_Origin).count();
+}
+
+void TraceRecorder::Calibrate(long long frame) {
+    // GL_TIMESTAMP返回GPU当前时间，不需要等待之前的命令完成
+    GLint64 gpuNs = 0;
+    glGetInteger64v(GL_TIMESTAMP, &gpuNs);
+    m_Calibrations.push_back({ frame, NowUs() - static_cast<double>(gpuNs) / 1000.0 });
+}
+
+void TraceRecorder::BeginFrame(long long frame) {
+    if (!recording) return;
+
+    if (m_Calibrations.empty() || frame - m_Calibrations.back().frame >= CALIBRATE_INTERVAL) Calibrate(frame);
+
+    // 环形缓冲：两个队列各自按帧号有序，弹出超出范围的旧帧；定帧捕获期间不丢弃捕获范围内的帧
+    long long oldest = frame - std::max(ringFrames, 1);
+    if (m_CaptureEnd >= 0) oldest = std::min(oldest, m_FirstFrame);
+    while (!m_CPUEvents.empty() && m_CPUEvents.front().frame < oldest) m_CPUEvents.pop_front();
+    while (!m_GPUEvents.empty() && m_GPUEvents.front().frame < oldest) m_GPUEvents.pop_front();
+    // 保留覆盖最旧帧的那次校准
+    while (m_Calibrations.size() > 1 && m_Calibrations[1].frame <= oldest) m_Calibrations.pop_front();
+}
+
+void TraceRecorder::AddCPUEvent(const char* name, long long frame, double beginUs, double endUs) {
+    if (!recording || frame < m_FirstFrame) return;
+    m_CPUEvents.push_back({ name, Track::CPU, frame, beginUs, endUs });
+}
+
+void TraceRecorder::AddGPUEvent(const char* name, long long frame, GLuint64 beginNs, GLuint64 endNs) {
+    if (!recording || frame < m_FirstFrame) return;
+
+    // 使用该帧开始时有效的校准；早于第一次校准的帧（开始记录前发出的查询）不记录
+    auto it = std::find_if(m_Calibrations.rbegin(), m_Calibrations.rend(), [frame](const Calibration& c) { return c.frame <= frame; });
+    if (it == m_Calibrations.rend()) return;
+    const double beginUs = static_cast<double>(beginNs) / 1000.0 + it->gpuOffsetUs;
+    const double endUs = static_cast<double>(endNs) / 1000.0 + it->gpuOffsetUs;
+    m_GPUEvents.push_back({ name, Track::GPU, frame, beginUs, endUs });
+}
+
+void TraceRecorder::StartCapture(long long currentFrame) {
+    m_RecordingBeforeCapture = recording;
+    m_CPUEvents.clear();
+    m_GPUEvents.clear();
+    m_Calibrations.clear();
+    recording = true;
+    // 当前帧的CPU区间已经有一部分过去了，从下一帧开始才是完整的帧（下一帧BeginFrame时校准）
+    m_FirstFrame = currentFrame + 1;
+    m_CaptureEnd = m_FirstFrame + std::max(captureFrames, 1);
+}
+
+void TraceRecorder::OnFrameResolved(long long frame) {
+    if (m_CaptureEnd < 0 || frame < m_CaptureEnd - 1) return;
+
+    m_LastFile = "trace_" + std::to_string(m_CaptureEnd) + ".json";
+    // CPU事件比GPU回读早几帧，此时已经记录了捕获范围之后的帧
+    Write(m_LastFile, m_FirstFrame, m_CaptureEnd);
+    m_CaptureEnd = -1;
+    recording = m_RecordingBeforeCapture;
+}
+
+bool TraceRecorder::Write(const std::string& path, long long firstFrame, long long endFrame) const {
+    std::ofstream file(path);
+    if (!file) {
+        std::cerr << "TraceRecorder: failed to open " << path << std::endl;
+        return false;
+    }
+
+    // Trace Event格式：完整事件（ph = X），时间单位为微秒；CPU和GPU各占一条线程轨道
+    file << std::fixed << std::setprecision(3);
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"CPU\"}},\n";
+    file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":2,\"args\":{\"name\":\"GPU\"}}";
+    for (const std::deque<Event>* events : { &m_CPUEvents, &m_GPUEvents }) {
+        for (const Event& e : *events) {
+            if (e.frame < firstFrame || e.frame >= endFrame) continue;
+            const bool gpu = e.track == Track::GPU;
+            file << ",\n{\"name\":\"" << e.name << "\",\"cat\":\"" << (gpu ? "gpu" : "cpu")
+                << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << (gpu ? 2 : 1)
+                << ",\"ts\":" << e.beginUs << ",\"dur\":" << std::max(e.endUs - e.beginUs, 0.0)
+                << ",\"args\":{\"frame\":" << e.frame << "}}";
+        }
+    }
+    file << "\n]}\n";
+    return true;
+}
+
+void TraceRecorder::DrawUI(long long currentFrame) {
+    ImGui::Checkbox("Record Ring Buffer", &recording);
+    ImGui::SliderInt("Ring Frames", &ringFrames, 30, 1000);
+    if (ImGui::Button("Save Ring")) {
+        m_LastFile = "trace_" + std::to_string(currentFrame) + ".json";
+        Write(m_LastFile);
+    }
+
+    ImGui::Separator();
+    ImGui::SliderInt("Capture Frames", &captureFrames, 1, 1000);
+    if (m_CaptureEnd >= 0) {
+        ImGui::Text("Capturing... %lld frames left", std::max(m_CaptureEnd - currentFrame, 0LL));
+    }
+    else if (ImGui::Button("Capture")) {
+        StartCapture(currentFrame);
+    }
+
+    ImGui::Text("Events: %d", GetEventCount());
+    if (!m_LastFile.empty()) ImGui::Text("Last trace: %s", m_LastFile.c_str());
+}
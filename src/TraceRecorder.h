@@ -0,0 +1,70 @@
+// TraceRecorder.h
+#pragma once
+#include <GL/glew.h>
+#include <chrono>
+#include <climits>
+#include <deque>
+#include <string>
+
+// 时间线捕获：在环形缓冲中保存最近若干帧的CPU区间和GPU时间戳区间，导出为Chrome Trace Event JSON，
+// 可在Perfetto（ui.perfetto.dev）或chrome://tracing中查看CPU/GPU重叠和空泡。
+// GPU时间戳通过GL_TIMESTAMP定期校准到CPU时钟
+class TraceRecorder {
+public:
+    enum class Track {
+        CPU,
+        GPU
+    };
+
+    struct Event {
+        std::string name;
+        Track track;
+        long long frame;
+        double beginUs, endUs;      // CPU时钟，相对m_Origin
+    };
+
+    static constexpr int CALIBRATE_INTERVAL = 120;  // 重新校准GPU时钟的帧间隔
+
+    TraceRecorder();
+
+    // 相对起点的CPU时间（微秒）
+    double NowUs() const;
+
+    void BeginFrame(long long frame);
+    void AddCPUEvent(const char* name, long long frame, double beginUs, double endUs);
+    // beginNs/endNs为GL_TIMESTAMP查询结果
+    void AddGPUEvent(const char* name, long long frame, GLuint64 beginNs, GLuint64 endNs);
+    // 某帧的GPU结果已回读：定帧捕获在最后一帧回读后写出文件
+    void OnFrameResolved(long long frame);
+
+    // 从currentFrame的下一帧开始捕获captureFrames帧（当前帧已经过半），完成后自动写出
+    void StartCapture(long long currentFrame);
+    // 只写出[firstFrame, endFrame)范围内的事件，默认全部
+    bool Write(const std::string& path, long long firstFrame = LLONG_MIN, long long endFrame = LLONG_MAX) const;
+    void DrawUI(long long currentFrame);
+
+    // 参数
+    bool recording = false;     // 持续记录到环形缓冲，可随时导出
+    int ringFrames = 300;
+    int captureFrames = 120;
+
+private:
+    struct Calibration {
+        long long frame;                // 从这一帧开始使用
+        double gpuOffsetUs;             // CPU时间 - GPU时间
+    };
+
+    void Calibrate(long long frame);
+    int GetEventCount() const { return static_cast<int>(m_CPUEvents.size() + m_GPUEvents.size()); }
+
+    std::chrono::steady_clock::time_point m_Origin;
+    // 校准历史：GPU事件晚几帧才回读，按事件所属帧当时的偏移换算，重新校准不影响已发出的查询
+    std::deque<Calibration> m_Calibrations;
+
+    // CPU和GPU事件分别按帧号递增加入，环形缓冲只需从队首弹出
+    std::deque<Event> m_CPUEvents, m_GPUEvents;
+    long long m_FirstFrame = 0;         // 更早的帧（捕获开始前发出的查询）不记录
+    long long m_CaptureEnd = -1;        // 定帧捕获的结束帧（不含），-1表示未在捕获
+    bool m_RecordingBeforeCapture = false;
+    std::string m_LastFile;
+};
@@ -1,4 +1,5 @@
 #include "global.h"
+#include "GPUMemoryTracker.h"
 #include <glm/common.hpp>
 
 const int WIDTH = 800;
@@ -14,7 +15,7 @@ void RenderQuad() {
     static GLuint quadVAO = 0, quadVBO;
     if (quadVAO == 0) {
         float quadVertices[] = {
-            // λ       // 
+            // 位置       // 纹理坐标
             -1.0f,  1.0f, 0.0f, 1.0f,
             -1.0f, -1.0f, 0.0f, 0.0f,
              1.0f, -1.0f, 1.0f, 0.0f,
@@ -28,6 +29,7 @@ void RenderQuad() {
         glBindVertexArray(quadVAO);
         glBindBuffer(GL_ARRAY_BUFFER, quadVBO);
         glBufferData(GL_ARRAY_BUFFER, sizeof(quadVertices), &quadVertices, GL_STATIC_DRAW);
+        gpuMemory.TrackBuffer(quadVBO, "Pipeline", "Quad VBO", sizeof(quadVertices), true);
         glEnableVertexAttribArray(0);
         glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
         glEnableVertexAttribArray(1);
@@ -38,18 +40,6 @@ void RenderQuad() {
     glBindVertexArray(0);
 }
 
-float haltonSequence(int index, int base) {
-    float result = 0.0f;
-    float f = 1.0f / base;
-    int i = index;
-    while (i > 0) {
-        result += f * (i % base);
-        i = (int)floor(i / base);
-        f /= base;
-    }
-    return result;
-}
-
 void mouse_callback(GLFWwindow* window, double xpos, double ypos) {
     if (glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_RIGHT) == GLFW_PRESS) {
         if (firstMouse) {
@@ -66,7 +56,7 @@ void mouse_callback(GLFWwindow* window, double xpos, double ypos) {
         camera.Yaw += xoffset;
         camera.Pitch += yoffset;
 
-        // Ƹ
+        // 限制俯仰角
         if (camera.Pitch > 89.0f) camera.Pitch = 89.0f;
         if (camera.Pitch < -89.0f) camera.Pitch = -89.0f;
 
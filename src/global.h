@@ -2,6 +2,7 @@
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
 #include "Camera.h"
+#include "Sampling.h"
 
 extern const int WIDTH;
 extern const int HEIGHT;
@@ -15,8 +16,5 @@ extern float lastFrame;
 
 void RenderQuad();
 
-// TAA HaltonɺͲУ
-float haltonSequence(int index, int base);
-
 void mouse_callback(GLFWwindow* window, double xpos, double ypos);
 void scroll_callback(GLFWwindow* window, double xoffset, double yoffset);
\ No newline at end of file
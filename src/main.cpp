@@ -1,8 +1,14 @@
 #include "ForwardShadingPipeline.h"
 
-int main() {
+int main(int argc, char** argv) {
+    BenchmarkOptions options;
+    if (!BenchmarkOptions::Parse(argc, argv, options)) return 2;
+    // 只比较已有报告，不创建窗口
+    if (!options.comparePath.empty()) {
+        return Benchmark::Compare(options.comparePath, options.baselinePath, options);
+    }
 
-    ForwardShadingPipline app;
+    ForwardShadingPipline app(options);
     app.Render();
-    return 0;
-}
\ No newline at end of file
+    return app.GetExitCode();
+}